@@ -64,6 +64,12 @@ void ZipOutputStream::putNextEntry(const std::string& entryName) {
 }
 
 
+void ZipOutputStream::putPrecompressedEntry( const ZipCDirEntry &entry,
+                                             const char *data, uint32 size ) {
+  ozf->putPrecompressedEntry( entry, data, size ) ;
+}
+
+
 void ZipOutputStream::setComment( const std::string &comment ) {
   ozf->setComment( comment ) ;
 }
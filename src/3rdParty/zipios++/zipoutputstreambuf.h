@@ -49,6 +49,13 @@ public:
       entry. */
   void putNextEntry( const ZipCDirEntry &entry ) ;
 
+  /** Writes an entry whose data has already been deflated (or is stored).
+      The method, size and crc of entry must be set by the caller, the
+      compressed size and time are filled in. data is copied verbatim
+      after the local header and the entry is closed afterwards. */
+  void putPrecompressedEntry( const ZipCDirEntry &entry, const char *data,
+                              uint32 size ) ;
+
   /** Sets the global comment for the Zip archive. */
   void setComment( const string &comment ) ;
 
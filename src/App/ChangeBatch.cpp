@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#endif
+
+#include <Base/Console.h>
+#include <Base/Exception.h>
+
+#include "ChangeBatch.h"
+#include "Document.h"
+#include "DocumentObject.h"
+
+
+FC_LOG_LEVEL_INIT("App", true, true)
+
+using namespace App;
+
+namespace
+{
+
+struct PendingChange
+{
+    const DocumentObject* obj;
+    const Property* prop;
+    /// Used to detect dynamic properties removed before the end of the batch
+    std::string name;
+};
+
+struct BatchState
+{
+    int depth {0};
+    std::vector<PendingChange> changes;
+    std::set<std::pair<const DocumentObject*, const Property*>> seen;
+};
+
+thread_local BatchState _Batch;
+
+}  // namespace
+
+ChangeBatch::ChangeBatch()
+{
+    ++_Batch.depth;
+}
+
+ChangeBatch::~ChangeBatch()
+{
+    if (--_Batch.depth > 0) {
+        return;
+    }
+
+    // Changes made by the listeners below are signaled immediately
+    auto changes = std::move(_Batch.changes);
+    _Batch.changes.clear();
+    _Batch.seen.clear();
+
+    for (const auto& change : changes) {
+        auto obj = change.obj;
+        if (!obj->isAttachedToDocument()
+            || obj->getPropertyByName(change.name.c_str()) != change.prop) {
+            continue;
+        }
+        try {
+            obj->getDocument()->onChangedProperty(obj, change.prop);
+            obj->signalChanged(*obj, *change.prop);
+        }
+        catch (Base::Exception& e) {
+            e.reportException();
+        }
+        catch (std::exception& e) {
+            FC_ERR("exception on signaling change of " << obj->getFullName() << '.'
+                                                       << change.name << ": " << e.what());
+        }
+        catch (...) {
+            FC_ERR("unknown exception on signaling change of " << obj->getFullName() << '.'
+                                                               << change.name);
+        }
+    }
+}
+
+bool ChangeBatch::isActive()
+{
+    return _Batch.depth > 0;
+}
+
+bool ChangeBatch::add(const DocumentObject* obj, const Property* prop)
+{
+    if (_Batch.depth <= 0) {
+        return false;
+    }
+    const char* name = prop->getName();
+    if (!name) {
+        return false;
+    }
+    if (_Batch.seen.emplace(obj, prop).second) {
+        _Batch.changes.push_back(PendingChange {obj, prop, name});
+    }
+    return true;
+}
+
+void ChangeBatch::remove(const DocumentObject* obj)
+{
+    if (_Batch.changes.empty()) {
+        return;
+    }
+    auto& changes = _Batch.changes;
+    changes.erase(std::remove_if(changes.begin(),
+                                 changes.end(),
+                                 [&](const PendingChange& change) {
+                                     if (change.obj != obj) {
+                                         return false;
+                                     }
+                                     _Batch.seen.erase({change.obj, change.prop});
+                                     return true;
+                                 }),
+                  changes.end());
+}
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef APP_CHANGEBATCH_H
+#define APP_CHANGEBATCH_H
+
+#include <cstddef>
+#include <FCGlobal.h>
+
+namespace App
+{
+
+class DocumentObject;
+class Property;
+
+/** Helper class to coalesce property change notifications
+ *
+ * While an instance exists, the change notifications of document object
+ * properties modified by the current thread, i.e. Document::signalChangedObject
+ * and DocumentObject::signalChanged, are collected instead of being emitted.
+ * Repeated changes of the same property are merged. When the outermost
+ * instance is destroyed, each changed property is signaled once, in the order
+ * of its first change.
+ *
+ * DocumentObject::onChanged() and Property::signalChanged are not affected.
+ * Listeners that must see every change as it happens can connect to
+ * Document::signalChangedObjectImmediate instead.
+ */
+class AppExport ChangeBatch
+{
+public:
+    /// Private new operator to prevent heap allocation
+    void* operator new(std::size_t) = delete;
+
+public:
+    /// Constructor, starts collecting the change notifications of this thread
+    ChangeBatch();
+
+    /// Destructor, signals the collected changes if this is the outermost instance
+    ~ChangeBatch();
+
+    ChangeBatch(const ChangeBatch&) = delete;
+    ChangeBatch& operator=(const ChangeBatch&) = delete;
+
+    /// Check if change notifications are collected on the calling thread
+    static bool isActive();
+
+    /** Collect the change notification of a property
+     *
+     * @return true if the notification is deferred until the end of the
+     * batch, false if it must be signaled immediately
+     */
+    static bool add(const DocumentObject* obj, const Property* prop);
+
+    /// Drop the collected notifications of an object that is being destroyed
+    static void remove(const DocumentObject* obj);
+};
+
+}  // namespace App
+
+#endif  // APP_CHANGEBATCH_H
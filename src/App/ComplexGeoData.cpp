@@ -637,8 +637,14 @@ void ComplexGeoData::SaveDocFile(Base::Writer& writer) const
 {
     flushElementMap();
     if (_elementMap) {
-        writer.Stream() << "BeginElementMap v1\n";
-        _elementMap->save(writer.Stream());
+        if (writer.getMode("BinaryElementMap")) {
+            writer.Stream() << "BeginElementMap v2\n";
+            _elementMap->saveBinary(writer.Stream());
+        }
+        else {
+            writer.Stream() << "BeginElementMap v1\n";
+            _elementMap->save(writer.Stream());
+        }
     }
 }
 
@@ -650,14 +656,19 @@ void ComplexGeoData::RestoreDocFile(Base::Reader& reader)
     if (boost::equals(marker, "BeginElementMap")) {
         resetElementMap();
         reader >> ver;
-        if (ver != "v1") {
-            FC_WARN("Unknown element map format");  // NOLINT
-        }
-        else {
+        if (ver == "v1") {
             resetElementMap(std::make_shared<ElementMap>());
             _elementMap = _elementMap->restore(Hasher, reader);
             return;
         }
+        if (ver == "v2") {
+            // skip the line end written after the marker
+            reader.get();
+            resetElementMap(std::make_shared<ElementMap>());
+            _elementMap = _elementMap->restoreBinary(Hasher, reader);
+            return;
+        }
+        FC_WARN("Unknown element map format");  // NOLINT
     }
     auto count = atoll(marker.c_str());  // Try to prevent UB if the number is unreasonably large
     if (count < 0 || count > std::numeric_limits<int>::max()) {
@@ -667,11 +678,16 @@ void ComplexGeoData::RestoreDocFile(Base::Reader& reader)
 }
 
 unsigned int ComplexGeoData::getMemSize() const
+{
+    std::set<const ElementMap*> visited;
+    return static_cast<unsigned int>(getElementMapMemSize(visited));
+}
+
+size_t ComplexGeoData::getElementMapMemSize(std::set<const ElementMap*>& visited) const
 {
     flushElementMap();
     if (_elementMap) {
-        static const int multiplier {10};
-        return _elementMap->size() * multiplier;
+        return _elementMap->getMemSize(visited);
     }
     return 0;
 }
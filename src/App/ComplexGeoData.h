@@ -346,6 +346,13 @@ public:
     /// Get the current element map size
     size_t getElementMapSize(bool flush = true) const;
 
+    /** Estimated memory used by the element map in bytes
+     *
+     * @param visited: element maps that are already counted, e.g. child maps
+     * shared with other geometry. The maps of this geometry are added.
+     */
+    size_t getElementMapMemSize(std::set<const ElementMap*>& visited) const;
+
     /// Return the higher level element names of the given element
     virtual std::vector<IndexedName> getHigherElements(const char* name, bool silent = false) const;
 
@@ -36,7 +36,13 @@
 #include <vector>
 #include <list>
 #include <algorithm>
+#include <limits>
 #include <filesystem>
+#include <condition_variable>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
 #endif
 
 #include <boost/algorithm/string.hpp>
@@ -61,6 +67,7 @@
 #include <Base/Writer.h>
 #include <Base/Profiler.h>
 #include <Base/Tools.h>
+#include <Base/TraceRecorder.h>
 #include <Base/Uuid.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
@@ -70,11 +77,14 @@
 #include "private/DocumentP.h"
 #include "Application.h"
 #include "AutoTransaction.h"
+#include "ChangeBatch.h"
+#include "ComplexGeoData.h"
 #include "ExpressionParser.h"
 #include "GeoFeature.h"
 #include "License.h"
 #include "Link.h"
 #include "MergeDocuments.h"
+#include "PropertyGeo.h"
 #include "StringHasher.h"
 #include "Transactions.h"
 
@@ -110,6 +120,10 @@ static bool globalIsRestoring;
 static bool globalIsRelabeling;
 
 DocumentP::DocumentP()
+    : hDocGrp(GetApplication().GetParameterGroupByPath(
+          "User parameter:BaseApp/Preferences/Document"))
+    , canAbortRecompute(hDocGrp, "CanAbortRecompute", true)
+    , parallelRecompute(hDocGrp, "ParallelRecompute", false)
 {
     static std::random_device rd;
     static std::mt19937 rgen(rd());
@@ -480,11 +494,7 @@ void Document::_commitTransaction(const bool notify)
         mUndoTransactions.push_back(d->activeUndoTransaction);
         d->activeUndoTransaction = nullptr;
         // check the stack for the limits
-        if (mUndoTransactions.size() > d->UndoMaxStackSize) {
-            mUndoMap.erase(mUndoTransactions.front()->getID());
-            delete mUndoTransactions.front();
-            mUndoTransactions.pop_front();
-        }
+        _trimUndoTransactions();
         signalCommitTransaction(*this);
 
         // closeActiveTransaction() may call again _commitTransaction()
@@ -686,12 +696,56 @@ int Document::getUndoMode() const
 
 unsigned int Document::getUndoMemSize() const
 {
-    return d->UndoMemSize;
+    return static_cast<unsigned int>(
+        std::min<std::size_t>(getUndoBytes(), std::numeric_limits<unsigned int>::max()));
 }
 
 void Document::setUndoLimit(const unsigned int UndoMemSize) // NOLINT
 {
-    d->UndoMemSize = UndoMemSize;
+    setUndoBudget(UndoMemSize);
+}
+
+void Document::setUndoBudget(std::size_t bytes)
+{
+    d->UndoMemSize = bytes;
+    _trimUndoTransactions();
+}
+
+std::size_t Document::getUndoBudget() const
+{
+    return d->UndoMemSize;
+}
+
+std::size_t Document::getUndoBytes() const
+{
+    std::size_t size = 0;
+    for (auto transaction : mUndoTransactions) {
+        size += transaction->getMemSize();
+    }
+    for (auto transaction : mRedoTransactions) {
+        size += transaction->getMemSize();
+    }
+    return size;
+}
+
+void Document::_trimUndoTransactions()
+{
+    auto removeOldest = [this]() {
+        mUndoMap.erase(mUndoTransactions.front()->getID());
+        delete mUndoTransactions.front();
+        mUndoTransactions.pop_front();
+    };
+    while (mUndoTransactions.size() > d->UndoMaxStackSize) {
+        removeOldest();
+    }
+    if (d->UndoMemSize == 0) {
+        return;
+    }
+    std::size_t size = getUndoBytes();
+    while (size > d->UndoMemSize && mUndoTransactions.size() > 1) {
+        size -= mUndoTransactions.front()->getMemSize();
+        removeOldest();
+    }
 }
 
 void Document::setMaxUndoStackSize(const unsigned int UndoMaxStackSize) // NOLINT
@@ -776,10 +830,25 @@ void Document::onChanged(const Property* prop)
 
 void Document::onBeforeChangeProperty(const TransactionalObject* Who, const Property* What)
 {
+    if (isRecomputeWorker()) {
+        // Only record into the transaction opened by the scheduling thread,
+        // the before change signal is not emitted for concurrently executed
+        // objects.
+        std::lock_guard<std::recursive_mutex> lock(d->recomputeMutex);
+        if (!d->rollback && d->activeUndoTransaction) {
+            d->activeUndoTransaction->addObjectChange(Who, What);
+        }
+        return;
+    }
     if (Who->isDerivedFrom<DocumentObject>()) {
         signalBeforeChangeObject(*static_cast<const DocumentObject*>(Who), *What);
     }
     if (!d->rollback && !globalIsRelabeling) {
+        // recompute workers may record into the same transaction
+        std::unique_lock<std::recursive_mutex> lock(d->recomputeMutex, std::defer_lock);
+        if (d->concurrentRecompute) {
+            lock.lock();
+        }
         _checkTransaction(nullptr, What, __LINE__);
         if (d->activeUndoTransaction) {
             d->activeUndoTransaction->addObjectChange(Who, What);
@@ -1645,6 +1714,54 @@ unsigned int Document::getMemSize() const
     return size;
 }
 
+MemoryReport Document::getMemoryReport() const
+{
+    MemoryReport report;
+    report.document = getName();
+    std::set<const Data::ElementMap*> visitedMaps;
+
+    auto addProperty = [&](const Property* prop) -> std::size_t {
+        auto& usage = report.propertyTypes[prop->getTypeId().getName()];
+        ++usage.count;
+        auto geoProp = freecad_cast<const PropertyComplexGeoData*>(prop);
+        if (geoProp && geoProp->isDeferred()) {
+            // do not load the geometry just to report its size
+            ++report.deferredProperties;
+            return 0;
+        }
+        std::size_t bytes = prop->getMemSize();
+        usage.bytes += bytes;
+        return bytes;
+    };
+
+    report.objects.reserve(d->objectArray.size());
+    for (auto obj : d->objectArray) {
+        MemoryReport::ObjectUsage usage;
+        usage.name = obj->getNameInDocument();
+        usage.label = obj->Label.getValue();
+        usage.type = obj->getTypeId().getName();
+        obj->visitProperties([&](Property* prop) {
+            usage.properties += addProperty(prop);
+            auto geoProp = freecad_cast<PropertyComplexGeoData*>(prop);
+            if (geoProp && !geoProp->isDeferred()) {
+                if (auto data = geoProp->getComplexData()) {
+                    usage.elementMaps += data->getElementMapMemSize(visitedMaps);
+                }
+            }
+        });
+        report.objects.push_back(std::move(usage));
+    }
+
+    visitProperties([&](Property* prop) {
+        report.documentProperties += addProperty(prop);
+    });
+    report.stringHashers = d->Hasher->getMemSize();
+    report.undo = getUndoMemSize();
+
+    signalMemoryReport(*this, report);
+    return report;
+}
+
 static std::string checkFileName(const char* file)
 {
     std::string fn(file);
@@ -2040,6 +2157,9 @@ private:
 
 bool Document::saveToFile(const char* filename) const
 {
+    // the deferred geometry refers to the file that is about to be replaced
+    loadDeferredProperties();
+
     signalStartSave(*this, filename);
 
     auto hGrp = GetApplication().GetParameterGroupByPath(
@@ -2106,11 +2226,22 @@ bool Document::saveToFile(const char* filename) const
 
         writer.setComment("FreeCAD Document");
         writer.setLevel(compression);
+        // number of threads deflating the embedded files, 0 = one per core
+        writer.setThreadCount(static_cast<unsigned>(hGrp->GetUnsigned("SaveThreads", 1)));
+        // The binary document is restored without the XML parser, see Base::encodeBinaryXML().
+        // Document.xml stays plain XML for older versions and other tools reading it.
+        bool binary = hGrp->GetBool("SaveBinaryDocument", false);
         writer.putNextEntry("Document.xml");
+        if (binary) {
+            writer.beginBinaryXML("Document.fcbin");
+        }
 
         if (hGrp->GetBool("SaveBinaryBrep", false)) {
             writer.setMode("BinaryBrep");
         }
+        if (hGrp->GetBool("SaveBinaryElementMap", false)) {
+            writer.setMode("BinaryElementMap");
+        }
 
         writer.Stream() << "<?xml version='1.0' encoding='utf-8'?>" << '\n'
                         << "<!--" << '\n'
@@ -2118,6 +2249,7 @@ bool Document::saveToFile(const char* filename) const
                         << '\n'
                         << "-->" << '\n';
         Document::Save(writer);
+        writer.endBinaryXML();
 
         // Special handling for Gui document.
         signalSaveDocument(writer);
@@ -2206,6 +2338,20 @@ bool Document::isAnyRestoring()
     return globalIsRestoring;
 }
 
+// saveToFile() writes the binary copy of the document right after Document.xml
+static bool hasBinaryDocument(const Base::FileInfo& fi)
+{
+    try {
+        zipios::ZipFile zip(fi.filePath());
+        zipios::ConstEntries entries = zip.entries();
+        return entries.size() > 1 && entries[0]->getName() == "Document.xml"
+            && entries[1]->getName() == "Document.fcbin";
+    }
+    catch (const std::exception&) {
+        return false;
+    }
+}
+
 // Open the document
 void Document::restore(const char* filename,
                        bool delaySignal,
@@ -2254,12 +2400,23 @@ void Document::restore(const char* filename,
     }
 
     zipios::ZipInputStream zipstream(file);
+    if (hasBinaryDocument(fi)) {
+        // skip Document.xml and read its binary copy
+        zipstream.getNextEntry();
+    }
     Base::XMLReader reader(filename, zipstream);
 
     if (!reader.isValid()) {
         throw Base::FileException("Error reading compression file", filename);
     }
 
+    // number of threads decoding the embedded files, 0 = one per core
+    auto hGrp = GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    reader.setFileThreadCount(static_cast<unsigned>(hGrp->GetUnsigned("RestoreThreads", 1)));
+    // read geometry only on first access, see loadDeferredProperties()
+    reader.setDeferFiles(hGrp->GetBool("LazyLoadGeometry", false));
+
     GetApplication().signalStartRestoreDocument(*this);
     setStatus(Document::Restoring, true);
 
@@ -2299,6 +2456,23 @@ void Document::restore(const char* filename,
     }
 }
 
+int Document::loadDeferredProperties() const
+{
+    int count = 0;
+    for (auto obj : d->objectArray) {
+        std::vector<Property*> props;
+        obj->getPropertyList(props);
+        for (auto prop : props) {
+            auto geo = freecad_cast<PropertyComplexGeoData*>(prop);
+            if (geo && geo->isDeferred()) {
+                geo->loadDeferred();
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
 bool Document::afterRestore(const bool checkPartial)
 {
     Base::FlagToggler<> flag(globalIsRestoring, false);
@@ -2697,6 +2871,16 @@ Document::getDependencyList(const std::vector<DocumentObject*>& objs, int option
         return ret;
     }
 
+    // Use the dependency graph maintained by the document if possible
+    Document* doc = objs.empty() || !objs.front() ? nullptr : objs.front()->getDocument();
+    if (doc && doc->d->dependencyGraph.update()
+        && std::all_of(objs.begin(), objs.end(), [doc](const DocumentObject* obj) {
+               return obj && obj->isAttachedToDocument() && obj->getDocument() == doc
+                   && doc->d->dependencyGraph.rank(obj) >= 0;
+           })) {
+        return doc->d->dependencyGraph.closure(objs, false);
+    }
+
     DependencyList depList;
     std::map<DocumentObject*, Vertex> objectMap;
     std::map<Vertex, DocumentObject*> vertexMap;
@@ -2878,12 +3062,342 @@ void Document::renameObjectIdentifiers(
     }
 }
 
+namespace App
+{
+
+using DeferredChanges = std::vector<std::pair<DocumentObject*, const Property*>>;
+
+// Change notifications of the object currently executed by this recompute
+// worker thread, null on any other thread.
+static thread_local DeferredChanges* _DeferredChanges = nullptr;
+
+/** Pool of threads executing objects on behalf of Document::recompute()
+ *
+ * Finished objects are handed back to the scheduling thread, which delivers
+ * the deferred change notifications and releases the dependent objects.
+ */
+class RecomputeWorkers
+{
+public:
+    struct Result
+    {
+        DocumentObject* obj {nullptr};
+        int ret {0};
+        DeferredChanges changes;
+    };
+
+    RecomputeWorkers(std::size_t count, std::function<int(DocumentObject*)> func)
+        : func(std::move(func))
+    {
+        threads.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            threads.emplace_back([this]() {
+                run();
+            });
+        }
+    }
+
+    ~RecomputeWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+            tasks.clear();
+        }
+        taskCond.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    RecomputeWorkers(const RecomputeWorkers&) = delete;
+    RecomputeWorkers& operator=(const RecomputeWorkers&) = delete;
+
+    void push(DocumentObject* obj)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(obj);
+        }
+        taskCond.notify_one();
+    }
+
+    /// Drop the objects not yet started, returns their number
+    std::size_t cancel()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::size_t count = tasks.size();
+        tasks.clear();
+        return count;
+    }
+
+    /// Wait for the next finished object
+    Result pop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        doneCond.wait(lock, [this]() {
+            return !done.empty();
+        });
+        Result res = std::move(done.front());
+        done.pop_front();
+        return res;
+    }
+
+private:
+    void run()
+    {
+        for (;;) {
+            Result res;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                taskCond.wait(lock, [this]() {
+                    return stopped || !tasks.empty();
+                });
+                if (stopped) {
+                    return;
+                }
+                res.obj = tasks.front();
+                tasks.pop_front();
+            }
+            _DeferredChanges = &res.changes;
+            res.ret = func(res.obj);
+            _DeferredChanges = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                done.push_back(std::move(res));
+            }
+            doneCond.notify_one();
+        }
+    }
+
+    std::function<int(DocumentObject*)> func;
+    std::mutex mutex;
+    std::condition_variable taskCond;
+    std::condition_variable doneCond;
+    std::deque<DocumentObject*> tasks;
+    std::deque<Result> done;
+    std::vector<std::thread> threads;
+    bool stopped {false};
+};
+
+}  // namespace App
+
+bool Document::isRecomputeWorker()
+{
+    return _DeferredChanges != nullptr;
+}
+
+bool Document::deferChangedProperty(DocumentObject* Who, const Property* What)
+{
+    if (!_DeferredChanges) {
+        return false;
+    }
+    _DeferredChanges->emplace_back(Who, What);
+    return true;
+}
+
+bool Document::_recomputeConcurrently(const std::vector<DocumentObject*>& objs,
+                                      const int options,
+                                      std::set<DocumentObject*>& filter,
+                                      std::set<DocumentObject*>& handled,
+                                      int& objectCount,
+                                      bool* hasError,
+                                      Base::SequencerLauncher* seq)
+{
+    const int op = ((options & DepNoXLinked) != 0) ? DocumentObject::OutListNoXLinked : 0;
+
+    // Count the unfinished inputs of each queued object
+    std::unordered_map<DocumentObject*, int> pending;
+    std::unordered_map<DocumentObject*, std::vector<DocumentObject*>> dependents;
+    pending.reserve(objs.size());
+    for (auto obj : objs) {
+        pending.emplace(obj, 0);
+    }
+    std::size_t concurrent = 0;
+    for (auto obj : objs) {
+        if (!obj->isAttachedToDocument()) {
+            continue;
+        }
+        auto outList = obj->getOutList(op);
+        std::sort(outList.begin(), outList.end());
+        outList.erase(std::unique(outList.begin(), outList.end()), outList.end());
+        for (auto dep : outList) {
+            if (pending.find(dep) != pending.end()) {
+                ++pending[obj];
+                dependents[dep].push_back(obj);
+            }
+        }
+        if (obj->isConcurrentExecutable()) {
+            ++concurrent;
+        }
+    }
+
+    std::unique_ptr<RecomputeWorkers> workers;
+    if (concurrent > 1) {
+        ParameterGrp::handle hGrp = GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Document");
+        auto count = static_cast<std::size_t>(std::max(0L, hGrp->GetInt("RecomputeThreads", 0)));
+        if (count == 0) {
+            count = std::thread::hardware_concurrency();
+        }
+        count = std::min(count, concurrent);
+        if (count > 1) {
+            FC_LOG("Recompute with " << count << " worker threads");
+            workers = std::make_unique<RecomputeWorkers>(count, [this](DocumentObject* obj) {
+                try {
+                    return _recomputeFeature(obj, [obj]() {
+                        return obj->recompute();
+                    });
+                }
+                catch (...) {
+                    d->addRecomputeLog("Unknown exception!", obj);
+                    return 1;
+                }
+            });
+        }
+    }
+    // declared after the workers, so it is reset before they are joined
+    Base::StateLocker concurrentLock(d->concurrentRecompute, workers != nullptr);
+
+    std::deque<DocumentObject*> ready;
+    for (auto obj : objs) {
+        if (pending[obj] == 0) {
+            ready.push_back(obj);
+        }
+    }
+
+    auto release = [&](DocumentObject* obj) {
+        handled.insert(obj);
+        for (auto dep : dependents[obj]) {
+            if (--pending[dep] == 0) {
+                ready.push_back(dep);
+            }
+        }
+    };
+
+    // Same post processing as the sequential recompute, returns false on user abort
+    auto finish = [&](DocumentObject* obj, int res, bool doRecompute) {
+        if (res != 0) {
+            if (hasError) {
+                *hasError = true;
+            }
+            if (res < 0) {
+                return false;
+            }
+            obj->getInListEx(filter, true);
+            filter.insert(obj);
+        }
+        else {
+            if (obj->isTouched() || doRecompute) {
+                signalRecomputedObject(*obj);
+                obj->purgeTouched();
+                for (auto inObjIt : obj->getInList()) {
+                    inObjIt->enforceRecompute();
+                }
+            }
+            if (seq) {
+                seq->next(true);
+            }
+        }
+        release(obj);
+        return true;
+    };
+
+    // Signal the changes made on a worker the way DocumentObject::onChanged() does
+    auto deliver = [this](const DeferredChanges& changes) {
+        for (auto& [who, what] : changes) {
+            signalChangedObjectImmediate(*who, *what);
+            if (!ChangeBatch::add(who, what)) {
+                onChangedProperty(who, what);
+                who->signalChanged(*who, *what);
+            }
+        }
+    };
+
+    std::size_t running = 0;
+    // Wait for the objects still executing and signal their changes. Like the
+    // objects not yet started they stay touched for the next recompute.
+    auto drain = [&]() {
+        if (!workers) {
+            return;
+        }
+        running -= workers->cancel();
+        for (; running > 0; --running) {
+            deliver(workers->pop().changes);
+        }
+    };
+
+    bool aborted = false;
+    try {
+        while (!aborted && (!ready.empty() || running > 0)) {
+            if (ready.empty()) {
+                auto result = workers->pop();
+                --running;
+                auto obj = result.obj;
+                deliver(result.changes);
+                int res = result.ret;
+                if (res == 0) {
+                    res = _recomputeFeature(obj, [obj]() {
+                        return obj->ExpressionEngine.execute(
+                            PropertyExpressionEngine::ExecuteOutput);
+                    });
+                }
+                aborted = !finish(obj, res, true);
+                continue;
+            }
+
+            auto obj = ready.front();
+            ready.pop_front();
+            if (!obj->isAttachedToDocument() || filter.contains(obj)) {
+                release(obj);
+                continue;
+            }
+            if (!obj->mustRecompute()) {
+                aborted = !finish(obj, 0, false);
+                continue;
+            }
+            ++objectCount;
+            if (workers && obj->isConcurrentExecutable()) {
+                FC_LOG("Recomputing " << obj->getFullName() << " concurrently");
+                {
+                    // open any pending transaction before leaving the main thread
+                    std::lock_guard<std::recursive_mutex> lock(d->recomputeMutex);
+                    _checkTransaction(nullptr, nullptr, __LINE__);
+                }
+                int res = _recomputeFeature(obj, [obj]() {
+                    return obj->ExpressionEngine.execute(
+                        PropertyExpressionEngine::ExecuteNonOutput);
+                });
+                if (res == 0) {
+                    workers->push(obj);
+                    ++running;
+                }
+                else {
+                    aborted = !finish(obj, res, true);
+                }
+                continue;
+            }
+            aborted = !finish(obj, _recomputeFeature(obj), true);
+        }
+    }
+    catch (...) {
+        drain();
+        throw;
+    }
+    if (aborted) {
+        drain();
+        return false;
+    }
+    return true;
+}
+
 int Document::recompute(const std::vector<DocumentObject*>& objs,
                         bool force,
                         bool* hasError,
                         int options)
 {
     ZoneScoped;
+    Base::TraceScope trace("document", [this]() { return std::string("recompute ") + getName(); });
 
     if (d->undoing || d->rollback) {
         if (FC_LOG_INSTANCE.isEnabled(FC_LOGLEVEL_LOG)) {
@@ -2940,21 +3454,36 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
    */
 
     // alt:
-    auto topoSortedObjects =
-        getDependencyList(objs.empty() ? d->objectArray : objs, DepSort | options);
+    std::vector<DocumentObject*> topoSortedObjects;
+    if (objs.empty() && d->dependencyGraph.update()) {
+        // Only touched objects and their dependents can be recomputed, so
+        // there is no need to sort the whole document.
+        std::vector<DocumentObject*> seeds;
+        for (auto obj : d->objectArray) {
+            if (obj->isTouched() || obj->mustRecompute()) {
+                seeds.push_back(obj);
+            }
+        }
+        topoSortedObjects = d->dependencyGraph.closure(seeds, true);
+    }
+    else {
+        topoSortedObjects =
+            getDependencyList(objs.empty() ? d->objectArray : objs, DepSort | options);
+    }
 
     for (auto obj : topoSortedObjects) {
         obj->setStatus(ObjectStatus::PendingRecompute, true);
     }
 
-    ParameterGrp::handle hGrp =
-        GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
-    bool canAbort = hGrp->GetBool("CanAbortRecompute", true);
+    bool canAbort = d->canAbortRecompute.get();
+    bool parallel = d->parallelRecompute.get();
 
     FC_TIME_INIT(t2);
 
     try {
         std::set<DocumentObject*> filter;
+        // objects already processed by the concurrent first pass
+        std::set<DocumentObject*> handled;
         size_t idx = 0;
         // maximum two passes to allow some form of dependency inversion
         for (int passes = 0; passes < 2 && idx < topoSortedObjects.size(); ++passes) {
@@ -2964,9 +3493,20 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
                                                                 topoSortedObjects.size());
             }
             FC_LOG("Recompute pass " << passes);
-            for (; idx < topoSortedObjects.size(); ++idx) {
+            if (passes == 0 && parallel
+                && !_recomputeConcurrently(topoSortedObjects,
+                                           options,
+                                           filter,
+                                           handled,
+                                           objectCount,
+                                           hasError,
+                                           seq.get())) {
+                passes = 2;
+            }
+            for (; passes < 2 && idx < topoSortedObjects.size(); ++idx) {
                 auto obj = topoSortedObjects[idx];
-                if (!obj->isAttachedToDocument() || filter.find(obj) != filter.end()) {
+                if (!obj->isAttachedToDocument() || filter.find(obj) != filter.end()
+                    || handled.contains(obj)) {
                     continue;
                 }
                 // ask the object if it should be recomputed
@@ -3002,6 +3542,7 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
                     seq->next(true);
                 }
             }
+            handled.clear();
             // check if all objects are recomputed but still thouched
             for (size_t i = 0; i < topoSortedObjects.size(); ++i) {
                 auto obj = topoSortedObjects[i];
@@ -3245,6 +3786,343 @@ DocumentP::topologicalSort(const std::vector<DocumentObject*>& objects) const
     return ret;
 }
 
+void DependencyGraph::addNode(DocumentObject* obj)
+{
+    auto& node = nodes[obj];
+    node.object = obj;
+    node.rank = nextRank++;
+    dirty.insert(obj);
+    // Links to this object may have been counted as external before it was
+    // (re)added, e.g. on undo of a deletion
+    if (external > 0) {
+        for (auto& [key, other] : nodes) {
+            if (other.external > 0) {
+                dirty.insert(key);
+            }
+        }
+    }
+}
+
+void DependencyGraph::removeNode(const DocumentObject* obj)
+{
+    auto it = nodes.find(obj);
+    if (it == nodes.end()) {
+        return;
+    }
+    auto& node = it->second;
+    for (auto dependency : node.outList) {
+        auto& inList = nodes.at(dependency).inList;
+        inList.erase(std::find(inList.begin(), inList.end(), node.object));
+    }
+    for (auto dependent : node.inList) {
+        auto& other = nodes.at(dependent);
+        auto pos = std::lower_bound(other.outList.begin(), other.outList.end(), node.object);
+        other.outList.erase(pos);
+        // the link is dangling now, count it as external until refreshed
+        ++other.external;
+        ++external;
+        dirty.insert(dependent);
+    }
+    external -= node.external;
+    dirty.erase(obj);
+    nodes.erase(it);
+}
+
+void DependencyGraph::markDirty(const DocumentObject* obj)
+{
+    if (nodes.contains(obj)) {
+        dirty.insert(obj);
+    }
+}
+
+void DependencyGraph::clear()
+{
+    nodes.clear();
+    dirty.clear();
+    external = 0;
+    nextRank = 0;
+    cyclic = false;
+}
+
+int DependencyGraph::rank(const DocumentObject* obj) const
+{
+    auto it = nodes.find(obj);
+    return it == nodes.end() ? -1 : it->second.rank;
+}
+
+void DependencyGraph::refresh(Node& node,
+                              std::vector<std::pair<DocumentObject*, DocumentObject*>>* added)
+{
+    std::vector<DocumentObject*> outList;
+    int ext = 0;
+    for (auto obj : node.object->getOutList()) {
+        if (!obj) {
+            continue;
+        }
+        if (nodes.contains(obj)) {
+            outList.push_back(obj);
+        }
+        else {
+            ++ext;
+        }
+    }
+    std::sort(outList.begin(), outList.end());
+    outList.erase(std::unique(outList.begin(), outList.end()), outList.end());
+
+    std::vector<DocumentObject*> removedLinks;
+    std::vector<DocumentObject*> addedLinks;
+    std::set_difference(node.outList.begin(),
+                        node.outList.end(),
+                        outList.begin(),
+                        outList.end(),
+                        std::back_inserter(removedLinks));
+    std::set_difference(outList.begin(),
+                        outList.end(),
+                        node.outList.begin(),
+                        node.outList.end(),
+                        std::back_inserter(addedLinks));
+    for (auto dependency : removedLinks) {
+        auto& inList = nodes.at(dependency).inList;
+        inList.erase(std::find(inList.begin(), inList.end(), node.object));
+    }
+    for (auto dependency : addedLinks) {
+        nodes.at(dependency).inList.push_back(node.object);
+        if (added) {
+            added->emplace_back(dependency, node.object);
+        }
+    }
+    node.outList.swap(outList);
+    external += ext - node.external;
+    node.external = ext;
+}
+
+bool DependencyGraph::update()
+{
+    if (!dirty.empty()) {
+        // Rebuild the whole order if a large part of the graph changed, e.g.
+        // after restoring, or if it was cyclic before.
+        bool full = cyclic || dirty.size() * 4 > nodes.size();
+        std::vector<std::pair<DocumentObject*, DocumentObject*>> added;
+        for (auto obj : dirty) {
+            refresh(nodes.at(obj), full ? nullptr : &added);
+        }
+        dirty.clear();
+        if (full) {
+            rebuildOrder();
+        }
+        else {
+            for (auto& [dependency, dependent] : added) {
+                if (!reorder(dependency, dependent)) {
+                    cyclic = true;
+                    break;
+                }
+            }
+        }
+    }
+    return !cyclic && external == 0;
+}
+
+// Pearce and Kelly, "A Dynamic Topological Sort Algorithm for Directed Acyclic Graphs"
+bool DependencyGraph::reorder(const DocumentObject* dependency, const DocumentObject* dependent)
+{
+    const int lower = nodes.at(dependent).rank;
+    const int upper = nodes.at(dependency).rank;
+    if (upper < lower) {
+        return true;
+    }
+    if (dependency == dependent) {
+        return false;
+    }
+
+    std::unordered_set<const DocumentObject*> visited;
+    std::vector<const DocumentObject*> pending;
+
+    // dependents of 'dependent' ranked below 'dependency'
+    std::vector<const DocumentObject*> forward;
+    pending.push_back(dependent);
+    visited.insert(dependent);
+    while (!pending.empty()) {
+        auto obj = pending.back();
+        pending.pop_back();
+        forward.push_back(obj);
+        for (auto next : nodes.at(obj).inList) {
+            if (next == dependency) {
+                return false;
+            }
+            if (nodes.at(next).rank < upper && visited.insert(next).second) {
+                pending.push_back(next);
+            }
+        }
+    }
+
+    // dependencies of 'dependency' ranked above 'dependent'
+    std::vector<const DocumentObject*> backward;
+    pending.push_back(dependency);
+    visited.insert(dependency);
+    while (!pending.empty()) {
+        auto obj = pending.back();
+        pending.pop_back();
+        backward.push_back(obj);
+        for (auto next : nodes.at(obj).outList) {
+            if (nodes.at(next).rank > lower && visited.insert(next).second) {
+                pending.push_back(next);
+            }
+        }
+    }
+
+    auto byRank = [this](const DocumentObject* a, const DocumentObject* b) {
+        return nodes.at(a).rank < nodes.at(b).rank;
+    };
+    std::sort(forward.begin(), forward.end(), byRank);
+    std::sort(backward.begin(), backward.end(), byRank);
+
+    // reassign the ranks of the affected region, dependencies first
+    std::vector<int> ranks;
+    ranks.reserve(forward.size() + backward.size());
+    for (auto obj : backward) {
+        ranks.push_back(nodes.at(obj).rank);
+    }
+    for (auto obj : forward) {
+        ranks.push_back(nodes.at(obj).rank);
+    }
+    std::sort(ranks.begin(), ranks.end());
+    auto rankIt = ranks.begin();
+    for (auto obj : backward) {
+        nodes.at(obj).rank = *rankIt++;
+    }
+    for (auto obj : forward) {
+        nodes.at(obj).rank = *rankIt++;
+    }
+    return true;
+}
+
+bool DependencyGraph::rebuildOrder()
+{
+    // visit the objects by their current rank to keep the order stable
+    std::vector<Node*> order;
+    order.reserve(nodes.size());
+    for (auto& [obj, node] : nodes) {
+        order.push_back(&node);
+    }
+    std::sort(order.begin(), order.end(), [](const Node* a, const Node* b) {
+        return a->rank < b->rank;
+    });
+
+    std::unordered_map<const DocumentObject*, std::size_t> pending;
+    std::deque<Node*> ready;
+    for (auto node : order) {
+        pending[node->object] = node->outList.size();
+        if (node->outList.empty()) {
+            ready.push_back(node);
+        }
+    }
+
+    int current = 0;
+    while (!ready.empty()) {
+        auto node = ready.front();
+        ready.pop_front();
+        node->rank = current++;
+        for (auto dependent : node->inList) {
+            if (--pending[dependent] == 0) {
+                ready.push_back(&nodes.at(dependent));
+            }
+        }
+    }
+
+    cyclic = current != static_cast<int>(nodes.size());
+    if (cyclic) {
+        // keep the ranks unique for the objects inside cycles
+        for (auto node : order) {
+            if (pending[node->object] > 0) {
+                node->rank = current++;
+            }
+        }
+    }
+    nextRank = current;
+    return !cyclic;
+}
+
+std::vector<DocumentObject*> DependencyGraph::closure(const std::vector<DocumentObject*>& objs,
+                                                      bool dependents) const
+{
+    std::vector<DocumentObject*> res;
+    std::unordered_set<const DocumentObject*> visited;
+    for (auto obj : objs) {
+        if (visited.insert(obj).second) {
+            res.push_back(obj);
+        }
+    }
+    for (std::size_t i = 0; i < res.size(); ++i) {
+        const auto& node = nodes.at(res[i]);
+        for (auto next : dependents ? node.inList : node.outList) {
+            if (visited.insert(next).second) {
+                res.push_back(next);
+            }
+        }
+    }
+    std::sort(res.begin(), res.end(), [this](const DocumentObject* a, const DocumentObject* b) {
+        return nodes.at(a).rank < nodes.at(b).rank;
+    });
+    return res;
+}
+
+int DependencyGraph::isInInListRecursive(const DocumentObject* obj,
+                                         const std::vector<DocumentObject*>& candidates)
+{
+    if (!update()) {
+        return -1;
+    }
+    const int lower = rank(obj);
+    if (lower < 0) {
+        return -1;
+    }
+
+    // Objects in the in list rank higher than the object itself, so only
+    // candidates ranked higher have to be searched for.
+    int upper = -1;
+    std::unordered_set<const DocumentObject*> targets;
+    for (auto candidate : candidates) {
+        if (!candidate) {
+            continue;
+        }
+        int candidateRank = rank(candidate);
+        if (candidateRank < 0) {
+            return -1;
+        }
+        if (candidateRank > lower) {
+            upper = std::max(upper, candidateRank);
+            targets.insert(candidate);
+        }
+    }
+    if (targets.empty()) {
+        return 0;
+    }
+
+    std::vector<const DocumentObject*> pending {obj};
+    std::unordered_set<const DocumentObject*> visited {obj};
+    while (!pending.empty()) {
+        auto current = pending.back();
+        pending.pop_back();
+        for (auto next : current->getInList()) {
+            if (!next || !next->isAttachedToDocument()) {
+                continue;
+            }
+            int linkRank = rank(next);
+            if (linkRank < 0) {
+                return -1;
+            }
+            if (linkRank > upper || !visited.insert(next).second) {
+                continue;
+            }
+            if (targets.contains(next)) {
+                return 1;
+            }
+            pending.push_back(next);
+        }
+    }
+    return 0;
+}
+
 std::vector<DocumentObject*> Document::topologicalSort() const
 {
     return d->topologicalSort(d->objectArray);
@@ -3260,9 +4138,9 @@ int Document::_recomputeFeature(DocumentObject* Feat) // NOLINT
 {
     FC_LOG("Recomputing " << Feat->getFullName());
 
-    DocumentObjectExecReturn* returnCode = nullptr;
-    try {
-        returnCode = Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
+    return _recomputeFeature(Feat, [Feat]() {
+        auto returnCode =
+            Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
         if (returnCode == DocumentObject::StdReturn) {
             returnCode = Feat->recompute();
             if (returnCode == DocumentObject::StdReturn) {
@@ -3270,6 +4148,17 @@ int Document::_recomputeFeature(DocumentObject* Feat) // NOLINT
                     Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteOutput);
             }
         }
+        return returnCode;
+    });
+}
+
+int Document::_recomputeFeature(DocumentObject* Feat,  // NOLINT
+                                const std::function<DocumentObjectExecReturn*()>& step)
+{
+    Base::TraceScope trace("recompute", [Feat]() { return Feat->getFullName(); });
+    DocumentObjectExecReturn* returnCode = nullptr;
+    try {
+        returnCode = step();
     }
     catch (Base::AbortException& e) {
         e.reportException();
@@ -3306,6 +4195,7 @@ int Document::_recomputeFeature(DocumentObject* Feat) // NOLINT
     }
     else {
         returnCode->Which = Feat;
+        trace.setDetail(returnCode->Why);
         d->addRecomputeLog(returnCode);
         FC_LOG("Failed to recompute " << Feat->getFullName() << ": " << returnCode->Why);
         return 1;
@@ -3381,6 +4271,7 @@ DocumentObject* Document::addObject(const char* sType,
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
     // insert in the vector
     d->objectArray.push_back(pcObject);
+    d->dependencyGraph.addNode(pcObject);
     // Register the current Label even though it is (probably) about to change
     registerLabel(pcObject->Label.getStrValue());
 
@@ -3478,6 +4369,7 @@ Document::addObjects(const char* sType, const std::vector<std::string>& objectNa
         pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
         // insert in the vector
         d->objectArray.push_back(pcObject);
+        d->dependencyGraph.addNode(pcObject);
         // Register the current Label even though it is about to change
         registerLabel(pcObject->Label.getStrValue());
 
@@ -3551,6 +4443,7 @@ void Document::addObject(DocumentObject* pcObject, const char* pObjectName)
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
     // insert in the vector
     d->objectArray.push_back(pcObject);
+    d->dependencyGraph.addNode(pcObject);
     // Register the current Label even though it is about to change
     registerLabel(pcObject->Label.getStrValue());
 
@@ -3583,6 +4476,7 @@ void Document::_addObject(DocumentObject* pcObject, const char* pObjectName)
     }
     d->objectIdMap[pcObject->_Id] = pcObject;
     d->objectArray.push_back(pcObject);
+    d->dependencyGraph.addNode(pcObject);
     registerLabel(pcObject->Label.getStrValue());
     // cache the pointer to the name string in the Object (for performance of
     // DocumentObject::getNameInDocument())
@@ -3708,6 +4602,7 @@ void Document::removeObject(const char* sName)
     if (tobedestroyed) {
         tobedestroyed->pcNameInDocument = nullptr;
     }
+    d->dependencyGraph.removeNode(pos->second);
     d->objectNameManager.removeExactName(pos->first);
     d->objectMap.erase(pos);
 }
@@ -3788,6 +4683,7 @@ void Document::_removeObject(DocumentObject* pcObject)
     d->objectIdMap.erase(pcObject->_Id);
     d->objectNameManager.removeExactName(pos->first);
     unregisterLabel(pos->second->Label.getStrValue());
+    d->dependencyGraph.removeNode(pcObject);
     d->objectMap.erase(pos);
 
     for (auto it = d->objectArray.begin();
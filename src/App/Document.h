@@ -29,6 +29,7 @@
 #include <Base/Type.h>
 #include <Base/Handle.h>
 
+#include "MemoryReport.h"
 #include "PropertyContainer.h"
 #include "PropertyLinks.h"
 #include "PropertyStandard.h"
@@ -41,6 +42,7 @@
 
 namespace Base
 {
+class SequencerLauncher;
 class Writer;
 }
 
@@ -145,6 +147,11 @@ public:
     boost::signals2::signal<void(const DocumentObject&, const Property&)> signalBeforeChangeObject;
     /// signal on changed Object
     boost::signals2::signal<void(const DocumentObject&, const Property&)> signalChangedObject;
+    /** signal on changed Object, emitted immediately even when the change
+     * notifications are coalesced by an App::ChangeBatch
+     */
+    boost::signals2::signal<void(const DocumentObject&, const Property&)>
+        signalChangedObjectImmediate;
     /// signal on manually called DocumentObject::touch()
     boost::signals2::signal<void(const DocumentObject&)> signalTouchedObject;
     /// signal on relabeled Object
@@ -189,6 +196,8 @@ public:
     boost::signals2::signal<void(const DocumentObject&)> signalFinishRestoreObject;
     boost::signals2::signal<void(const Document&, const Property&)> signalChangePropertyEditor;
     boost::signals2::signal<void(std::string)> signalLinkXsetValue;
+    // signal to let e.g. the GUI add its memory usage to a report
+    boost::signals2::signal<void(const Document&, MemoryReport&)> signalMemoryReport;
     // clang-format on
     //@}
     // NOLINTEND
@@ -210,6 +219,12 @@ public:
                  const std::vector<std::string>& objNames = {});
     bool afterRestore(bool checkPartial = false);
     bool afterRestore(const std::vector<DocumentObject*>&, bool checkPartial = false);
+    /** Reads all geometry whose loading has been deferred on restore
+     * With the "LazyLoadGeometry" preference the geometry properties are
+     * only read from the project file on first access.
+     * @return the number of properties loaded
+     */
+    int loadDeferredProperties() const;
     enum ExportStatus
     {
         NotExporting,
@@ -256,6 +271,10 @@ public:
     /// returns the complete document memory consumption, including all managed DocObjects and Undo
     /// Redo.
     unsigned int getMemSize() const override;
+    /** Returns the memory used by the document broken down by object,
+     * property type, element maps, string hasher, undo and view providers
+     */
+    MemoryReport getMemoryReport() const;
 
     /** @name Object handling  */
     //@{
@@ -461,10 +480,19 @@ public:
     /// Check if a transaction is open and its list is empty.
     /// If no transaction is open true is returned.
     bool isTransactionEmpty() const;
-    /// Set the Undo limit in Byte!
+    /// Set the Undo limit in Byte!, same as setUndoBudget()
     void setUndoLimit(unsigned int UndoMemSize = 0);
     /// Returns the actual memory consumption of the Undo redo stuff.
     unsigned int getUndoMemSize() const;
+    /** Sets the maximum size of the undo and redo data in bytes, 0 = no limit
+     * When exceeded the oldest undo transactions are removed, but never the
+     * latest one.
+     */
+    void setUndoBudget(std::size_t bytes);
+    /// Returns the maximum size of the undo and redo data in bytes
+    std::size_t getUndoBudget() const;
+    /// Returns the size of the undo and redo data in bytes
+    std::size_t getUndoBytes() const;
     /// Set the Undo limit as stack size
     void setMaxUndoStackSize(unsigned int UndoMaxStackSize = 20);  // NOLINT
     /// Set the Undo limit as stack size
@@ -617,6 +645,7 @@ public:
     friend class DocumentObject;
     friend class Transaction;
     friend class TransactionDocumentObject;
+    friend class ChangeBatch;
 
     /// Destruction
     ~Document() override;
@@ -644,6 +673,34 @@ protected:
     /// helper which Recompute only this feature
     /// @return 0 if succeeded, 1 if failed, -1 if aborted by user.
     int _recomputeFeature(DocumentObject* Feat);
+    /// helper which runs one step of a feature recompute and handles its exceptions and errors
+    /// @return 0 if succeeded, 1 if failed, -1 if aborted by user.
+    int _recomputeFeature(DocumentObject* Feat,
+                          const std::function<DocumentObjectExecReturn*()>& step);
+    /** helper which runs the first recompute pass as a dependency driven schedule
+     *
+     * Objects are processed as soon as all their inputs are finished. Objects
+     * that allow concurrent execution are executed on a worker pool, all others
+     * on the calling thread. Objects that cannot be scheduled (e.g. due to a
+     * dependency cycle) are left out of \a handled.
+     *
+     * @return false if aborted by user.
+     */
+    bool _recomputeConcurrently(const std::vector<DocumentObject*>& objs,
+                                int options,
+                                std::set<DocumentObject*>& filter,
+                                std::set<DocumentObject*>& handled,
+                                int& objectCount,
+                                bool* hasError,
+                                Base::SequencerLauncher* seq);
+    /// Check if the calling thread is a worker thread of a concurrent recompute
+    static bool isRecomputeWorker();
+    /** Queue the change notification of a property modified on a recompute worker thread
+     *
+     * @return true if the notification is deferred until the object is
+     * finished, false if it must be signaled immediately
+     */
+    bool deferChangedProperty(DocumentObject* Who, const Property* What);
     void _clearRedos();
 
     /// refresh the internal dependency graph
@@ -668,6 +725,8 @@ protected:
     void _commitTransaction(bool notify = false);
     /// Internally called by Application to abort the running transaction.
     void _abortTransaction();
+    /// Removes the oldest undo transactions exceeding the stack size or the budget
+    void _trimUndoTransactions();
 
 private:
     // # Data Member of the document
@@ -1,6 +1,6 @@
 from PropertyContainer import PropertyContainer
 from DocumentObject import DocumentObject
-from typing import Final, List, Tuple, Sequence
+from typing import Final, List, Tuple, Sequence, Union
 
 
 class Document(PropertyContainer):
@@ -34,6 +34,13 @@ class Document(PropertyContainer):
     UndoRedoMemSize: Final[int] = 0
     """The size of the Undo stack in byte"""
 
+    UndoBytes: Final[int] = 0
+    """The size of the Undo and Redo data in byte"""
+
+    UndoBudget: int = 0
+    """The maximum size of the Undo and Redo data in byte, 0 for no limit.
+The oldest Undos are removed when exceeded, the latest one is always kept."""
+
     UndoCount: Final[int] = 0
     """Number of possible Undos"""
 
@@ -112,6 +119,28 @@ class Document(PropertyContainer):
         """
         ...
 
+    def loadDeferredProperties(self) -> int:
+        """
+        Read all geometry whose loading has been deferred on restore and return
+        the number of properties loaded.
+
+        With the 'LazyLoadGeometry' document preference the shape, mesh and
+        point properties are only read from the project file on first access.
+        """
+        ...
+
+    def getMemoryReport(self, json: bool = False) -> Union[dict, str]:
+        """
+        getMemoryReport(json=False)
+
+        Return the estimated memory used by the document in bytes, broken down
+        by object, property type, element maps, string hasher tables, undo
+        stack and view providers.
+
+        json: if True return the report as JSON text instead of a dict
+        """
+        ...
+
     def isSaved(self) -> bool:
         """
         Checks if the document is saved
@@ -326,9 +355,25 @@ class Document(PropertyContainer):
         """
         ...
 
-    def recompute(self, objs: Sequence[DocumentObject] = None) -> int:
+    def recompute(
+        self,
+        objs: Sequence[DocumentObject] = None,
+        force: bool = False,
+        checkCycle: bool = False,
+        *,
+        trace: str = None,
+    ) -> int:
         """
-        recompute(objs=None): Recompute the document and returns the amount of recomputed features
+        recompute(objs=None, force=False, checkCycle=False, trace=None)
+
+        Recompute the document and returns the amount of recomputed features
+
+        objs (Sequence): the objects to recompute, all touched objects if None.
+        force (Boolean): recompute even if the document has the SkipRecompute status.
+        checkCycle (Boolean): report an error on cyclic dependencies.
+        trace (String): if given, record the timing of object execution, property
+                change notifications, expression evaluation and touch propagation
+                and write it to this file as Chrome trace event JSON.
         """
         ...
 
@@ -36,9 +36,11 @@
 #include <Base/Console.h>
 #include <Base/Matrix.h>
 #include <Base/Tools.h>
+#include <Base/TraceRecorder.h>
 #include <Base/Writer.h>
 
 #include "Application.h"
+#include "ChangeBatch.h"
 #include "ElementNamingUtils.h"
 #include "Document.h"
 #include "DocumentObject.h"
@@ -49,6 +51,7 @@
 #include "ObjectIdentifier.h"
 #include "PropertyExpressionEngine.h"
 #include "PropertyLinks.h"
+#include "private/DocumentP.h"
 
 
 FC_LOG_LEVEL_INIT("App", true, true)
@@ -85,6 +88,8 @@ DocumentObject::DocumentObject()
 
 DocumentObject::~DocumentObject()
 {
+    ChangeBatch::remove(this);
+
     if (!PythonObject.is(Py::_None())) {
         Base::PyGILStateLocker lock;
         // Remark: The API of Py::Object has been changed to set whether the wrapper owns the passed
@@ -159,6 +164,8 @@ App::DocumentObjectExecReturn* DocumentObject::recompute()
         printInvalidLinks();
     }
 
+    Base::TraceScope trace("execute", [this]() { return getFullName(); });
+
     // set/unset the execution bit
     Base::ObjectStatusLocker<ObjectStatus, DocumentObject> exe(App::Recompute, this);
 
@@ -219,6 +226,11 @@ void DocumentObject::touch(bool noRecompute)
         StatusBits.set(ObjectStatus::Enforce);
     }
     StatusBits.set(ObjectStatus::Touch);
+    if (Base::TraceRecorder::isActive()) {
+        Base::TraceRecorder::instance().addInstant("touch",
+                                                   getFullName(),
+                                                   noRecompute ? "noRecompute" : "");
+    }
     if (_pDoc) {
         _pDoc->signalTouchedObject(*this);
     }
@@ -546,6 +558,14 @@ void _getOutListRecursive(std::set<DocumentObject*>& objSet,
 
 std::vector<App::DocumentObject*> DocumentObject::getOutListRecursive() const
 {
+    if (_pDoc && _pDoc->d->dependencyGraph.update()
+        && _pDoc->d->dependencyGraph.rank(this) >= 0) {
+        auto self = const_cast<DocumentObject*>(this);
+        auto result = _pDoc->d->dependencyGraph.closure({self}, false);
+        result.erase(std::find(result.begin(), result.end(), self));
+        return result;
+    }
+
     // number of objects in document is a good estimate in result size
     int maxDepth = GetApplication().checkLinkDepth(0);
     std::set<App::DocumentObject*> result;
@@ -581,7 +601,16 @@ bool _isInInListRecursive(const DocumentObject* act, const DocumentObject* check
 
 bool DocumentObject::isInInListRecursive(DocumentObject* linkTo) const
 {
-    return this == linkTo || getInListEx(true).contains(linkTo);
+    if (this == linkTo) {
+        return true;
+    }
+    if (_pDoc) {
+        int res = _pDoc->d->dependencyGraph.isInInListRecursive(this, {linkTo});
+        if (res >= 0) {
+            return res > 0;
+        }
+    }
+    return getInListEx(true).contains(linkTo);
 }
 
 bool DocumentObject::isInInList(DocumentObject* linkTo) const
@@ -641,6 +670,12 @@ bool DocumentObject::testIfLinkDAGCompatible(DocumentObject* linkTo) const
 
 bool DocumentObject::testIfLinkDAGCompatible(const std::vector<DocumentObject*>& linksTo) const
 {
+    if (_pDoc && std::find(linksTo.begin(), linksTo.end(), this) == linksTo.end()) {
+        int res = _pDoc->d->dependencyGraph.isInInListRecursive(this, linksTo);
+        if (res >= 0) {
+            return res == 0;
+        }
+    }
     auto inLists = getInListEx(true);
     inLists.emplace(const_cast<DocumentObject*>(this));
     for (auto obj : linksTo) {
@@ -742,6 +777,10 @@ void DocumentObject::onBeforeChange(const Property* prop)
         onBeforeChangeProperty(_pDoc, prop);
     }
 
+    if (Document::isRecomputeWorker()) {
+        return;
+    }
+
     signalBeforeChange(*this, *prop);
 }
 
@@ -878,6 +917,21 @@ void DocumentObject::onChanged(const Property* prop)
     // call the parent for appropriate handling
     TransactionalObject::onChanged(prop);
 
+    // Changes made on a recompute worker thread are signaled later on the
+    // main thread
+    if (_pDoc && _pDoc->deferChangedProperty(this, prop)) {
+        return;
+    }
+
+    if (_pDoc) {
+        _pDoc->signalChangedObjectImmediate(*this, *prop);
+    }
+
+    // Inside a ChangeBatch the notification is sent once at the end of the batch
+    if (ChangeBatch::add(this, prop)) {
+        return;
+    }
+
     // Now signal the view provider
     if (_pDoc) {
         _pDoc->onChangedProperty(this, prop);
@@ -891,6 +945,9 @@ void DocumentObject::clearOutListCache() const
     _outList.clear();
     _outListMap.clear();
     _outListCached = false;
+    if (_pDoc) {
+        _pDoc->d->dependencyGraph.markDirty(this);
+    }
 }
 
 PyObject* DocumentObject::getPyObject()
@@ -1267,6 +1324,9 @@ void App::DocumentObject::_removeBackLink(DocumentObject* rmvObj)
     if (it != _inList.end()) {
         _inList.erase(it);
     }
+    if (rmvObj && rmvObj->_pDoc) {
+        rmvObj->_pDoc->d->dependencyGraph.markDirty(rmvObj);
+    }
 }
 
 void App::DocumentObject::_addBackLink(DocumentObject* newObj)
@@ -1276,6 +1336,9 @@ void App::DocumentObject::_addBackLink(DocumentObject* newObj)
     // only once this removal would clear the object from the inlist, even though there may be other
     // link properties from this object that link to us.
     _inList.push_back(newObj);
+    if (newObj && newObj->_pDoc) {
+        newObj->_pDoc->d->dependencyGraph.markDirty(newObj);
+    }
 }
 
 int DocumentObject::setElementVisible(const char* element, bool visible)
@@ -1312,6 +1375,19 @@ bool DocumentObject::hasChildElement() const
     return false;
 }
 
+bool DocumentObject::isConcurrentExecutable() const
+{
+    if (!allowConcurrentExecute()) {
+        return false;
+    }
+    for (auto ext : getExtensionsDerivedFromType<DocumentObjectExtension>()) {
+        if (!ext->extensionAllowConcurrentExecute()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 DocumentObject* DocumentObject::resolve(const char* subname,
                                         App::DocumentObject** parent,
                                         std::string* childName,
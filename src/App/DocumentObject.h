@@ -517,6 +517,25 @@ public:
     {
         return false;
     }
+
+    /** Return true if execute() can be run on a recompute worker thread
+     *
+     * When parallel recompute is enabled, Document::recompute() may run
+     * recompute() of objects returning true here concurrently with other
+     * such objects whose inputs are ready. An implementation opting in must
+     * only modify its own non-link properties, must not call into Python and
+     * must not access other objects except for reading their output. Change
+     * notifications triggered during execution are delivered afterwards on
+     * the main thread.
+     *
+     * @sa isConcurrentExecutable()
+     */
+    virtual bool allowConcurrentExecute() const
+    {
+        return false;
+    }
+    /// Check if the object and all its extensions allow concurrent execution
+    bool isConcurrentExecutable() const;
     /// Handle Label changes, including forcing unique label values,
     /// signalling OnBeforeLabelChange, and arranging to update linked references,
     /// on the assumption that after returning the label will indeed be changed to
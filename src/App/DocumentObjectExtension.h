@@ -118,6 +118,14 @@ public:
     {
         return false;
     }
+
+    /** Return true if extensionExecute() can be run on a recompute worker thread
+     *  @sa DocumentObject::allowConcurrentExecute()
+     */
+    virtual bool extensionAllowConcurrentExecute() const
+    {
+        return false;
+    }
 };
 
 }  // namespace App
@@ -26,6 +26,7 @@
 #include <Base/FileInfo.h>
 #include <Base/Interpreter.h>
 #include <Base/Stream.h>
+#include <Base/TraceRecorder.h>
 
 #include "Document.h"
 #include "DocumentObject.h"
@@ -234,6 +235,70 @@ PyObject* DocumentPy::restore(PyObject* args)
     Py_Return;
 }
 
+PyObject* DocumentPy::loadDeferredProperties(PyObject* args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return nullptr;
+    }
+    int count = getDocumentPtr()->loadDeferredProperties();
+    return Py::new_reference_to(Py::Long(count));
+}
+
+PyObject* DocumentPy::getMemoryReport(PyObject* args)
+{
+    PyObject* json = Py_False;
+    if (!PyArg_ParseTuple(args, "|O!", &PyBool_Type, &json)) {
+        return nullptr;
+    }
+    PY_TRY
+    {
+        auto report = getDocumentPtr()->getMemoryReport();
+        if (Base::asBoolean(json)) {
+            return Py::new_reference_to(Py::String(report.toJson()));
+        }
+
+        auto toLong = [](std::size_t value) {
+            return Py::Long(static_cast<unsigned long long>(value));
+        };
+
+        Py::Dict types;
+        for (const auto& [type, usage] : report.propertyTypes) {
+            Py::Dict entry;
+            entry.setItem("count", toLong(usage.count));
+            entry.setItem("bytes", toLong(usage.bytes));
+            types.setItem(type, entry);
+        }
+
+        Py::List objects;
+        for (const auto& usage : report.objects) {
+            Py::Dict entry;
+            entry.setItem("name", Py::String(usage.name));
+            entry.setItem("label", Py::String(usage.label));
+            entry.setItem("type", Py::String(usage.type));
+            entry.setItem("total", toLong(usage.total()));
+            entry.setItem("properties", toLong(usage.properties));
+            entry.setItem("elementMaps", toLong(usage.elementMaps));
+            entry.setItem("viewProvider", toLong(usage.viewProvider));
+            objects.append(entry);
+        }
+
+        Py::Dict ret;
+        ret.setItem("document", Py::String(report.document));
+        ret.setItem("total", toLong(report.total()));
+        ret.setItem("properties", toLong(report.propertiesTotal()));
+        ret.setItem("documentProperties", toLong(report.documentProperties));
+        ret.setItem("elementMaps", toLong(report.elementMapsTotal()));
+        ret.setItem("viewProviders", toLong(report.viewProvidersTotal()));
+        ret.setItem("stringHashers", toLong(report.stringHashers));
+        ret.setItem("undo", toLong(report.undo));
+        ret.setItem("deferredProperties", toLong(report.deferredProperties));
+        ret.setItem("propertyTypes", types);
+        ret.setItem("objects", objects);
+        return Py::new_reference_to(ret);
+    }
+    PY_CATCH;
+}
+
 PyObject* DocumentPy::isSaved(PyObject* args)
 {
     if (!PyArg_ParseTuple(args, "")) {
@@ -681,20 +746,31 @@ PyObject *DocumentPy::isAutoCreated(PyObject *args)
     return Py::new_reference_to(Py::Boolean(ok));
 }
 
-PyObject* DocumentPy::recompute(PyObject* args)
+PyObject* DocumentPy::recompute(PyObject* args, PyObject* kwd)
 {
     PyObject* pyobjs = Py_None;
     PyObject* force = Py_False;
     PyObject* checkCycle = Py_False;
-    if (!PyArg_ParseTuple(args,
-                          "|OO!O!",
-                          &pyobjs,
-                          &PyBool_Type,
-                          &force,
-                          &PyBool_Type,
-                          &checkCycle)) {
+    char* trace = nullptr;
+    static const std::array<const char*, 5> kwlist {"objs", "force", "checkCycle", "trace", nullptr};
+    if (!Base::Wrapped_ParseTupleAndKeywords(args,
+                                             kwd,
+                                             "|OO!O!et",
+                                             kwlist,
+                                             &pyobjs,
+                                             &PyBool_Type,
+                                             &force,
+                                             &PyBool_Type,
+                                             &checkCycle,
+                                             "utf-8",
+                                             &trace)) {
         return nullptr;
     }
+    std::string traceFile;
+    if (trace) {
+        traceFile = trace;
+        PyMem_Free(trace);
+    }
 
     PY_TRY
     {
@@ -722,8 +798,25 @@ PyObject* DocumentPy::recompute(PyObject* args)
             options = Document::DepNoCycle;
         }
 
-        int objectCount =
-            getDocumentPtr()->recompute(objs, Base::asBoolean(force), nullptr, options);
+        auto& recorder = Base::TraceRecorder::instance();
+        if (!traceFile.empty()) {
+            recorder.start();
+        }
+        int objectCount = 0;
+        try {
+            objectCount =
+                getDocumentPtr()->recompute(objs, Base::asBoolean(force), nullptr, options);
+        }
+        catch (...) {
+            if (!traceFile.empty()) {
+                recorder.stop();
+            }
+            throw;
+        }
+        if (!traceFile.empty()) {
+            recorder.stop();
+            recorder.saveChromeTrace(traceFile);
+        }
 
         // Document::recompute() hides possibly raised Python exceptions by its features
         // So, check if an error is set and return null if yes
@@ -942,6 +1035,25 @@ Py::Long DocumentPy::getUndoRedoMemSize() const
     return Py::Long((long)getDocumentPtr()->getUndoMemSize());
 }
 
+Py::Long DocumentPy::getUndoBytes() const
+{
+    return Py::Long(static_cast<unsigned long long>(getDocumentPtr()->getUndoBytes()));
+}
+
+Py::Long DocumentPy::getUndoBudget() const
+{
+    return Py::Long(static_cast<unsigned long long>(getDocumentPtr()->getUndoBudget()));
+}
+
+void DocumentPy::setUndoBudget(Py::Long arg)
+{
+    long long bytes = arg.as_long_long();
+    if (bytes < 0) {
+        throw Py::ValueError("UndoBudget must not be negative");
+    }
+    getDocumentPtr()->setUndoBudget(static_cast<std::size_t>(bytes));
+}
+
 Py::Long DocumentPy::getUndoCount() const
 {
     return Py::Long((long)getDocumentPtr()->getAvailableUndos());
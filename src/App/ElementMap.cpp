@@ -11,6 +11,7 @@
 
 #include "App/Application.h"
 #include "Base/Console.h"
+#include "Base/Stream.h"
 #include "Document.h"
 #include "DocumentObject.h"
 
@@ -447,7 +448,7 @@ ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef,
                     }
                 }
 
-                this->mappedNames.emplace(ref->name, idx);
+                this->mappedNames.insert(ref->name, idx);
 
                 if (!hasherRef) {
                     if (offset + 1 < (int)tokens.size()) {
@@ -499,6 +500,389 @@ ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef,
     return shared_from_this();
 }
 
+namespace
+{
+
+// Kind of a stored name in the binary element map format
+enum class BinaryName : uint8_t
+{
+    Raw,
+    Indexed,
+    Hashed,
+};
+
+constexpr uint32_t maxBinaryCount {1U << 30};
+
+void writeBytes(Base::OutputStream& str, const char* data, int size)
+{
+    str << static_cast<uint32_t>(size);
+    str.write(data, size);
+}
+
+void writeStringIDs(Base::OutputStream& str, const ElementIDRefs& sids, long skipID)
+{
+    uint32_t count = 0;
+    for (auto& sid : sids) {
+        if (sid.isMarked() && sid.value() != skipID) {
+            ++count;
+        }
+    }
+    str << count;
+    for (auto& sid : sids) {
+        if (sid.isMarked() && sid.value() != skipID) {
+            str << static_cast<int64_t>(sid.value());
+        }
+    }
+}
+
+uint32_t readCount(Base::InputStream& str, uint32_t limit, const char* msg)
+{
+    uint32_t count = 0;
+    if (!(str >> count) || count > limit) {
+        FC_THROWM(Base::RuntimeError, msg);  // NOLINT
+    }
+    return count;
+}
+
+void readBytes(Base::InputStream& str, std::string& bytes)
+{
+    uint32_t size = readCount(str, maxBinaryCount, "Invalid element map string");
+    bytes.resize(size);
+    if (size != 0 && !str.read(bytes.data(), static_cast<int>(size))) {
+        FC_THROWM(Base::RuntimeError, "Invalid element map string");  // NOLINT
+    }
+}
+
+void readStringIDs(Base::InputStream& str,
+                   const ::App::StringHasherRef& hasherRef,
+                   ElementIDRefs& sids,
+                   const char*& warn)
+{
+    uint32_t count = readCount(str, maxBinaryCount, "Invalid element string id count");
+    if (count != 0 && !hasherRef) {
+        warn = "No hasherRef";
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        int64_t id = 0;
+        if (!(str >> id)) {
+            FC_THROWM(Base::RuntimeError, "Invalid element string id");  // NOLINT
+        }
+        if (!hasherRef) {
+            continue;
+        }
+        auto sid = hasherRef->getID(static_cast<long>(id));
+        if (!sid) {
+            warn = "Invalid element name string id";
+        }
+        else {
+            sids.push_back(sid);
+        }
+    }
+}
+
+}  // namespace
+
+void ElementMap::saveBinary(std::ostream& stream,
+                            const std::map<const ElementMap*, int>& childMapSet,
+                            const std::map<QByteArray, int>& postfixMap) const
+{
+    Base::OutputStream str(stream);
+    str << static_cast<uint32_t>(this->indexedNames.size());
+
+    for (auto& indexedName : this->indexedNames) {
+        writeBytes(str, indexedName.first, static_cast<int>(qstrlen(indexedName.first)));
+
+        str << static_cast<uint32_t>(indexedName.second.children.size());
+        for (auto& vv : indexedName.second.children) {
+            auto& child = vv.second;
+            int mapIndex = 0;
+            if (child.elementMap) {
+                auto it = childMapSet.find(child.elementMap.get());
+                if (it == childMapSet.end() || it->second == 0) {
+                    FC_ERR("Invalid child element map");  // NOLINT
+                }
+                else {
+                    mapIndex = it->second;
+                }
+            }
+            str << static_cast<int32_t>(child.indexedName.getIndex())
+                << static_cast<int32_t>(child.offset) << static_cast<int32_t>(child.count)
+                << static_cast<int64_t>(child.tag) << static_cast<int32_t>(mapIndex);
+            writeBytes(str, child.postfix.constData(), child.postfix.size());
+            writeStringIDs(str, child.sids, 0);
+        }
+
+        str << static_cast<uint32_t>(indexedName.second.names.size());
+        for (auto& dequeueOfMappedNameRef : indexedName.second.names) {
+            uint32_t count = 0;
+            for (auto ref = &dequeueOfMappedNameRef; ref && ref->name; ref = ref->next.get()) {
+                ++count;
+            }
+            str << count;
+
+            auto ref = &dequeueOfMappedNameRef;
+            for (uint32_t i = 0; i < count; ++i, ref = ref->next.get()) {
+                const QByteArray& data = ref->name.dataBytes();
+                long prefixID = 0;
+                BinaryName kind = BinaryName::Raw;
+                IndexedName idx(data);
+                std::map<QByteArray, int>::const_iterator typeIt = postfixMap.end();
+                if (idx) {
+                    typeIt = postfixMap.find(
+                        QByteArray::fromRawData(idx.getType(),
+                                                static_cast<int>(qstrlen(idx.getType()))));
+                    if (typeIt != postfixMap.end()) {
+                        kind = BinaryName::Indexed;
+                    }
+                }
+                else if (auto indexID = ::App::StringID::fromString(data)) {
+                    for (auto& sid : ref->sids) {
+                        if (sid.isMarked() && sid.value() == indexID.id) {
+                            kind = BinaryName::Hashed;
+                            prefixID = indexID.id;
+                            break;
+                        }
+                    }
+                }
+
+                str << static_cast<uint8_t>(kind);
+                if (kind == BinaryName::Indexed) {
+                    str << static_cast<uint32_t>(typeIt->second)
+                        << static_cast<int32_t>(idx.getIndex());
+                }
+                else {
+                    writeBytes(str, data.constData(), data.size());
+                }
+
+                const QByteArray& postfix = ref->name.postfixBytes();
+                uint32_t postfixIndex = 0;
+                if (!postfix.isEmpty()) {
+                    auto it = postfixMap.find(postfix);
+                    assert(it != postfixMap.end());
+                    postfixIndex = static_cast<uint32_t>(it->second);
+                }
+                str << postfixIndex;
+                writeStringIDs(str, ref->sids, prefixID);
+            }
+        }
+    }
+}
+
+void ElementMap::saveBinary(std::ostream& stream) const
+{
+    std::map<const ElementMap*, int> childMapSet;
+    std::vector<const ElementMap*> childMaps;
+    std::map<QByteArray, int> postfixMap;
+    std::vector<QByteArray> postfixes;
+
+    collectChildMaps(childMapSet, childMaps, postfixMap, postfixes);
+
+    Base::OutputStream str(stream);
+    str << static_cast<uint32_t>(this->_id) << static_cast<uint32_t>(postfixes.size());
+    for (auto& postfix : postfixes) {
+        writeBytes(str, postfix.constData(), postfix.size());
+    }
+
+    // Each map is prefixed with its id and size, so that maps already
+    // restored through another object can be skipped as a whole.
+    str << static_cast<uint32_t>(childMaps.size());
+    std::ostringstream buffer;
+    for (auto& elementMap : childMaps) {
+        buffer.str("");
+        elementMap->saveBinary(buffer, childMapSet, postfixMap);
+        std::string data = buffer.str();
+        str << static_cast<uint32_t>(elementMap->_id) << static_cast<uint64_t>(data.size());
+        str.write(data.data(), static_cast<int>(data.size()));
+    }
+}
+
+ElementMapPtr ElementMap::restoreBinary(::App::StringHasherRef hasherRef, std::istream& stream)
+{
+    const char* msg = "Invalid element map";
+
+    Base::InputStream str(stream);
+    uint32_t id = 0;
+    if (!(str >> id)) {
+        FC_THROWM(Base::RuntimeError, msg);  // NOLINT
+    }
+
+    auto found = _idToElementMap.find(id);
+    if (found != _idToElementMap.end() && found->second) {
+        return found->second;
+    }
+
+    std::vector<std::string> postfixes(readCount(str, maxBinaryCount, msg));
+    for (auto& postfix : postfixes) {
+        readBytes(str, postfix);
+    }
+
+    constexpr uint32_t practicalMaximum {(1 << 30) / sizeof(ElementMapPtr)};
+    uint32_t count = readCount(str, practicalMaximum, msg);
+    if (count == 0) {
+        FC_THROWM(Base::RuntimeError, msg);  // NOLINT
+    }
+
+    std::vector<ElementMapPtr> childMaps;
+    childMaps.reserve(count - 1);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t mapID = 0;
+        uint64_t size = 0;
+        if (!(str >> mapID >> size)) {
+            FC_THROWM(Base::RuntimeError, msg);  // NOLINT
+        }
+        bool last = i + 1 == count;
+        auto it = _idToElementMap.find(mapID);
+        if (it != _idToElementMap.end() && it->second) {
+            stream.ignore(static_cast<std::streamsize>(size));
+            if (last) {
+                return it->second;
+            }
+            childMaps.push_back(it->second);
+            continue;
+        }
+        ElementMapPtr elementMap = last ? shared_from_this() : std::make_shared<ElementMap>();
+        elementMap->restoreBinary(hasherRef, stream, childMaps, postfixes);
+        if (!last) {
+            childMaps.push_back(elementMap);
+        }
+    }
+
+    return shared_from_this();
+}
+
+void ElementMap::restoreBinary(::App::StringHasherRef hasherRef,
+                               std::istream& stream,
+                               const std::vector<ElementMapPtr>& childMaps,
+                               const std::vector<std::string>& postfixes)
+{
+    constexpr uint32_t maxTypeCount(1000);
+    Base::InputStream str(stream);
+    uint32_t typeCount =
+        readCount(str, maxTypeCount, "Bad type count in element map, ignoring map");
+
+    const char* hasherIDWarn = nullptr;
+    const char* childSIDWarn = nullptr;
+    std::string tmp;
+
+    for (uint32_t i = 0; i < typeCount; ++i) {
+        readBytes(str, tmp);
+        if (tmp.empty()) {
+            FC_THROWM(Base::RuntimeError, "missing element type");  // NOLINT
+        }
+        IndexedName idx(tmp.c_str(), 1);
+
+        auto& indices = this->indexedNames[idx.getType()];
+        uint32_t childCount = readCount(str, maxBinaryCount, "missing element child count");
+        for (uint32_t j = 0; j < childCount; ++j) {
+            int32_t cIndex = 0;
+            int32_t offset = 0;
+            int32_t count = 0;
+            int64_t tag = 0;
+            int32_t mapIndex = 0;
+            if (!(str >> cIndex >> offset >> count >> tag >> mapIndex)) {
+                FC_THROWM(Base::RuntimeError, "Invalid element child");  // NOLINT
+            }
+            if (cIndex < 0) {
+                FC_THROWM(Base::RuntimeError, "Invalid element child index");  // NOLINT
+            }
+            if (offset < 0) {
+                FC_THROWM(Base::RuntimeError, "Invalid element child offset");  // NOLINT
+            }
+            if (mapIndex < 0 || mapIndex > (int)childMaps.size()) {
+                FC_THROWM(Base::RuntimeError, "Invalid element child map index");  // NOLINT
+            }
+            auto& child = indices.children[cIndex + offset + count];
+            child.indexedName = IndexedName::fromConst(idx.getType(), cIndex);
+            child.offset = offset;
+            child.count = count;
+            child.tag = static_cast<long>(tag);
+            if (mapIndex > 0) {
+                child.elementMap = childMaps[mapIndex - 1];
+            }
+            else {
+                child.elementMap = nullptr;
+            }
+            readBytes(str, tmp);
+            child.postfix = QByteArray(tmp.c_str(), static_cast<int>(tmp.size()));
+            this->childElements[child.postfix].childMap = &child;
+            this->childElementSize += child.count;
+            readStringIDs(str, hasherRef, child.sids, childSIDWarn);
+        }
+
+        uint32_t nameCount = readCount(str, maxBinaryCount, "missing element name count");
+        indices.names.resize(nameCount);
+        for (uint32_t j = 0; j < nameCount; ++j) {
+            idx.setIndex(static_cast<int>(j));
+            auto* ref = &indices.names[j];
+            uint32_t refCount = readCount(str, maxBinaryCount, "Failed to read element name");
+            for (uint32_t k = 0; k < refCount; ++k) {
+                if (k != 0) {
+                    ref->next = std::make_unique<MappedNameRef>();
+                    ref = ref->next.get();
+                }
+
+                uint8_t kind = 0;
+                if (!(str >> kind)) {
+                    FC_THROWM(Base::RuntimeError, "Failed to read element name");  // NOLINT
+                }
+                ::App::StringID::IndexID prefixID {};
+                prefixID.id = 0;
+                switch (static_cast<BinaryName>(kind)) {
+                    case BinaryName::Indexed: {
+                        uint32_t typeIndex = 0;
+                        int32_t elementIndex = 0;
+                        if (!(str >> typeIndex >> elementIndex) || typeIndex == 0
+                            || typeIndex > postfixes.size()) {
+                            FC_THROWM(Base::RuntimeError, "Invalid element name index");  // NOLINT
+                        }
+                        ref->name = MappedName(
+                            IndexedName::fromConst(postfixes[typeIndex - 1].c_str(), elementIndex));
+                        break;
+                    }
+                    case BinaryName::Hashed:
+                        readBytes(str, tmp);
+                        ref->name = MappedName(tmp.c_str(), static_cast<int>(tmp.size()));
+                        prefixID = ::App::StringID::fromString(ref->name.dataBytes());
+                        break;
+                    case BinaryName::Raw:
+                        readBytes(str, tmp);
+                        ref->name = MappedName(tmp.c_str(), static_cast<int>(tmp.size()));
+                        break;
+                    default:
+                        FC_THROWM(Base::RuntimeError, "Invalid element name marker");  // NOLINT
+                }
+
+                uint32_t postfixIndex = 0;
+                if (!(str >> postfixIndex) || postfixIndex > postfixes.size()) {
+                    FC_THROWM(Base::RuntimeError, "Invalid element postfix index");  // NOLINT
+                }
+                if (postfixIndex != 0) {
+                    ref->name += postfixes[postfixIndex - 1];
+                }
+
+                this->mappedNames.insert(ref->name, idx);
+
+                if (prefixID.id != 0 && hasherRef) {
+                    auto sid = hasherRef->getID(prefixID.id);
+                    if (!sid) {
+                        hasherIDWarn = "Missing element name prefix id";
+                    }
+                    else {
+                        ref->sids.push_back(sid);
+                    }
+                }
+                readStringIDs(str, hasherRef, ref->sids, hasherIDWarn);
+            }
+        }
+    }
+    if (hasherIDWarn) {
+        FC_WARN(hasherIDWarn);  // NOLINT
+    }
+    if (childSIDWarn) {
+        FC_WARN(childSIDWarn);  // NOLINT
+    }
+}
+
 MappedName ElementMap::addName(MappedName& name,
                                const IndexedName& idx,
                                const ElementIDRefs& sids,
@@ -514,25 +898,26 @@ MappedName ElementMap::addName(MappedName& name,
         if (overwrite) {
             erase(idx);
         }
-        auto ret = mappedNames.insert(std::make_pair(name, idx));
-        if (ret.second) {                // element just inserted did not exist yet in the map
-            ret.first->first.compact();  // FIXME see MappedName.cpp
-            mappedRef(idx).append(ret.first->first, sids);
+        auto ret = mappedNames.insert(name, idx);
+        if (ret.second) {               // element just inserted did not exist yet in the map
+            ret.first->name.compact();  // FIXME see MappedName.cpp
+            mappedRef(idx).append(ret.first->name, sids);
             FC_TRACE(idx << " -> " << name);  // NOLINT
-            return ret.first->first;
+            return ret.first->name;
         }
-        if (ret.first->second == idx) {
+        if (ret.first->index == idx) {
             FC_TRACE("duplicate " << idx << " -> " << name);  // NOLINT
-            return ret.first->first;
+            return ret.first->name;
         }
         if (!overwrite) {
             if (existing) {
-                *existing = ret.first->second;
+                *existing = ret.first->index;
             }
             return {};
         }
 
-        erase(ret.first->first);
+        MappedName duplicate = ret.first->name;
+        erase(duplicate);
     };
 }
 
@@ -782,16 +1167,16 @@ MappedName ElementMap::renameDuplicateElement(int index,
 
 void ElementMap::erase(const MappedName& name)
 {
-    auto it = this->mappedNames.find(name);
-    if (it == this->mappedNames.end()) {
+    const auto* entry = this->mappedNames.find(name);
+    if (!entry) {
         return;
     }
-    MappedNameRef* ref = findMappedRef(it->second);
+    MappedNameRef* ref = findMappedRef(entry->index);
     if (!ref) {
         return;
     }
     ref->erase(name);
-    this->mappedNames.erase(it);
+    this->mappedNames.erase(name);
 }
 
 void ElementMap::erase(const IndexedName& idx)
@@ -823,8 +1208,8 @@ bool ElementMap::empty() const
 
 IndexedName ElementMap::find(const MappedName& name, ElementIDRefs* sids) const
 {
-    auto nameIter = mappedNames.find(name);
-    if (nameIter == mappedNames.end()) {
+    const auto* entry = mappedNames.find(name);
+    if (!entry) {
         if (childElements.isEmpty()) {
             return IndexedName();
         }
@@ -861,7 +1246,7 @@ IndexedName ElementMap::find(const MappedName& name, ElementIDRefs* sids) const
     }
 
     if (sids) {
-        const MappedNameRef* ref = findMappedRef(nameIter->second);
+        const MappedNameRef* ref = findMappedRef(entry->index);
         for (; ref; ref = ref->next.get()) {
             if (ref->name == name) {
                 if (sids->empty()) {
@@ -874,7 +1259,7 @@ IndexedName ElementMap::find(const MappedName& name, ElementIDRefs* sids) const
             }
         }
     }
-    return nameIter->second;
+    return entry->index;
 }
 
 MappedName ElementMap::find(const IndexedName& idx, ElementIDRefs* sids) const
@@ -1016,6 +1401,43 @@ bool ElementMap::hasChildElementMap() const
     return !childElements.empty();
 }
 
+std::size_t ElementMap::getMemSize(std::set<const ElementMap*>& visited) const
+{
+    if (!visited.insert(this).second) {
+        return 0;
+    }
+
+    // Rough size of a node of std::map and QHash beside its value
+    constexpr std::size_t nodeSize = 4 * sizeof(void*);
+
+    // The names in indexedNames share their bytes with mappedNames
+    std::size_t size = sizeof(ElementMap) + mappedNames.getMemSize();
+    for (const auto& entry : mappedNames.entries()) {
+        size += entry.name.dataBytes().size() + entry.name.postfixBytes().size();
+    }
+    for (const auto& [type, elements] : indexedNames) {
+        size += nodeSize + sizeof(IndexedElements) + std::strlen(type);
+        for (const auto& ref : elements.names) {
+            size += sizeof(MappedNameRef) + ref.sids.size() * sizeof(App::StringIDRef);
+            for (auto next = ref.next.get(); next; next = next->next.get()) {
+                size += sizeof(MappedNameRef) + next->sids.size() * sizeof(App::StringIDRef);
+            }
+        }
+        for (const auto& child : elements.children) {
+            size += nodeSize + sizeof(child) + child.second.postfix.size()
+                + child.second.sids.size() * sizeof(App::StringIDRef);
+            if (child.second.elementMap) {
+                size += child.second.elementMap->getMemSize(visited);
+            }
+        }
+    }
+    for (auto it = childElements.begin(); it != childElements.end(); ++it) {
+        size += nodeSize + sizeof(QByteArray) + sizeof(ChildMapInfo) + it.key().size()
+            + it.value().mapIndices.size() * (nodeSize + sizeof(std::pair<ElementMap*, int>));
+    }
+    return size;
+}
+
 void ElementMap::hashChildMaps(long masterTag)
 {
     if (childElements.empty() || !this->hasher) {
@@ -1077,8 +1499,8 @@ void ElementMap::collectChildMaps(std::map<const ElementMap*, int>& childMapSet,
         }
     }
 
-    for (auto& mappedName : this->mappedNames) {
-        addPostfix(mappedName.first.constPostfix(), postfixMap, postfixes);
+    for (const auto* entry : this->mappedNames.sorted()) {
+        addPostfix(entry->name.constPostfix(), postfixMap, postfixes);
     }
 
     childMaps.push_back(this);
@@ -1304,8 +1726,8 @@ std::vector<MappedElement> ElementMap::getAll() const
 {
     std::vector<MappedElement> ret;
     ret.reserve(size());
-    for (auto& mappedName : this->mappedNames) {
-        ret.emplace_back(mappedName.first, mappedName.second);
+    for (const auto* entry : this->mappedNames.sorted()) {
+        ret.emplace_back(entry->name, entry->index);
     }
     for (auto& childElement : this->childElements) {
         auto& child = *childElement.childMap;
@@ -30,6 +30,7 @@
 
 #include "Application.h"
 #include "MappedElement.h"
+#include "MappedNameIndex.h"
 #include "StringHasher.h"
 
 #include <cstring>
@@ -37,6 +38,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <set>
 
 
 namespace Data
@@ -66,7 +68,8 @@ typedef std::function<bool(const MappedName&, int, long, long)> TraceCallback;
  * `indexedNames` maps a string to both a name queue and children.
  *   each of those children store an IndexedName, offset details, postfix, ids, and
  *   possibly a recursive elementmap
- * `mappedNames` maps a MappedName to a specific IndexedName.
+ * `mappedNames` maps a MappedName to a specific IndexedName. It is a flat hash index, so
+ *   code that depends on the order of names has to use `mappedNames.sorted()`.
  */
 class AppExport ElementMap
     : public std::enable_shared_from_this<ElementMap>  // TODO can remove shared_from_this?
@@ -101,6 +104,18 @@ public:
      */
     ElementMapPtr restore(::App::StringHasherRef hasherRef, std::istream& stream);
 
+    /** Serialize this map in binary form. The content is the same as written by \c save,
+     * but names, postfixes and string IDs are stored length-prefixed instead of as text.
+     * @param stream: serialized stream
+     */
+    void saveBinary(std::ostream& stream) const;
+
+    /** Deserialize and restore a map written by \c saveBinary.
+     * @param hasherRef: where all the StringIDs are stored
+     * @param stream: stream to deserialize
+     */
+    ElementMapPtr restoreBinary(::App::StringHasherRef hasherRef, std::istream& stream);
+
 
     /** Add a sub-element name mapping.
      *
@@ -168,6 +183,13 @@ public:
 
     bool hasChildElementMap() const;
 
+    /** Estimated memory used by this map and its child maps in bytes
+     *
+     * @param visited: maps that are already counted, they are skipped. This
+     * map and its child maps are added.
+     */
+    std::size_t getMemSize(std::set<const ElementMap*>& visited) const;
+
     /* Ensures that for each IndexedName mapped to IndexedElements, that
      *  each child is properly hashed (cached).
      *
@@ -233,6 +255,17 @@ private:
                           std::vector<ElementMapPtr>& childMaps,
                           const std::vector<std::string>& postfixes);
 
+    /// Binary counterpart of the private \c save
+    void saveBinary(std::ostream& stream,
+                    const std::map<const ElementMap*, int>& childMapSet,
+                    const std::map<QByteArray, int>& postfixMap) const;
+
+    /// Binary counterpart of the private \c restore
+    void restoreBinary(::App::StringHasherRef hasherRef,
+                       std::istream& stream,
+                       const std::vector<ElementMapPtr>& childMaps,
+                       const std::vector<std::string>& postfixes);
+
     /** Associate the MappedName \c name with the IndexedName \c idx.
      * @param name: the name to add
      * @param idx: the indexed name that \c name will be bound to
@@ -303,7 +336,7 @@ private:
 
     std::map<const char*, IndexedElements, CStringComp> indexedNames;
 
-    std::map<MappedName, IndexedName, std::less<>> mappedNames;
+    MappedNameIndex mappedNames;
 
     struct ChildMapInfo
     {
@@ -34,8 +34,10 @@
 #include <boost/math/special_functions/round.hpp>
 #include <boost/math/special_functions/trunc.hpp>
 
+#include <algorithm>
 #include <numbers>
 #include <limits>
+#include <mutex>
 #include <sstream>
 #include <stack>
 #include <string>
@@ -53,6 +55,7 @@
 #include <Base/VectorPy.h>
 
 #include "ExpressionParser.h"
+#include "ExpressionProgram.h"
 
 
 using namespace Base;
@@ -1092,10 +1095,47 @@ ExpressionPtr Expression::replaceObject(const DocumentObject *parent,
 }
 
 App::any Expression::getValueAsAny() const {
+    App::any value;
+    if (getNativeValue(value))
+        return value;
     Base::PyGILStateLocker lock;
     return pyObjectToAny(getPyValue());
 }
 
+const ExpressionProgram *Expression::getProgram() const {
+    // Recompute workers may evaluate the same expression at a time. Compiling
+    // is rare, so a single mutex serialises it for all expressions.
+    if (!programCompiled.load(std::memory_order_acquire)) {
+        static std::mutex compileMutex;
+        std::lock_guard<std::mutex> lock(compileMutex);
+        if (!programCompiled.load(std::memory_order_relaxed)) {
+            program = ExpressionProgram::compile(this);
+            programCompiled.store(true, std::memory_order_release);
+        }
+    }
+    return program.get();
+}
+
+bool Expression::getNativeValue(App::any &value) const {
+    auto prog = getProgram();
+    ExpressionProgram::Value result;
+    if (!prog || !prog->evaluate(result))
+        return false;
+    // same types as pyObjectToAny()
+    switch (result.type) {
+    case ExpressionProgram::Value::Type::Quantity:
+        value = result.quantity;
+        break;
+    case ExpressionProgram::Value::Type::Float:
+        value = result.quantity.getValue();
+        break;
+    default:
+        value = result.integer;
+        break;
+    }
+    return true;
+}
+
 Py::Object Expression::getPyValue() const {
     try {
         Py::Object pyobj = _getPyValue();
@@ -1113,6 +1153,8 @@ Py::Object Expression::getPyValue() const {
 void Expression::addComponent(Component *component) {
     assert(component);
     components.push_back(component);
+    program.reset();
+    programCompiled = false;
 }
 
 void Expression::visit(ExpressionVisitor &v) {
@@ -1122,7 +1164,27 @@ void Expression::visit(ExpressionVisitor &v) {
     v.visit(*this);
 }
 
+Expression* Expression::evalNative() const {
+    auto prog = getProgram();
+    ExpressionProgram::Value result;
+    if (!prog || !prog->evaluate(result))
+        return nullptr;
+    // same expressions as expressionFromPy()
+    switch (result.type) {
+    case ExpressionProgram::Value::Type::Bool:
+        if (result.integer)
+            return new ConstantExpression(owner,"True",Quantity(1.0));
+        return new ConstantExpression(owner,"False",Quantity(0.0));
+    case ExpressionProgram::Value::Type::Int:
+        return new NumberExpression(owner,Quantity(static_cast<double>(result.integer)));
+    default:
+        return new NumberExpression(owner,result.quantity);
+    }
+}
+
 Expression* Expression::eval() const {
+    if (auto res = evalNative())
+        return res;
     Base::PyGILStateLocker lock;
     return expressionFromPy(owner,getPyValue());
 }
@@ -2135,8 +2197,6 @@ Base::Vector3d FunctionExpression::extractVectorArgument(
 
 Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std::vector<Expression*> &args)
 {
-    using std::numbers::pi;
-
     if(!expr || !expr->getOwner())
         _EXPR_THROW("Invalid owner.", expr);
 
@@ -2394,6 +2454,42 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         v3 = pyToQuantity(e3,expr,"Invalid third argument.");
     }
 
+    switch (f) {
+    case ROTATIONX:
+    case ROTATIONY:
+    case ROTATIONZ:
+        if (!(v1.isDimensionlessOrUnit(Unit::Angle)))
+            _EXPR_THROW("Unit must be either empty or an angle.", expr);
+        return Py::asObject(new Base::RotationPy(Base::Rotation(
+            Vector3d(static_cast<double>(f == ROTATIONX), static_cast<double>(f == ROTATIONY), static_cast<double>(f == ROTATIONZ)),
+            Base::toRadians(v1.getValue()))));
+    case TRANSLATIONM:
+        if (v1.isDimensionlessOrUnit(Unit::Length) && v2.isDimensionlessOrUnit(Unit::Length) && v3.isDimensionlessOrUnit(Unit::Length))
+            return translationMatrix(v1.getValue(), v2.getValue(), v3.getValue());
+        _EXPR_THROW("Translation units must be a length or dimensionless.", expr);
+    default:
+        break;
+    }
+
+    const Quantity values[] = {v1, v2, v3};
+    return Py::asObject(new QuantityPy(new Quantity(
+        evaluateScalar(expr, f, values, std::min<std::size_t>(args.size(), 3)))));
+}
+
+bool FunctionExpression::isScalarFunction(int type)
+{
+    return type >= ABS && type <= TRUNC;
+}
+
+Quantity FunctionExpression::evaluateScalar(const Expression *expr, int f,
+                                            const Quantity *values, std::size_t count)
+{
+    using std::numbers::pi;
+
+    const Quantity &v1 = values[0];
+    const Quantity &v2 = count > 1 ? values[1] : Quantity();
+    const Quantity &v3 = count > 2 ? values[2] : Quantity();
+
     double output;
     Unit unit;
     double scaler = 1;
@@ -2405,9 +2501,6 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
     case COS:
     case SIN:
     case TAN:
-    case ROTATIONX:
-    case ROTATIONY:
-    case ROTATIONZ:
         if (!(v1.isDimensionlessOrUnit(Unit::Angle)))
             _EXPR_THROW("Unit must be either empty or an angle.", expr);
 
@@ -2447,7 +2540,7 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         unit = v1.getUnit().cbrt();
         break;
     case ATAN2:
-        if (e2.isNone())
+        if (count < 2)
             _EXPR_THROW("Invalid second argument.",expr);
 
         if (v1.getUnit() != v2.getUnit())
@@ -2456,14 +2549,14 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         scaler = 180.0 / pi;
         break;
     case MOD:
-        if (e2.isNone())
+        if (count < 2)
             _EXPR_THROW("Invalid second argument.",expr);
         if (v1.getUnit() != v2.getUnit() && !v1.isDimensionless() && !v2.isDimensionless())
             _EXPR_THROW("Units must be equal or dimensionless.",expr);
         unit = v1.getUnit();
         break;
     case POW: {
-        if (e2.isNone())
+        if (count < 2)
             _EXPR_THROW("Invalid second argument.",expr);
 
         if (!v2.isDimensionless())
@@ -2481,23 +2574,15 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
     }
     case HYPOT:
     case CATH:
-        if (e2.isNone())
+        if (count < 2)
             _EXPR_THROW("Invalid second argument.",expr);
         if (v1.getUnit() != v2.getUnit())
             _EXPR_THROW("Units must be equal.",expr);
 
-        if (args.size() > 2) {
-            if (e3.isNone())
-                _EXPR_THROW("Invalid second argument.",expr);
-            if (v2.getUnit() != v3.getUnit())
-                _EXPR_THROW("Units must be equal.",expr);
-        }
+        if (count > 2 && v2.getUnit() != v3.getUnit())
+            _EXPR_THROW("Units must be equal.",expr);
         unit = v1.getUnit();
         break;
-    case TRANSLATIONM:
-        if (v1.isDimensionlessOrUnit(Unit::Length) && v2.isDimensionlessOrUnit(Unit::Length) && v3.isDimensionlessOrUnit(Unit::Length))
-            break;
-        _EXPR_THROW("Translation units must be a length or dimensionless.", expr);
     default:
         _EXPR_THROW("Unknown function: " << f,0);
     }
@@ -2562,11 +2647,11 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
         break;
     }
     case HYPOT: {
-        output = sqrt(pow(v1.getValue(), 2) + pow(v2.getValue(), 2) + (!e3.isNone() ? pow(v3.getValue(), 2) : 0));
+        output = sqrt(pow(v1.getValue(), 2) + pow(v2.getValue(), 2) + (count > 2 ? pow(v3.getValue(), 2) : 0));
         break;
     }
     case CATH: {
-        output = sqrt(pow(v1.getValue(), 2) - pow(v2.getValue(), 2) - (!e3.isNone() ? pow(v3.getValue(), 2) : 0));
+        output = sqrt(pow(v1.getValue(), 2) - pow(v2.getValue(), 2) - (count > 2 ? pow(v3.getValue(), 2) : 0));
         break;
     }
     case ROUND:
@@ -2581,19 +2666,11 @@ Py::Object FunctionExpression::evaluate(const Expression *expr, int f, const std
     case FLOOR:
         output = floor(value);
         break;
-    case ROTATIONX:
-    case ROTATIONY:
-    case ROTATIONZ:
-        return Py::asObject(new Base::RotationPy(Base::Rotation(
-            Vector3d(static_cast<double>(f == ROTATIONX), static_cast<double>(f == ROTATIONY), static_cast<double>(f == ROTATIONZ)),
-            value)));
-    case TRANSLATIONM:
-        return translationMatrix(v1.getValue(), v2.getValue(), v3.getValue());
     default:
         _EXPR_THROW("Unknown function: " << f,0);
     }
 
-    return Py::asObject(new QuantityPy(new Quantity(scaler * output, unit)));
+    return Quantity(scaler * output, unit);
 }
 
 Py::Object FunctionExpression::_getPyValue() const {
@@ -23,6 +23,7 @@
 #ifndef EXPRESSION_H
 #define EXPRESSION_H
 
+#include <atomic>
 #include <deque>
 #include <set>
 #include <string>
@@ -43,6 +44,7 @@ namespace App  {
 
 class DocumentObject;
 class Expression;
+class ExpressionProgram;
 class Document;
 
 using ExpressionPtr = std::unique_ptr<Expression>;
@@ -186,6 +188,35 @@ public:
 
     boost::any getValueAsAny() const;
 
+    /** Evaluates the expression without Python
+     *
+     * Only plain arithmetic on numbers, quantities and numeric properties is
+     * supported, see ExpressionProgram.
+     *
+     * @param value: receives the same value as getValueAsAny() on success
+     * @return false if the expression must be evaluated with Python
+     */
+    bool getNativeValue(App::any& value) const;
+
+    /** Evaluates the expression like eval(), but without Python
+     *
+     * Does not lock the GIL, so it can be called on a worker thread.
+     *
+     * @return the result, or nullptr if the expression must be evaluated with Python
+     */
+    Expression* evalNative() const;
+
+    /** Checks whether getNativeValue() and evalNative() support the expression
+     *
+     * The expression is compiled on first call. Evaluation may still fail, e.g.
+     * on a unit mismatch. Compiling is safe if several threads evaluate the
+     * same expression. The expression must not be modified meanwhile, e.g. by
+     * addComponent(), which drops the compiled form.
+     */
+    bool isNative() const {
+        return getProgram() != nullptr;
+    }
+
     Py::Object getPyValue() const;
 
     bool isSame(const Expression &other, bool checkComment=true) const;
@@ -222,6 +253,12 @@ protected:
 
     ComponentList components;
 
+private:
+    const ExpressionProgram* getProgram() const;
+
+    mutable std::unique_ptr<ExpressionProgram> program; /**< Compiled form for getNativeValue() */
+    mutable std::atomic<bool> programCompiled{false}; /**< Set once program is written */
+
 public:
     std::string comment;
     // clang-format on
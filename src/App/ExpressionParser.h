@@ -270,6 +270,21 @@ public:
 
     int priority() const override;
 
+    Expression* getCondition() const
+    {
+        return condition;
+    }
+
+    Expression* getTrueExpr() const
+    {
+        return trueExpr;
+    }
+
+    Expression* getFalseExpr() const
+    {
+        return falseExpr;
+    }
+
 protected:
     Expression* _copy() const override;
     void _visit(ExpressionVisitor& v) override;
@@ -393,6 +408,23 @@ public:
     static Py::Object
     evaluate(const Expression* owner, int type, const std::vector<Expression*>& args);
 
+    /// Returns true for the math functions taking and returning quantities only
+    static bool isScalarFunction(int type);
+
+    /** Evaluates a scalar math function
+     *
+     * @param owner: the expression used in error messages
+     * @param type: the function, see isScalarFunction()
+     * @param values: the arguments
+     * @param count: the number of arguments, at least one
+     *
+     * Throws the same errors as evaluate() for invalid arguments.
+     */
+    static Base::Quantity evaluateScalar(const Expression* owner,
+                                         int type,
+                                         const Base::Quantity* values,
+                                         std::size_t count);
+
     Function getFunction() const
     {
         return f;
@@ -466,6 +498,12 @@ public:
 
     const App::Property* getProperty() const;
 
+    /// Returns the referenced property if the path refers to it as a whole
+    const App::Property* getWholeProperty() const
+    {
+        return var.getWholeProperty();
+    }
+
     void addComponent(Component* component) override;
 
 protected:
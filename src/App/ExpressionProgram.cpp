@@ -0,0 +1,721 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#endif
+
+#include "ExpressionProgram.h"
+#include "ExpressionParser.h"
+#include "PropertyStandard.h"
+#include "PropertyUnits.h"
+
+
+using namespace App;
+using Base::Quantity;
+using Value = ExpressionProgram::Value;
+
+namespace
+{
+
+// Integers of larger magnitude are not exactly representable as double
+constexpr double maxExactInteger = 9007199254740992.0;
+
+Value makeInteger(long value, Value::Type type = Value::Type::Int)
+{
+    Value res;
+    res.type = type;
+    res.integer = value;
+    return res;
+}
+
+Value makeFloat(double value)
+{
+    Value res;
+    res.type = Value::Type::Float;
+    res.quantity = Quantity(value);
+    return res;
+}
+
+Value makeQuantity(const Quantity& value)
+{
+    Value res;
+    res.type = Value::Type::Quantity;
+    res.quantity = value;
+    return res;
+}
+
+bool isExact(const Value& value)
+{
+    return !value.isInteger() || std::fabs(static_cast<double>(value.integer)) <= maxExactInteger;
+}
+
+bool isTrue(const Value& value)
+{
+    if (value.isInteger()) {
+        return value.integer != 0;
+    }
+    return value.quantity.getValue() != 0.0;
+}
+
+// Same conversion as pyFromQuantity() in Expression.cpp
+bool literalValue(const Quantity& quantity, Value& res)
+{
+    if (!quantity.getUnit().isEmpty()) {
+        res = makeQuantity(quantity);
+        return true;
+    }
+    double value = quantity.getValue();
+    double intpart {};
+    if (std::modf(value, &intpart) == 0.0) {
+        if (intpart < 0.0) {
+            if (intpart >= static_cast<double>(std::numeric_limits<long>::min())) {
+                res = makeInteger(static_cast<long>(intpart));
+                return true;
+            }
+        }
+        else if (intpart <= std::numeric_limits<int>::max()) {
+            res = makeInteger(static_cast<long>(intpart));
+            return true;
+        }
+        else if (intpart <= static_cast<double>(std::numeric_limits<long>::max())) {
+            // pyFromQuantity() truncates these, leave them to Python
+            return false;
+        }
+    }
+    res = makeFloat(value);
+    return true;
+}
+
+// Same value as Property::getPyObject() of the numeric properties
+bool propertyValue(const Property* prop, Value& res)
+{
+    if (!prop) {
+        return false;
+    }
+    if (auto quantity = freecad_cast<const PropertyQuantity*>(prop)) {
+        res = makeQuantity(Quantity(quantity->getValue(), quantity->getUnit()));
+    }
+    else if (auto number = freecad_cast<const PropertyFloat*>(prop)) {
+        res = makeFloat(number->getValue());
+    }
+    else if (auto integer = freecad_cast<const PropertyInteger*>(prop)) {
+        res = makeInteger(integer->getValue());
+    }
+    else if (auto boolean = freecad_cast<const PropertyBool*>(prop)) {
+        res = makeInteger(boolean->getValue() ? 1 : 0, Value::Type::Bool);
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+bool addInteger(long a, long b, long& res)
+{
+    if ((b > 0 && a > std::numeric_limits<long>::max() - b)
+        || (b < 0 && a < std::numeric_limits<long>::min() - b)) {
+        return false;
+    }
+    res = a + b;
+    return true;
+}
+
+bool subtractInteger(long a, long b, long& res)
+{
+    if ((b < 0 && a > std::numeric_limits<long>::max() + b)
+        || (b > 0 && a < std::numeric_limits<long>::min() + b)) {
+        return false;
+    }
+    res = a - b;
+    return true;
+}
+
+bool multiplyInteger(long a, long b, long& res)
+{
+    constexpr long max = std::numeric_limits<long>::max();
+    constexpr long min = std::numeric_limits<long>::min();
+    if (a > 0) {
+        if ((b > 0 && a > max / b) || (b <= 0 && b < min / a)) {
+            return false;
+        }
+    }
+    else if (a < 0) {
+        if ((b > 0 && a < min / b) || (b < 0 && b < max / a)) {
+            return false;
+        }
+    }
+    res = a * b;
+    return true;
+}
+
+bool powerInteger(long base, long exponent, long& res)
+{
+    long result = 1;
+    while (exponent > 0) {
+        if ((exponent & 1) != 0 && !multiplyInteger(result, base, result)) {
+            return false;
+        }
+        exponent >>= 1;
+        if (exponent > 0 && !multiplyInteger(base, base, base)) {
+            return false;
+        }
+    }
+    res = result;
+    return true;
+}
+
+// Python float remainder, the result has the sign of the divisor
+bool remainderFloat(double a, double b, double& res)
+{
+    if (b == 0.0) {
+        return false;
+    }
+    double mod = std::fmod(a, b);
+    if (mod != 0.0) {
+        if ((b < 0.0) != (mod < 0.0)) {
+            mod += b;
+        }
+    }
+    else {
+        mod = std::copysign(0.0, b);
+    }
+    res = mod;
+    return true;
+}
+
+// Python float power, fails where Python raises or returns a complex number
+bool powerFloat(double a, double b, double& res)
+{
+    if (b == 0.0) {
+        res = 1.0;
+        return true;
+    }
+    if (a == 0.0 && b < 0.0) {
+        return false;
+    }
+    if (a < 0.0 && std::isfinite(b) && b != std::floor(b)) {
+        return false;
+    }
+    res = std::pow(a, b);
+    return !std::isinf(res) || !std::isfinite(a) || !std::isfinite(b);
+}
+
+bool unaryOperator(int op, Value& value)
+{
+    switch (op) {
+        case OperatorExpression::NEG:
+            if (value.isQuantity()) {
+                value.quantity = value.quantity * -1.0;
+            }
+            else if (value.isInteger()) {
+                if (value.integer == std::numeric_limits<long>::min()) {
+                    return false;
+                }
+                value = makeInteger(-value.integer);
+            }
+            else {
+                value.quantity = Quantity(-value.quantity.getValue());
+            }
+            return true;
+        case OperatorExpression::POS:
+            if (value.isInteger()) {
+                value.type = Value::Type::Int;
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool compare(int op, const Value& left, const Value& right, bool& res)
+{
+    if (left.isQuantity() && right.isQuantity()) {
+        const Quantity& a = left.quantity;
+        const Quantity& b = right.quantity;
+        switch (op) {
+            case OperatorExpression::EQ:
+                res = a == b;
+                return true;
+            case OperatorExpression::NEQ:
+                res = !(a == b);
+                return true;
+            case OperatorExpression::LT:
+                res = a < b;
+                return true;
+            case OperatorExpression::LTE:
+                res = a < b || a == b;
+                return true;
+            case OperatorExpression::GT:
+                res = !(a < b) && !(a == b);
+                return true;
+            case OperatorExpression::GTE:
+                res = !(a < b);
+                return true;
+            default:
+                return false;
+        }
+    }
+    if (left.isInteger() && right.isInteger()) {
+        long a = left.integer;
+        long b = right.integer;
+        switch (op) {
+            case OperatorExpression::EQ:
+                res = a == b;
+                return true;
+            case OperatorExpression::NEQ:
+                res = a != b;
+                return true;
+            case OperatorExpression::LT:
+                res = a < b;
+                return true;
+            case OperatorExpression::LTE:
+                res = a <= b;
+                return true;
+            case OperatorExpression::GT:
+                res = a > b;
+                return true;
+            case OperatorExpression::GTE:
+                res = a >= b;
+                return true;
+            default:
+                return false;
+        }
+    }
+    // Python compares int and float exactly, quantities against numbers by value
+    if (!left.isQuantity() && !right.isQuantity() && (!isExact(left) || !isExact(right))) {
+        return false;
+    }
+    double a = left.toDouble();
+    double b = right.toDouble();
+    switch (op) {
+        case OperatorExpression::EQ:
+            res = a == b;
+            return true;
+        case OperatorExpression::NEQ:
+            res = a != b;
+            return true;
+        case OperatorExpression::LT:
+            res = a < b;
+            return true;
+        case OperatorExpression::LTE:
+            res = a <= b;
+            return true;
+        case OperatorExpression::GT:
+            res = a > b;
+            return true;
+        case OperatorExpression::GTE:
+            res = a >= b;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Arithmetic of Base::QuantityPy
+bool quantityOperator(int op, Value& left, const Value& right)
+{
+    switch (op) {
+        case OperatorExpression::ADD:
+            left = makeQuantity(left.toQuantity() + right.toQuantity());
+            return true;
+        case OperatorExpression::SUB:
+            left = makeQuantity(left.toQuantity() - right.toQuantity());
+            return true;
+        case OperatorExpression::MUL:
+        case OperatorExpression::UNIT:
+            left = makeQuantity(left.toQuantity() * right.toQuantity());
+            return true;
+        case OperatorExpression::DIV:
+            left = makeQuantity(left.toQuantity() / right.toQuantity());
+            return true;
+        case OperatorExpression::MOD: {
+            double mod {};
+            if (!left.isQuantity()
+                || !remainderFloat(left.quantity.getValue(), right.toDouble(), mod)) {
+                return false;
+            }
+            left.quantity = Quantity(mod, left.quantity.getUnit());
+            return true;
+        }
+        case OperatorExpression::POW:
+            if (!left.isQuantity()) {
+                return false;
+            }
+            if (right.isQuantity()) {
+                left.quantity = left.quantity.pow(right.quantity);
+            }
+            else {
+                left.quantity = left.quantity.pow(right.toDouble());
+            }
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Arithmetic of Python int
+bool integerOperator(int op, Value& left, const Value& right)
+{
+    long a = left.integer;
+    long b = right.integer;
+    long res {};
+    switch (op) {
+        case OperatorExpression::ADD:
+            if (!addInteger(a, b, res)) {
+                return false;
+            }
+            break;
+        case OperatorExpression::SUB:
+            if (!subtractInteger(a, b, res)) {
+                return false;
+            }
+            break;
+        case OperatorExpression::MUL:
+        case OperatorExpression::UNIT:
+            if (!multiplyInteger(a, b, res)) {
+                return false;
+            }
+            break;
+        case OperatorExpression::DIV:
+            if (b == 0 || !isExact(left) || !isExact(right)) {
+                return false;
+            }
+            left = makeFloat(static_cast<double>(a) / static_cast<double>(b));
+            return true;
+        case OperatorExpression::MOD:
+            if (b == 0 || (b == -1 && a == std::numeric_limits<long>::min())) {
+                return false;
+            }
+            res = a % b;
+            if (res != 0 && ((res < 0) != (b < 0))) {
+                res += b;
+            }
+            break;
+        case OperatorExpression::POW:
+            if (b < 0) {
+                double value {};
+                if (!powerFloat(static_cast<double>(a), static_cast<double>(b), value)) {
+                    return false;
+                }
+                left = makeFloat(value);
+                return true;
+            }
+            if (!powerInteger(a, b, res)) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    left = makeInteger(res);
+    return true;
+}
+
+// Arithmetic of Python float
+bool floatOperator(int op, Value& left, const Value& right)
+{
+    double a = left.toDouble();
+    double b = right.toDouble();
+    double res {};
+    switch (op) {
+        case OperatorExpression::ADD:
+            res = a + b;
+            break;
+        case OperatorExpression::SUB:
+            res = a - b;
+            break;
+        case OperatorExpression::MUL:
+        case OperatorExpression::UNIT:
+            res = a * b;
+            break;
+        case OperatorExpression::DIV:
+            if (b == 0.0) {
+                return false;
+            }
+            res = a / b;
+            break;
+        case OperatorExpression::MOD:
+            if (!remainderFloat(a, b, res)) {
+                return false;
+            }
+            break;
+        case OperatorExpression::POW:
+            if (!powerFloat(a, b, res)) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+    }
+    left = makeFloat(res);
+    return true;
+}
+
+bool binaryOperator(int op, Value& left, const Value& right)
+{
+    switch (op) {
+        case OperatorExpression::EQ:
+        case OperatorExpression::NEQ:
+        case OperatorExpression::LT:
+        case OperatorExpression::LTE:
+        case OperatorExpression::GT:
+        case OperatorExpression::GTE: {
+            bool res {};
+            if (!compare(op, left, right, res)) {
+                return false;
+            }
+            left = makeInteger(res ? 1 : 0, Value::Type::Bool);
+            return true;
+        }
+        default:
+            break;
+    }
+    if (left.isQuantity() || right.isQuantity()) {
+        return quantityOperator(op, left, right);
+    }
+    if (left.isInteger() && right.isInteger()) {
+        return integerOperator(op, left, right);
+    }
+    return floatOperator(op, left, right);
+}
+
+}  // namespace
+
+double Value::toDouble() const
+{
+    if (isInteger()) {
+        return static_cast<double>(integer);
+    }
+    return quantity.getValue();
+}
+
+Quantity Value::toQuantity() const
+{
+    if (isInteger()) {
+        return Quantity(static_cast<double>(integer));
+    }
+    return quantity;
+}
+
+std::unique_ptr<ExpressionProgram> ExpressionProgram::compile(const Expression* expr)
+{
+    std::unique_ptr<ExpressionProgram> program(new ExpressionProgram);
+    if (!program->compileNode(expr, 0)) {
+        return {};
+    }
+    return program;
+}
+
+std::size_t ExpressionProgram::emit(OpCode opcode, const Expression* expr, int arg, int count)
+{
+    code.push_back({opcode, arg, count, expr});
+    return code.size() - 1;
+}
+
+bool ExpressionProgram::compileNode(const Expression* expr, std::size_t depth)
+{
+    if (!expr || expr->hasComponent()) {
+        return false;
+    }
+    stackSize = std::max(stackSize, depth + 1);
+
+    Base::Type type = expr->getTypeId();
+    if (type == OperatorExpression::getClassTypeId()) {
+        auto opExpr = static_cast<const OperatorExpression*>(expr);
+        int op = opExpr->getOperator();
+        switch (op) {
+            case OperatorExpression::NEG:
+            case OperatorExpression::POS:
+                if (!compileNode(opExpr->getLeft(), depth)) {
+                    return false;
+                }
+                emit(OpCode::Unary, expr, op);
+                return true;
+            case OperatorExpression::NONE:
+                return false;
+            default:
+                if (!compileNode(opExpr->getLeft(), depth)
+                    || !compileNode(opExpr->getRight(), depth + 1)) {
+                    return false;
+                }
+                emit(OpCode::Binary, expr, op);
+                return true;
+        }
+    }
+    if (type == ConditionalExpression::getClassTypeId()) {
+        auto condExpr = static_cast<const ConditionalExpression*>(expr);
+        if (!compileNode(condExpr->getCondition(), depth)) {
+            return false;
+        }
+        std::size_t jumpIfFalse = emit(OpCode::JumpIfFalse, expr);
+        if (!compileNode(condExpr->getTrueExpr(), depth)) {
+            return false;
+        }
+        std::size_t jump = emit(OpCode::Jump, expr);
+        code[jumpIfFalse].arg = static_cast<int>(code.size());
+        if (!compileNode(condExpr->getFalseExpr(), depth)) {
+            return false;
+        }
+        code[jump].arg = static_cast<int>(code.size());
+        return true;
+    }
+    if (type == FunctionExpression::getClassTypeId()) {
+        auto funcExpr = static_cast<const FunctionExpression*>(expr);
+        const auto& args = funcExpr->getArgs();
+        int func = funcExpr->getFunction();
+        // FunctionExpression::evaluate() refuses to work without owner
+        if (!expr->getOwner() || args.empty()) {
+            return false;
+        }
+        if (func == FunctionExpression::HIDDENREF || func == FunctionExpression::HREF) {
+            return compileNode(args[0], depth);
+        }
+        if (!FunctionExpression::isScalarFunction(func) || args.size() > 3) {
+            return false;
+        }
+        for (std::size_t i = 0; i < args.size(); ++i) {
+            if (!compileNode(args[i], depth + i)) {
+                return false;
+            }
+        }
+        emit(OpCode::Function, expr, func, static_cast<int>(args.size()));
+        return true;
+    }
+    if (type == VariableExpression::getClassTypeId()) {
+        emit(OpCode::Variable, expr);
+        return true;
+    }
+    if (type == ConstantExpression::getClassTypeId()) {
+        auto constExpr = static_cast<const ConstantExpression*>(expr);
+        if (constExpr->isNumber()) {
+            emit(OpCode::Literal, expr);
+            return true;
+        }
+        std::string name = constExpr->getName();
+        if (name == "True" || name == "False") {
+            emit(OpCode::Constant, expr, name == "True" ? 1 : 0);
+            return true;
+        }
+        return false;
+    }
+    if (type == NumberExpression::getClassTypeId() || type == UnitExpression::getClassTypeId()) {
+        emit(OpCode::Literal, expr);
+        return true;
+    }
+    return false;
+}
+
+bool ExpressionProgram::evaluate(Value& result) const
+{
+    if (needsPython.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    try {
+        return run(result);
+    }
+    catch (Base::Exception&) {
+        return false;
+    }
+    catch (std::exception&) {
+        return false;
+    }
+}
+
+bool ExpressionProgram::run(Value& result) const
+{
+    std::vector<Value> stack;
+    stack.reserve(stackSize);
+
+    std::size_t pc = 0;
+    while (pc < code.size()) {
+        const Instruction& instruction = code[pc++];
+        switch (instruction.opcode) {
+            case OpCode::Literal: {
+                Value value;
+                auto unitExpr = static_cast<const UnitExpression*>(instruction.expr);
+                if (!literalValue(unitExpr->getQuantity(), value)) {
+                    return false;
+                }
+                stack.push_back(std::move(value));
+                break;
+            }
+            case OpCode::Constant:
+                stack.push_back(makeInteger(instruction.arg, Value::Type::Bool));
+                break;
+            case OpCode::Variable: {
+                Value value;
+                auto varExpr = static_cast<const VariableExpression*>(instruction.expr);
+                if (!propertyValue(varExpr->getWholeProperty(), value)) {
+                    // Not a plain numeric property, no need to try again
+                    needsPython.store(true, std::memory_order_relaxed);
+                    return false;
+                }
+                stack.push_back(std::move(value));
+                break;
+            }
+            case OpCode::Unary:
+                if (!unaryOperator(instruction.arg, stack.back())) {
+                    return false;
+                }
+                break;
+            case OpCode::Binary: {
+                Value right = std::move(stack.back());
+                stack.pop_back();
+                if (!binaryOperator(instruction.arg, stack.back(), right)) {
+                    return false;
+                }
+                break;
+            }
+            case OpCode::Function: {
+                std::array<Quantity, 3> values;
+                std::size_t first = stack.size() - instruction.count;
+                for (int i = 0; i < instruction.count; ++i) {
+                    values[i] = stack[first + i].toQuantity();
+                }
+                stack.resize(first);
+                stack.push_back(makeQuantity(FunctionExpression::evaluateScalar(instruction.expr,
+                                                                                instruction.arg,
+                                                                                values.data(),
+                                                                                instruction.count)));
+                break;
+            }
+            case OpCode::JumpIfFalse: {
+                bool condition = isTrue(stack.back());
+                stack.pop_back();
+                if (!condition) {
+                    pc = instruction.arg;
+                }
+                break;
+            }
+            case OpCode::Jump:
+                pc = instruction.arg;
+                break;
+        }
+    }
+    result = std::move(stack.back());
+    return true;
+}
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef APP_EXPRESSIONPROGRAM_H
+#define APP_EXPRESSIONPROGRAM_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <Base/Quantity.h>
+#include <FCGlobal.h>
+
+namespace App
+{
+
+class Expression;
+
+/** Compiled form of an expression that is evaluated without Python
+ *
+ * Numbers, units, the arithmetic and comparison operators, conditionals, the
+ * scalar math functions and references to numeric properties are compiled
+ * into a flat instruction stream working on Base::Quantity values. The
+ * evaluation follows the Python semantics of Expression::getPyValue(), so
+ * integer, float, boolean and quantity results keep their type.
+ *
+ * compile() rejects anything else. Evaluation errors, e.g. a unit mismatch or
+ * a division by zero, make evaluate() fail and the caller falls back to
+ * Python, which then reports the error.
+ *
+ * The instructions point to the nodes of the compiled expression, literals and
+ * property references are read from them on each evaluation.
+ */
+class AppExport ExpressionProgram
+{
+public:
+    /// Value on the evaluation stack, mirrors the Python types int, float, bool and Quantity
+    struct Value
+    {
+        enum class Type : unsigned char
+        {
+            Int,
+            Float,
+            Bool,
+            Quantity
+        };
+        Type type {Type::Int};
+        /// Value of Int and Bool
+        long integer {0};
+        /// Value of Float and Quantity, Float has no unit
+        Base::Quantity quantity;
+
+        bool isQuantity() const
+        {
+            return type == Type::Quantity;
+        }
+        bool isInteger() const
+        {
+            return type == Type::Int || type == Type::Bool;
+        }
+        double toDouble() const;
+        Base::Quantity toQuantity() const;
+    };
+
+    /// Compiles \a expr, returns nullptr if it must be evaluated with Python
+    static std::unique_ptr<ExpressionProgram> compile(const Expression* expr);
+
+    /// Evaluates the program, returns false if Python must be used instead
+    bool evaluate(Value& result) const;
+
+    /// Returns the number of instructions
+    std::size_t size() const
+    {
+        return code.size();
+    }
+
+private:
+    enum class OpCode : unsigned char
+    {
+        Literal,
+        Constant,
+        Variable,
+        Unary,
+        Binary,
+        Function,
+        JumpIfFalse,
+        Jump
+    };
+
+    struct Instruction
+    {
+        OpCode opcode;
+        /// Operator, function, constant value or jump target
+        int arg;
+        /// Argument count of functions
+        int count;
+        const Expression* expr;
+    };
+
+    bool compileNode(const Expression* expr, std::size_t depth);
+    std::size_t emit(OpCode opcode, const Expression* expr, int arg = 0, int count = 0);
+    bool run(Value& result) const;
+
+    std::vector<Instruction> code;
+    std::size_t stackSize {0};
+    /// Set once a property reference could not be read natively
+    mutable std::atomic<bool> needsPython {false};
+};
+
+}  // namespace App
+
+#endif  // APP_EXPRESSIONPROGRAM_H
@@ -27,6 +27,12 @@
 #include <sstream>
 #endif
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/Interpreter.h>
@@ -371,3 +377,65 @@ DocumentObjectExecReturn* FeatureTestAttribute::execute()
     }
     return StdReturn;
 }
+
+// ----------------------------------------------------------------------------
+
+PROPERTY_SOURCE(App::FeatureTestConcurrent, App::DocumentObject)
+
+namespace
+{
+std::mutex runningMutex;
+std::condition_variable runningCond;
+int running = 0;
+int maxRunning = 0;
+}  // namespace
+
+FeatureTestConcurrent::FeatureTestConcurrent()
+{
+    ADD_PROPERTY_TYPE(Sources, (nullptr), "Test", Prop_None, "");
+    ADD_PROPERTY_TYPE(WaitFor, (0L), "Test", Prop_None, "");
+    ADD_PROPERTY_TYPE(Delay, (0L), "Test", Prop_None, "");
+    ADD_PROPERTY_TYPE(Abort, (false), "Test", Prop_None, "");
+    ADD_PROPERTY_TYPE(Result, (0L), "Test", Prop_Output, "");
+}
+
+DocumentObjectExecReturn* FeatureTestConcurrent::execute()
+{
+    {
+        std::unique_lock<std::mutex> lock(runningMutex);
+        maxRunning = std::max(maxRunning, ++running);
+        runningCond.notify_all();
+        runningCond.wait_for(lock, std::chrono::seconds(1), [this]() {
+            return running >= WaitFor.getValue();
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(Delay.getValue()));
+    {
+        std::lock_guard<std::mutex> lock(runningMutex);
+        --running;
+    }
+    if (Abort.getValue()) {
+        throw Base::AbortException("FeatureTestConcurrent::execute(): aborted");
+    }
+
+    long result = 1;
+    for (auto obj : Sources.getValues()) {
+        if (auto feature = freecad_cast<FeatureTestConcurrent*>(obj)) {
+            result += feature->Result.getValue();
+        }
+    }
+    Result.setValue(result);
+    return StdReturn;
+}
+
+int FeatureTestConcurrent::getMaxRunning()
+{
+    std::lock_guard<std::mutex> lock(runningMutex);
+    return maxRunning;
+}
+
+void FeatureTestConcurrent::resetRunning()
+{
+    std::lock_guard<std::mutex> lock(runningMutex);
+    maxRunning = running;
+}
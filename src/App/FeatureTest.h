@@ -218,6 +218,38 @@ public:
     App::PropertyString Attribute;
 };
 
+/** The concurrent recompute testing feature
+ *
+ * Opts in to concurrent execution. execute() sets Result to one plus the sum
+ * of the results of its sources.
+ */
+class FeatureTestConcurrent: public DocumentObject
+{
+    PROPERTY_HEADER_WITH_OVERRIDE(App::FeatureTestConcurrent);
+
+public:
+    FeatureTestConcurrent();
+
+    App::PropertyLinkList Sources;
+    /// wait until this many features execute at the same time, or one second passed
+    App::PropertyInteger WaitFor;
+    /// milliseconds to sleep before setting the result
+    App::PropertyInteger Delay;
+    /// throw a Base::AbortException instead of setting the result
+    App::PropertyBool Abort;
+    App::PropertyInteger Result;
+
+    DocumentObjectExecReturn* execute() override;
+    bool allowConcurrentExecute() const override
+    {
+        return true;
+    }
+
+    /// the highest number of features executed at the same time since resetRunning()
+    static int getMaxRunning();
+    static void resetRunning();
+};
+
 
 }  // namespace App
 
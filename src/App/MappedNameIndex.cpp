@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <limits>
+#endif
+
+#include "MappedNameIndex.h"
+
+
+namespace Data
+{
+
+namespace
+{
+
+constexpr std::size_t minCapacity = 16;
+
+std::size_t hashBytes(std::size_t hash, const QByteArray& bytes)
+{
+    // FNV-1a, applied to data and postfix in turn so that the split between
+    // the two does not change the hash, just like MappedName::operator==()
+    constexpr std::size_t prime = sizeof(std::size_t) == 8 ? 1099511628211ULL : 16777619UL;
+    for (char ch : bytes) {
+        hash ^= static_cast<unsigned char>(ch);
+        hash *= prime;
+    }
+    return hash;
+}
+
+}  // namespace
+
+std::size_t MappedNameIndex::hashName(const MappedName& name)
+{
+    constexpr std::size_t basis =
+        sizeof(std::size_t) == 8 ? 14695981039346656037ULL : 2166136261UL;
+    return hashBytes(hashBytes(basis, name.dataBytes()), name.postfixBytes());
+}
+
+std::size_t MappedNameIndex::findSlot(const MappedName& name, std::size_t hash) const
+{
+    std::size_t mask = _slots.size() - 1;
+    for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+        std::uint32_t pos = _slots[slot];
+        if (pos == emptySlot) {
+            return slot;
+        }
+        const Entry& entry = _entries[pos - 1];
+        if (entry.hash == hash && entry.name == name) {
+            return slot;
+        }
+    }
+}
+
+const MappedNameIndex::Entry* MappedNameIndex::find(const MappedName& name) const
+{
+    if (_entries.empty()) {
+        return nullptr;
+    }
+    std::uint32_t pos = _slots[findSlot(name, hashName(name))];
+    return pos == emptySlot ? nullptr : &_entries[pos - 1];
+}
+
+std::pair<MappedNameIndex::Entry*, bool> MappedNameIndex::insert(const MappedName& name,
+                                                                 const IndexedName& index)
+{
+    // keep the load factor at or below one half
+    if ((_entries.size() + 1) * 2 > _slots.size()) {
+        rehash(std::max(minCapacity, _slots.size() * 2));
+    }
+    std::size_t hash = hashName(name);
+    std::size_t slot = findSlot(name, hash);
+    if (_slots[slot] != emptySlot) {
+        return {&_entries[_slots[slot] - 1], false};
+    }
+    assert(_entries.size() < std::numeric_limits<std::uint32_t>::max());
+    _entries.push_back(Entry {name, index, hash});
+    _slots[slot] = static_cast<std::uint32_t>(_entries.size());
+    return {&_entries.back(), true};
+}
+
+bool MappedNameIndex::erase(const MappedName& name)
+{
+    if (_entries.empty()) {
+        return false;
+    }
+    std::size_t mask = _slots.size() - 1;
+    std::size_t hole = findSlot(name, hashName(name));
+    std::uint32_t pos = _slots[hole];
+    if (pos == emptySlot) {
+        return false;
+    }
+
+    // Backward shift deletion: pull following entries of the probe sequence
+    // into the hole unless that would move them before their home slot.
+    _slots[hole] = emptySlot;
+    for (std::size_t slot = (hole + 1) & mask; _slots[slot] != emptySlot;
+         slot = (slot + 1) & mask) {
+        std::size_t home = _entries[_slots[slot] - 1].hash & mask;
+        if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+            _slots[hole] = _slots[slot];
+            _slots[slot] = emptySlot;
+            hole = slot;
+        }
+    }
+
+    // Move the last entry into the freed position to keep the array dense
+    auto last = static_cast<std::uint32_t>(_entries.size());
+    if (pos != last) {
+        Entry& moved = _entries.back();
+        for (std::size_t slot = moved.hash & mask;; slot = (slot + 1) & mask) {
+            if (_slots[slot] == last) {
+                _slots[slot] = pos;
+                break;
+            }
+        }
+        _entries[pos - 1] = std::move(moved);
+    }
+    _entries.pop_back();
+    return true;
+}
+
+void MappedNameIndex::clear()
+{
+    _entries.clear();
+    _slots.clear();
+}
+
+void MappedNameIndex::reserve(std::size_t count)
+{
+    _entries.reserve(count);
+    std::size_t capacity = minCapacity;
+    while (capacity < count * 2) {
+        capacity *= 2;
+    }
+    if (capacity > _slots.size()) {
+        rehash(capacity);
+    }
+}
+
+void MappedNameIndex::rehash(std::size_t capacity)
+{
+    _slots.assign(capacity, emptySlot);
+    std::size_t mask = capacity - 1;
+    for (std::size_t i = 0; i < _entries.size(); ++i) {
+        std::size_t slot = _entries[i].hash & mask;
+        while (_slots[slot] != emptySlot) {
+            slot = (slot + 1) & mask;
+        }
+        _slots[slot] = static_cast<std::uint32_t>(i + 1);
+    }
+}
+
+std::vector<const MappedNameIndex::Entry*> MappedNameIndex::sorted() const
+{
+    std::vector<const Entry*> res;
+    res.reserve(_entries.size());
+    for (const auto& entry : _entries) {
+        res.push_back(&entry);
+    }
+    std::sort(res.begin(), res.end(), [](const Entry* a, const Entry* b) {
+        return a->name < b->name;
+    });
+    return res;
+}
+
+}  // namespace Data
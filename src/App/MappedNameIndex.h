@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef APP_MAPPED_NAME_INDEX_H
+#define APP_MAPPED_NAME_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "IndexedName.h"
+#include "MappedName.h"
+
+namespace Data
+{
+
+/** Flat hash index from MappedName to IndexedName
+ *
+ * The entries are kept in one contiguous array, the lookup goes through an
+ * open-addressing table with linear probing that stores entry positions only.
+ * Compared to a std::map this avoids one heap node per name and the
+ * byte-by-byte MappedName::compare() on every tree level.
+ *
+ * Erasing moves the last entry into the freed position, so the order of
+ * entries() is unspecified. Use sorted() where the order of std::map is needed.
+ * Pointers returned by find() and insert() are invalidated by any modification.
+ */
+class AppExport MappedNameIndex
+{
+public:
+    struct Entry
+    {
+        MappedName name;
+        IndexedName index;
+        std::size_t hash;
+    };
+
+    std::size_t size() const
+    {
+        return _entries.size();
+    }
+
+    bool empty() const
+    {
+        return _entries.empty();
+    }
+
+    const std::vector<Entry>& entries() const
+    {
+        return _entries;
+    }
+
+    /// Returns the entry of \a name or nullptr if there is none
+    const Entry* find(const MappedName& name) const;
+
+    /** Inserts \a name if not yet present
+     * @return the entry of \a name and true if it was inserted
+     */
+    std::pair<Entry*, bool> insert(const MappedName& name, const IndexedName& index);
+
+    /// Removes \a name, returns false if it was not present
+    bool erase(const MappedName& name);
+
+    void clear();
+
+    void reserve(std::size_t count);
+
+    /// Returns the entries in the order of MappedName::operator<()
+    std::vector<const Entry*> sorted() const;
+
+    /// Memory used by the entries and slots in bytes, without the name data
+    std::size_t getMemSize() const
+    {
+        return _entries.capacity() * sizeof(Entry) + _slots.capacity() * sizeof(std::uint32_t);
+    }
+
+    /// Hash of the concatenated data and postfix bytes of \a name
+    static std::size_t hashName(const MappedName& name);
+
+private:
+    static constexpr std::uint32_t emptySlot = 0;
+
+    std::size_t findSlot(const MappedName& name, std::size_t hash) const;
+    void rehash(std::size_t capacity);
+
+    std::vector<Entry> _entries;
+    /// Position in _entries plus one, emptySlot for unused slots
+    std::vector<std::uint32_t> _slots;
+};
+
+}  // namespace Data
+
+#endif  // APP_MAPPED_NAME_INDEX_H
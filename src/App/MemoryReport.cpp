@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+#endif
+
+#include "MemoryReport.h"
+
+
+using namespace App;
+
+namespace
+{
+
+void writeString(std::ostream& out, const std::string& str)
+{
+    out << '"';
+    for (char ch : str) {
+        switch (ch) {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            case '\n':
+                out << "\\n";
+                break;
+            case '\r':
+                out << "\\r";
+                break;
+            case '\t':
+                out << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned char>(ch));
+                    out << buf;
+                }
+                else {
+                    out << ch;
+                }
+                break;
+        }
+    }
+    out << '"';
+}
+
+}  // namespace
+
+MemoryReport::ObjectUsage* MemoryReport::findObject(const char* name)
+{
+    if (!name) {
+        return nullptr;
+    }
+    // add the entries appended since the last call to the index
+    for (; indexedObjects < objects.size(); ++indexedObjects) {
+        objectIndex.emplace(objects[indexedObjects].name, indexedObjects);
+    }
+    auto it = objectIndex.find(name);
+    if (it == objectIndex.end()) {
+        return nullptr;
+    }
+    return &objects[it->second];
+}
+
+std::size_t MemoryReport::propertiesTotal() const
+{
+    std::size_t size = documentProperties;
+    for (const auto& usage : objects) {
+        size += usage.properties;
+    }
+    return size;
+}
+
+std::size_t MemoryReport::elementMapsTotal() const
+{
+    std::size_t size = 0;
+    for (const auto& usage : objects) {
+        size += usage.elementMaps;
+    }
+    return size;
+}
+
+std::size_t MemoryReport::viewProvidersTotal() const
+{
+    std::size_t size = 0;
+    for (const auto& usage : objects) {
+        size += usage.viewProvider;
+    }
+    return size;
+}
+
+std::size_t MemoryReport::total() const
+{
+    return propertiesTotal() + elementMapsTotal() + viewProvidersTotal() + stringHashers + undo;
+}
+
+std::string MemoryReport::toJson() const
+{
+    std::vector<const ObjectUsage*> sorted;
+    sorted.reserve(objects.size());
+    for (const auto& usage : objects) {
+        sorted.push_back(&usage);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const ObjectUsage* a, const ObjectUsage* b) {
+        return a->total() > b->total();
+    });
+
+    std::ostringstream out;
+    out << "{\n  \"document\": ";
+    writeString(out, document);
+    out << ",\n  \"total\": " << total()
+        << ",\n  \"properties\": " << propertiesTotal()
+        << ",\n  \"documentProperties\": " << documentProperties
+        << ",\n  \"elementMaps\": " << elementMapsTotal()
+        << ",\n  \"viewProviders\": " << viewProvidersTotal()
+        << ",\n  \"stringHashers\": " << stringHashers
+        << ",\n  \"undo\": " << undo
+        << ",\n  \"deferredProperties\": " << deferredProperties
+        << ",\n  \"propertyTypes\": {";
+    const char* sep = "\n";
+    for (const auto& [type, usage] : propertyTypes) {
+        out << sep << "    ";
+        writeString(out, type);
+        out << ": {\"count\": " << usage.count << ", \"bytes\": " << usage.bytes << "}";
+        sep = ",\n";
+    }
+    out << (propertyTypes.empty() ? "}" : "\n  }") << ",\n  \"objects\": [";
+    sep = "\n";
+    for (const auto usage : sorted) {
+        out << sep << "    {\"name\": ";
+        writeString(out, usage->name);
+        out << ", \"label\": ";
+        writeString(out, usage->label);
+        out << ", \"type\": ";
+        writeString(out, usage->type);
+        out << ", \"total\": " << usage->total()
+            << ", \"properties\": " << usage->properties
+            << ", \"elementMaps\": " << usage->elementMaps
+            << ", \"viewProvider\": " << usage->viewProvider << "}";
+        sep = ",\n";
+    }
+    out << (sorted.empty() ? "]" : "\n  ]") << "\n}\n";
+    return out.str();
+}
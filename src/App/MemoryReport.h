@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef APP_MEMORYREPORT_H
+#define APP_MEMORYREPORT_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <FCGlobal.h>
+
+namespace App
+{
+
+/** Breakdown of the memory used by a document
+ *
+ * Created by Document::getMemoryReport(). All sizes are estimates in bytes,
+ * based on Property::getMemSize() and the element map and string hasher
+ * tables. Geometry that is not yet loaded because of deferred loading is
+ * counted in deferredProperties only.
+ *
+ * The categories do not overlap, total() is their sum.
+ */
+class AppExport MemoryReport
+{
+public:
+    struct ObjectUsage
+    {
+        std::string name;
+        std::string label;
+        std::string type;
+        /// Sum of Property::getMemSize() of all properties
+        std::size_t properties {0};
+        /// Element maps of the geometry, shared child maps are counted once per document
+        std::size_t elementMaps {0};
+        /// Scene graph of the view provider, filled in by the GUI
+        std::size_t viewProvider {0};
+
+        std::size_t total() const
+        {
+            return properties + elementMaps + viewProvider;
+        }
+    };
+
+    struct TypeUsage
+    {
+        std::size_t count {0};
+        std::size_t bytes {0};
+    };
+
+    std::string document;
+    std::vector<ObjectUsage> objects;
+    /// Property memory by type name, including the document properties
+    std::map<std::string, TypeUsage> propertyTypes;
+    /// Properties of the document itself
+    std::size_t documentProperties {0};
+    std::size_t stringHashers {0};
+    std::size_t undo {0};
+    std::size_t deferredProperties {0};
+
+    /** Returns the entry of the object with the internal \a name or nullptr
+     * The lookup uses an index of the names. Entries may be appended to
+     * objects between the calls, but not removed or reordered.
+     */
+    ObjectUsage* findObject(const char* name);
+
+    std::size_t propertiesTotal() const;
+    std::size_t elementMapsTotal() const;
+    std::size_t viewProvidersTotal() const;
+    std::size_t total() const;
+
+    /// Returns the report as JSON, objects sorted by decreasing size
+    std::string toJson() const;
+
+private:
+    std::unordered_map<std::string, std::size_t> objectIndex;
+    std::size_t indexedObjects {0};
+};
+
+}  // namespace App
+
+#endif  // APP_MEMORYREPORT_H
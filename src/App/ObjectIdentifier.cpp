@@ -1218,6 +1218,17 @@ Property* ObjectIdentifier::getProperty(int* ptype) const
     return result.resolvedProperty;
 }
 
+Property* ObjectIdentifier::getWholeProperty() const
+{
+    ResolveResults result(*this);
+    if (!result.resolvedDocumentObject || result.propertyType != PseudoNone
+        || (!subObjectName.getString().empty() && !result.resolvedSubObject)
+        || components.size() != static_cast<std::size_t>(result.propertyIndex) + 1) {
+        return nullptr;
+    }
+    return result.resolvedProperty;
+}
+
 Property* ObjectIdentifier::resolveProperty(const App::DocumentObject* obj,
                                             const char* propertyName,
                                             App::DocumentObject*& sobj,
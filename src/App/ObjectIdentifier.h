@@ -986,6 +986,14 @@ public:
      */
     App::Property* getProperty(int* ptype = nullptr) const;
 
+    /**
+     * @brief Get the property if the object identifier refers to it as a whole.
+     *
+     * @return A pointer to the property, or `nullptr` if the identifier cannot
+     * be resolved, refers to a pseudo property or to a path inside the property.
+     */
+    App::Property* getWholeProperty() const;
+
     /**
      * @brief Create a canonical representation of the object identifier.
      *
@@ -587,6 +587,10 @@ std::string ProjectFile::replaceInputFile(const std::string& name, std::istream&
     zipios::ConstEntries files = project.entries();
     for (const auto& it : files) {
         std::string file = it->getFileName();
+        // the binary copy of the document would be restored instead of the new Document.xml
+        if (file == "Document.fcbin" && name == "Document.xml") {
+            continue;
+        }
         outZip.putNextEntry(file);
         if (file == name) {
             inp >> outZip.rdbuf();
@@ -627,6 +631,10 @@ std::string ProjectFile::replaceInputFiles(const std::map<std::string, std::istr
     zipios::ConstEntries files = project.entries();
     for (const auto& it : files) {
         std::string file = it->getFileName();
+        // the binary copy of the document would be restored instead of the new Document.xml
+        if (file == "Document.fcbin" && inp.count("Document.xml") > 0) {
+            continue;
+        }
         outZip.putNextEntry(file);
 
         auto jt = inp.find(file);
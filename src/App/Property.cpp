@@ -29,6 +29,7 @@
 
 #include <atomic>
 #include <Base/Tools.h>
+#include <Base/TraceRecorder.h>
 #include <Base/Writer.h>
 #include <CXX/Objects.hxx>
 
@@ -51,10 +52,12 @@ TYPESYSTEM_SOURCE_ABSTRACT(App::Property, Base::Persistence)
 // Construction/Destruction
 
 static std::atomic<int64_t> _PropID;
+static std::atomic<std::uint64_t> _ChangeStamp;
 
 // Here is the implementation! Description should take place in the header file!
 Property::Property()
     : _id(++_PropID)
+    , _changeStamp(++_ChangeStamp)
 {}
 
 Property::~Property() = default;
@@ -267,10 +270,17 @@ void Property::setReadOnly(bool readOnly)
     this->setStatus(App::Property::ReadOnly, readOnly);
 }
 
+std::uint64_t Property::currentChangeStamp()
+{
+    return _ChangeStamp.load();
+}
+
 void Property::hasSetValue()
 {
+    _changeStamp = ++_ChangeStamp;
     PropertyCleaner guard(this);
     if (father) {
+        Base::TraceScope trace("onChanged", [this]() { return getFullName(); });
         father->onChanged(this);
         if (!testStatus(Busy)) {
             Base::BitsetLocker<decltype(StatusBits)> guard(StatusBits, Busy);
@@ -305,6 +315,14 @@ void Property::Paste(const Property& /*from*/)
     assert(0);
 }
 
+Property* Property::copyForUndo() const
+{
+    return Copy();
+}
+
+void Property::updateUndo(Property& /*record*/) const
+{}
+
 void Property::setStatusValue(unsigned long status)
 {
     // clang-format off
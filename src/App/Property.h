@@ -29,6 +29,7 @@
 #include <boost/any.hpp>
 #include <boost/signals2.hpp>
 #include <bitset>
+#include <cstdint>
 #include <string>
 #include <FCGlobal.h>
 
@@ -478,6 +479,33 @@ public:
      */
     virtual void Paste(const Property& from) = 0;
 
+    /**
+     * @brief Returns a copy of the value for an undo/redo transaction.
+     *
+     * The transaction calls this function right before the value changes for
+     * the first time within the transaction. The default implementation
+     * calls Copy(). A property holding large data may instead return a record
+     * that takes over the data about to be overwritten, or that holds only
+     * the part about to change, as long as Paste() restores the value from it.
+     *
+     * @return A new property to be passed to Paste() on undo.
+     */
+    virtual Property* copyForUndo() const;
+
+    /**
+     * @brief Updates an undo record on a further change within a transaction.
+     *
+     * The transaction keeps the record of the first change and calls this
+     * function on every further change of the value. The default does
+     * nothing, which is right for records holding the whole value. A record
+     * returned by copyForUndo() that covers only a part of the value must be
+     * extended here, so that it still restores the value from before the
+     * first change.
+     *
+     * @param[in,out] record The record returned by copyForUndo() earlier.
+     */
+    virtual void updateUndo(Property& record) const;
+
     /**
      * @brief Callback for when a child property has changed value.
      *
@@ -516,6 +544,22 @@ public:
         return _id;
     }
 
+    /**
+     * @brief Return the change stamp of the property.
+     *
+     * The stamp is drawn from a global counter that advances whenever any
+     * property is constructed or changed.  A property has changed after a
+     * given point in time if its stamp is greater than the value returned by
+     * currentChangeStamp() at that point.
+     */
+    std::uint64_t getChangeStamp() const
+    {
+        return _changeStamp;
+    }
+
+    /// Return the current value of the global change counter.
+    static std::uint64_t currentChangeStamp();
+
     /**
      * @brief Callback for when the property is about to be saved.
      *
@@ -596,6 +640,7 @@ private:
     PropertyContainer* father {nullptr};
     const char* myName {nullptr};
     int64_t _id;
+    std::uint64_t _changeStamp;
 
 public:
     /// Signal emitted when the property value has changed.
@@ -28,6 +28,7 @@
 #include <App/DocumentObserver.h>
 #include <Base/Reader.h>
 #include <Base/Tools.h>
+#include <Base/TraceRecorder.h>
 #include <Base/Writer.h>
 #include <CXX/Objects.hxx>
 
@@ -142,6 +143,12 @@ void PropertyExpressionEngine::hasSetValue()
         return;
     }
 
+    // The expressions may have been changed, evaluate all of them on next execute()
+    for (auto& e : expressions) {
+        e.second.evalStamp = 0;
+        e.second.inputs.clear();
+    }
+
     std::map<App::DocumentObject*, bool> deps;
     std::vector<std::string> labels;
     unregisterElementReference();
@@ -750,8 +757,22 @@ DocumentObjectExecReturn* App::PropertyExpressionEngine::execute(ExecuteOption o
         App::any value;
         try {
             // Evaluate expression
-            std::shared_ptr<App::Expression> expression = expressions[*it].expression;
+            ExpressionInfo& info = expressions[*it];
+            std::shared_ptr<App::Expression> expression = info.expression;
             if (expression) {
+                if (isUpToDate(info, prop)) {
+                    ++skippedCount;
+                    continue;
+                }
+                ++evaluatedCount;
+                std::uint64_t stamp = Property::currentChangeStamp();
+
+                Base::TraceScope trace("expression", [&]() {
+                    return docObj->getFullName() + "." + it->toString();
+                });
+                if (Base::TraceRecorder::isActive()) {
+                    trace.setDetail(expression->toString());
+                }
                 value = expression->getValueAsAny();
 
                 // Enable value comparison for all expression bindings to reduce
@@ -766,15 +787,18 @@ DocumentObjectExecReturn* App::PropertyExpressionEngine::execute(ExecuteOption o
                 // property modification, i.e. do not touch unless value change
                 //
                 // if (option == ExecuteOnRestore && prop->testStatus(Property::EvalOnRestore))
-                {
-                    if (isAnyEqual(value, prop->getPathValue(*it))) {
-                        continue;
-                    }
+                if (!isAnyEqual(value, prop->getPathValue(*it))) {
                     if (touched) {
                         *touched = true;
                     }
+                    prop->setPathValue(*it, value);
+                }
+
+                // Setting the value may have changed the bindings, look it up again
+                auto found = expressions.find(*it);
+                if (found != expressions.end() && found->second.expression == expression) {
+                    recordInputs(found->second, stamp);
                 }
-                prop->setPathValue(*it, value);
             }
         }
         catch (Base::Exception& e) {
@@ -798,6 +822,82 @@ DocumentObjectExecReturn* App::PropertyExpressionEngine::execute(ExecuteOption o
     return DocumentObject::StdReturn;
 }
 
+/**
+ * @brief Check whether a binding can be skipped by execute().
+ *
+ * A binding is up to date if neither its target property nor any of the
+ * properties read by its last evaluation have changed since. The identifiers
+ * of the expression are resolved again to detect if they now refer to other
+ * properties, e.g. after a link was changed.
+ *
+ * @param info Binding to check.
+ * @param prop Target property of the binding.
+ * @return True if the expression would evaluate to the current value.
+ */
+
+bool PropertyExpressionEngine::isUpToDate(const ExpressionInfo& info, const Property* prop) const
+{
+    if (info.evalStamp == 0 || prop->getChangeStamp() > info.evalStamp) {
+        return false;
+    }
+    try {
+        std::size_t index = 0;
+        for (const auto& dep : info.expression->getIdentifiers()) {
+            int ptype = 0;
+            const Property* input = dep.first.getProperty(&ptype);
+            if (!input || ptype != 0 || index >= info.inputs.size()
+                || input->getID() != info.inputs[index]
+                || input->getChangeStamp() > info.evalStamp) {
+                return false;
+            }
+            ++index;
+        }
+        return index == info.inputs.size();
+    }
+    catch (Base::Exception&) {
+        return false;
+    }
+}
+
+/**
+ * @brief Remember the inputs of a binding after it has been evaluated.
+ *
+ * Nothing is recorded if an input cannot be resolved to a property, e.g. a
+ * reference to a whole object or a pseudo property, or if an input changed
+ * while the result was assigned. Such bindings are always evaluated.
+ *
+ * @param info Binding that has been evaluated.
+ * @param stamp Change stamp taken before the evaluation.
+ */
+
+void PropertyExpressionEngine::recordInputs(ExpressionInfo& info, std::uint64_t stamp) const
+{
+    info.evalStamp = 0;
+    info.inputs.clear();
+    try {
+        for (const auto& dep : info.expression->getIdentifiers()) {
+            int ptype = 0;
+            const Property* input = dep.first.getProperty(&ptype);
+            if (!input || ptype != 0 || input->getChangeStamp() > stamp) {
+                info.inputs.clear();
+                return;
+            }
+            info.inputs.push_back(input->getID());
+        }
+    }
+    catch (Base::Exception&) {
+        info.inputs.clear();
+        return;
+    }
+    info.evalStamp = Property::currentChangeStamp();
+}
+
+void PropertyExpressionEngine::resetEvaluationCounters()
+{
+    evaluatedCount = 0;
+    skippedCount = 0;
+}
+
 /**
  * @brief Find paths to document object.
  * @param obj Document object
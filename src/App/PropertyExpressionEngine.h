@@ -96,6 +96,10 @@ public:
     {
         std::shared_ptr<App::Expression> expression; /**< The actual expression tree */
         bool busy;
+        /** Change stamp taken after the last evaluation, 0 if the expression must be evaluated */
+        std::uint64_t evalStamp {0};
+        /** IDs of the properties read by the last evaluation */
+        std::vector<int64_t> inputs;
 
         explicit ExpressionInfo(
             std::shared_ptr<App::Expression> expression = std::shared_ptr<App::Expression>())
@@ -151,6 +155,23 @@ public:
      */
     DocumentObjectExecReturn* execute(ExecuteOption option = ExecuteAll, bool* touched = nullptr);
 
+    /** Number of bindings evaluated by execute()
+     *
+     * Together with getSkippedCount() this shows how effective the skipping of
+     * bindings with unchanged inputs is. Both counters are reset by
+     * resetEvaluationCounters().
+     */
+    std::size_t getEvaluatedCount() const
+    {
+        return evaluatedCount;
+    }
+    /// Number of bindings skipped by execute() because none of their inputs changed
+    std::size_t getSkippedCount() const
+    {
+        return skippedCount;
+    }
+    void resetEvaluationCounters();
+
     void getPathsToDocumentObject(DocumentObject*, std::vector<App::ObjectIdentifier>& paths) const;
 
     bool depsAreTouched() const;
@@ -218,9 +239,15 @@ private:
     void slotChangedProperty(const App::DocumentObject& obj, const App::Property& prop);
     void updateHiddenReference(const std::string& key);
 
+    bool isUpToDate(const ExpressionInfo& info, const Property* prop) const;
+    void recordInputs(ExpressionInfo& info, std::uint64_t stamp) const;
+
     bool running = false; /**< Boolean used to avoid loops */
     bool restoring = false;
 
+    std::size_t evaluatedCount = 0; /**< Number of bindings evaluated by execute() */
+    std::size_t skippedCount = 0;   /**< Number of bindings skipped by execute() */
+
     ExpressionMap expressions; /**< Stored expressions */
 
     ValidatorFunc validator; /**< Valdiator functor */
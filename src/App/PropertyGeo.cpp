@@ -27,6 +27,7 @@
 #include <Base/PlacementPy.h>
 #include <Base/Reader.h>
 
+#include <Base/Console.h>
 #include <Base/Quantity.h>
 #include <Base/QuantityPy.h>
 #include <Base/Rotation.h>
@@ -1337,7 +1338,15 @@ bool PropertyComplexGeoData::checkElementMapVersion(const char* ver) const
 
 void PropertyComplexGeoData::afterRestore()
 {
-    auto data = getComplexData();
+    // deferred data is checked by the subclass, without loading it
+    if (!isDeferred()) {
+        checkRestoreFailure(getComplexData());
+    }
+    PropertyGeometry::afterRestore();
+}
+
+void PropertyComplexGeoData::checkRestoreFailure(const Data::ComplexGeoData* data)
+{
     if (data && data->isRestoreFailed()) {
         data->resetRestoreFailure();
         auto owner = freecad_cast<DocumentObject*>(getContainer());
@@ -1346,5 +1355,55 @@ void PropertyComplexGeoData::afterRestore()
             owner->getDocument()->addRecomputeObject(owner);
         }
     }
-    PropertyGeometry::afterRestore();
+}
+
+void PropertyComplexGeoData::deferDocFile(std::shared_ptr<Base::DeferredFile> file)
+{
+    std::lock_guard<std::recursive_mutex> lock(deferredMutex);
+    deferredFile = std::move(file);
+    deferred.store(true, std::memory_order_release);
+}
+
+void PropertyComplexGeoData::loadDeferred() const
+{
+    if (!isDeferred()) {
+        return;
+    }
+    // An accessor called while restoring finds no file and returns
+    std::lock_guard<std::recursive_mutex> lock(deferredMutex);
+    auto file = std::move(deferredFile);
+    deferredFile.reset();
+    if (!file) {
+        return;
+    }
+    try {
+        file->read([this](Base::Reader& reader) {
+            const_cast<PropertyComplexGeoData*>(this)->restoreDeferred(reader);
+        });
+    }
+    catch (const Base::Exception& e) {
+        Base::Console().error("Failed to load deferred file %s of %s: %s\n",
+                              file->getFileName().c_str(),
+                              getFullName().c_str(),
+                              e.what());
+    }
+    catch (const std::exception& e) {
+        Base::Console().error("Failed to load deferred file %s of %s: %s\n",
+                              file->getFileName().c_str(),
+                              getFullName().c_str(),
+                              e.what());
+    }
+    deferred.store(false, std::memory_order_release);
+}
+
+void PropertyComplexGeoData::discardDeferred()
+{
+    std::lock_guard<std::recursive_mutex> lock(deferredMutex);
+    deferredFile.reset();
+    deferred.store(false, std::memory_order_release);
+}
+
+void PropertyComplexGeoData::restoreDeferred(Base::Reader& reader)
+{
+    RestoreDocFile(reader);
 }
@@ -24,6 +24,10 @@
 #ifndef APP_PROPERTYGEO_H
 #define APP_PROPERTYGEO_H
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+
 #include <Base/BoundBox.h>
 #include <Base/Matrix.h>
 #include <Base/Placement.h>
@@ -36,6 +40,8 @@
 
 namespace Base
 {
+class DeferredFile;
+class Reader;
 class Writer;
 }
 
@@ -574,6 +580,40 @@ public:
     virtual bool checkElementMapVersion(const char* ver) const;
 
     void afterRestore() override;
+
+    /** @name Deferred loading
+     * If the document is restored with deferred loading the geometry is only
+     * read from the project file on first access. Subclasses opting in with
+     * canDeferDocFile() call loadDeferred() in every accessor of their data
+     * and discardDeferred() when a new value is set.
+     */
+    //@{
+    /// Returns true if the data has not been read from the project file yet
+    bool isDeferred() const
+    {
+        return deferred.load(std::memory_order_acquire);
+    }
+    /// Reads the deferred data now, does nothing if there is none
+    void loadDeferred() const;
+    void deferDocFile(std::shared_ptr<Base::DeferredFile> file) override;
+    //@}
+
+protected:
+    /** Restores the data of a deferred file
+     * The value is logically unchanged, so unlike RestoreDocFile() this must
+     * not notify the container. The default implementation calls
+     * RestoreDocFile().
+     */
+    virtual void restoreDeferred(Base::Reader& reader);
+    /// Drops the reference to the deferred file, e.g. when a new value is set
+    void discardDeferred();
+    /// Signals the owner for recomputation if restoring \a data has failed
+    void checkRestoreFailure(const Data::ComplexGeoData* data);
+
+private:
+    mutable std::recursive_mutex deferredMutex;
+    mutable std::shared_ptr<Base::DeferredFile> deferredFile;
+    mutable std::atomic<bool> deferred {false};
 };
 
 }  // namespace App
@@ -25,6 +25,8 @@
 #include <QCryptographicHash>
 #include <QHash>
 #include <deque>
+#include <mutex>
+#include <shared_mutex>
 
 #include <Base/Console.h>
 #include <Base/Reader.h>
@@ -83,6 +85,8 @@ class StringHasher::HashMap: public HashMapBase
 public:
     bool SaveAll = false;
     int Threshold = 0;
+    /// Held shared for lookups and exclusively for any change of the map
+    mutable std::shared_mutex Mutex;
 };
 
 ///////////////////////////////////////////////////////////
@@ -92,6 +96,7 @@ TYPESYSTEM_SOURCE_ABSTRACT(App::StringID, Base::BaseClass)
 StringID::~StringID()
 {
     if (_hasher) {
+        std::unique_lock lock(_hasher->_hashes->Mutex);
         _hasher->_hashes->right.erase(_id);
     }
 }
@@ -196,6 +201,10 @@ void StringHasher::compact()
         return;
     }
 
+    // New references to an entry can only be obtained through a lookup, so the
+    // reference counts checked below cannot grow while the lock is held.
+    std::unique_lock lock(_hashes->Mutex);
+
     // Make a list of all the table entries that have only a single reference and are not marked
     // "persistent"
     std::deque<StringIDRef> pendings;
@@ -242,6 +251,7 @@ int StringHasher::getThreshold() const
     return _hashes->Threshold;
 }
 
+// The caller must hold the lock of _hashes
 long StringHasher::lastID() const
 {
     if (_hashes->right.empty()) {
@@ -278,9 +288,12 @@ StringIDRef StringHasher::getID(const QByteArray& data, Options options)
         dataID._data = data;
     }
 
-    auto it = _hashes->left.find(&dataID);
-    if (it != _hashes->left.end()) {
-        return {it->first};
+    {
+        std::shared_lock lock(_hashes->Mutex);
+        auto it = _hashes->left.find(&dataID);
+        if (it != _hashes->left.end()) {
+            return {it->first};
+        }
     }
 
     if (!hashed && !nocopy) {
@@ -295,8 +308,8 @@ StringIDRef StringHasher::getID(const QByteArray& data, Options options)
     if (hashed) {
         flags.setFlag(StringID::Flag::Hashed);
     }
-    StringIDRef sid(new StringID(lastID() + 1, dataID._data, flags));
-    return {insert(sid)};
+    StringIDRef sid(new StringID(0, dataID._data, flags));
+    return insert(sid);
 }
 
 StringIDRef StringHasher::getID(const Data::MappedName& name, const QVector<StringIDRef>& sids)
@@ -322,13 +335,16 @@ StringIDRef StringHasher::getID(const Data::MappedName& name, const QVector<Stri
     }
 
     // Check to see if there is already an entry in the hash table for this StringID
-    auto it = _hashes->left.find(&tempID);
-    if (it != _hashes->left.end()) {
-        auto res = StringIDRef(it->first);
-        if (indexed) {
-            res._index = indexed.getIndex();
+    {
+        std::shared_lock lock(_hashes->Mutex);
+        auto it = _hashes->left.find(&tempID);
+        if (it != _hashes->left.end()) {
+            auto res = StringIDRef(it->first);
+            if (indexed) {
+                res._index = indexed.getIndex();
+            }
+            return res;
         }
-        return res;
     }
 
     if (!indexed && name.isRaw()) {
@@ -349,14 +365,17 @@ StringIDRef StringHasher::getID(const Data::MappedName& name, const QVector<Stri
         indexRef = getID(tempID._data);
     }
 
-    // The real StringID object that we are going to insert
-    StringIDRef newStringIDRef(new StringID(lastID() + 1, tempID._data));
+    // The real StringID object that we are going to insert, it gets its ID in insert()
+    StringIDRef newStringIDRef(new StringID(0, tempID._data));
     StringID& newStringID = *newStringIDRef._sid;
     if (tempID._postfix.size() != 0) {
         newStringID._flags.setFlag(StringID::Flag::Postfixed);
         newStringID._postfix = tempID._postfix;
     }
 
+    // Keep compact() and clear() from resetting the hasher of the related SIDs meanwhile
+    std::shared_lock lock(_hashes->Mutex);
+
     // Count the related SIDs that use this hasher
     int numSIDs = 0;
     for (const auto& relatedID : sids) {
@@ -430,6 +449,7 @@ StringIDRef StringHasher::getID(const Data::MappedName& name, const QVector<Stri
         }
     }
 
+    lock.unlock();
     return {insert(newStringIDRef), indexed.getIndex()};
 }
 
@@ -438,6 +458,7 @@ StringIDRef StringHasher::getID(long id, int index) const
     if (id <= 0) {
         return {};
     }
+    std::shared_lock lock(_hashes->Mutex);
     auto it = _hashes->right.find(id);
     if (it == _hashes->right.end()) {
         return {};
@@ -463,7 +484,7 @@ const std::string& StringHasher::getPersistenceFileName() const
 void StringHasher::Save(Base::Writer& writer) const
 {
 
-    std::size_t count = _hashes->SaveAll ? _hashes->size() : this->count();
+    std::size_t count = _hashes->SaveAll ? this->size() : this->count();
 
     writer.Stream() << writer.ind() << "<StringHasher saveall=\"" << _hashes->SaveAll
                     << "\" threshold=\"" << _hashes->Threshold << "\"";
@@ -506,6 +527,8 @@ void StringHasher::saveStream(std::ostream& stream) const
     long lastID = 0;
     bool relative = false;
 
+    std::shared_lock lock(_hashes->Mutex);
+
     for (auto& hasher : _hashes->right) {
         auto& d = *hasher.second;
         long id = d._id;
@@ -598,7 +621,7 @@ void StringHasher::RestoreDocFile(Base::Reader& reader)
     std::string ver;
     reader >> marker;
     std::size_t count = 0;
-    _hashes->clear();
+    clear();
     if (marker == "StringTableStart") {
         reader >> ver >> count;
         if (ver != "v1") {
@@ -614,7 +637,7 @@ void StringHasher::RestoreDocFile(Base::Reader& reader)
 void StringHasher::restoreStreamNew(std::istream& stream, std::size_t count)
 {
     Base::TextInputStream asciiStream(stream);
-    _hashes->clear();
+    clear();
     std::string content;
     boost::io::ios_flags_saver ifs(stream);
     stream >> std::hex;
@@ -723,14 +746,24 @@ void StringHasher::restoreStreamNew(std::istream& stream, std::size_t count)
             }
         }
 
-        last = insert(sid);
+        last = insert(sid)._sid;
     }
 }
 
-StringID* StringHasher::insert(const StringIDRef& sid)
+StringIDRef StringHasher::insert(const StringIDRef& sid)
 {
     assert(sid && sid._sid->_hasher == nullptr);
+    std::unique_lock lock(_hashes->Mutex);
     auto& hasher = *sid._sid;
+    if (hasher._id == 0) {
+        // Another thread may have added the same string since the lookup
+        auto it = _hashes->left.find(&hasher);
+        if (it != _hashes->left.end()) {
+            // take the reference before compact() may drop the entry
+            return {it->first};
+        }
+        hasher._id = lastID() + 1;
+    }
     hasher._hasher = this;
     hasher.ref();
     auto res = _hashes->right.insert(_hashes->right.end(),
@@ -739,12 +772,12 @@ StringID* StringHasher::insert(const StringIDRef& sid)
         hasher._hasher = nullptr;
         hasher.unref();
     }
-    return res->second;
+    return {res->second};
 }
 
 void StringHasher::restoreStream(std::istream& stream, std::size_t count)
 {
-    _hashes->clear();
+    clear();
     std::string content;
     for (uint32_t i = 0; i < count; ++i) {
         int32_t id = 0;
@@ -763,6 +796,7 @@ void StringHasher::restoreStream(std::istream& stream, std::size_t count)
 
 void StringHasher::clear()
 {
+    std::unique_lock lock(_hashes->Mutex);
     for (auto& hasher : _hashes->right) {
         hasher.second->_hasher = nullptr;
         hasher.second->unref();
@@ -772,12 +806,14 @@ void StringHasher::clear()
 
 size_t StringHasher::size() const
 {
+    std::shared_lock lock(_hashes->Mutex);
     return _hashes->size();
 }
 
 size_t StringHasher::count() const
 {
     size_t count = 0;
+    std::shared_lock lock(_hashes->Mutex);
     for (auto& hasher : _hashes->right) {
         if (hasher.second->isMarked() || hasher.second->isPersistent()) {
             ++count;
@@ -844,7 +880,16 @@ void StringHasher::Restore(Base::XMLReader& reader)
 
 unsigned int StringHasher::getMemSize() const
 {
-    return (_hashes->SaveAll ? size() : count()) * 10;
+    // Each entry is a StringID plus a node in both indices of the bimap
+    constexpr std::size_t nodeSize = 6 * sizeof(void*);
+    std::size_t size = sizeof(HashMap);
+    std::shared_lock lock(_hashes->Mutex);
+    for (auto& hasher : _hashes->right) {
+        const StringID* sid = hasher.second;
+        size += sizeof(StringID) + nodeSize + sid->_data.size() + sid->_postfix.size()
+            + sid->_sids.size() * sizeof(StringIDRef);
+    }
+    return static_cast<unsigned int>(size);
 }
 
 PyObject* StringHasher::getPyObject()
@@ -855,6 +900,7 @@ PyObject* StringHasher::getPyObject()
 std::map<long, StringIDRef> StringHasher::getIDMap() const
 {
     std::map<long, StringIDRef> ret;
+    std::shared_lock lock(_hashes->Mutex);
     for (auto& hasher : _hashes->right) {
         ret.emplace_hint(ret.end(), hasher.first, StringIDRef(hasher.second));
     }
@@ -863,6 +909,7 @@ std::map<long, StringIDRef> StringHasher::getIDMap() const
 
 void StringHasher::clearMarks() const
 {
+    std::shared_lock lock(_hashes->Mutex);
     for (auto& hasher : _hashes->right) {
         hasher.second->_flags.setFlag(StringID::Flag::Marked, false);
     }
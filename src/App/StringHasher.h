@@ -630,6 +630,11 @@ private:
 /// If the string is longer than a given threshold, instead of storing the string, its SHA1 hash is
 /// stored (and the original string discarded). This allows an upper threshold on the length of a
 /// stored string, while still effectively guaranteeing uniqueness in the table.
+///
+/// Looking up and adding strings is thread-safe, so that element maps of independent shapes can
+/// be generated in parallel. Lookups share a reader lock, while adding a new string is serialized.
+/// StringIDRef reference counting is atomic. Saving, restoring and marking are not meant to run
+/// concurrently with other modifications of the table.
 class AppExport StringHasher: public Base::Persistence, public Base::Handled
 {
 
@@ -771,7 +776,13 @@ public:
     friend class StringID;
 
 protected:
-    StringID* insert(const StringIDRef& sid);
+    /** Add \a sid to the table
+     *
+     * If the ID of \a sid is 0, it is assigned the next free ID, unless an equal string was added
+     * since the caller's lookup. Returns the StringID that is stored in the table. The reference
+     * is taken while the table is locked, so a concurrent compact() cannot drop the entry.
+     */
+    StringIDRef insert(const StringIDRef& sid);
     long lastID() const;
     void saveStream(std::ostream& stream) const;
     void restoreStream(std::istream& stream, std::size_t count);
@@ -25,7 +25,9 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+#include <algorithm>
 #include <cassert>
+#include <limits>
 #endif
 
 #include <atomic>
@@ -116,7 +118,22 @@ int Transaction::getLastID()
 
 unsigned int Transaction::getMemSize() const
 {
-    return 0;
+    if (!memSizeValid) {
+        std::size_t size = 0;
+        for (auto& info : _Objects.get<0>()) {
+            size += info.second->getMemSize();
+            // an object removed from the document is kept by the transaction,
+            // see ~Transaction()
+            if (info.second->status == TransactionObject::New
+                && !info.first->isAttachedToDocument()) {
+                size += info.first->getMemSize();
+            }
+        }
+        memSize = static_cast<unsigned int>(
+            std::min<std::size_t>(size, std::numeric_limits<unsigned int>::max()));
+        memSizeValid = true;
+    }
+    return memSize;
 }
 
 void Transaction::Save(Base::Writer& /*writer*/) const
@@ -150,6 +167,7 @@ bool Transaction::hasObject(const TransactionalObject* Obj) const
 
 void Transaction::addOrRemoveProperty(TransactionalObject* Obj, const Property* pcProp, bool add)
 {
+    memSizeValid = false;
     auto& index = _Objects.get<1>();
     auto pos = index.find(Obj);
 
@@ -203,6 +221,7 @@ void Transaction::apply(Document& Doc, bool forward)
 
 void Transaction::addObjectNew(TransactionalObject* Obj)
 {
+    memSizeValid = false;
     auto& index = _Objects.get<1>();
     auto pos = index.find(Obj);
     if (pos != index.end()) {
@@ -232,6 +251,7 @@ void Transaction::addObjectNew(TransactionalObject* Obj)
 
 void Transaction::addObjectDel(const TransactionalObject* Obj)
 {
+    memSizeValid = false;
     auto& index = _Objects.get<1>();
     auto pos = index.find(Obj);
 
@@ -253,6 +273,7 @@ void Transaction::addObjectDel(const TransactionalObject* Obj)
 
 void Transaction::addObjectChange(const TransactionalObject* Obj, const Property* Prop)
 {
+    memSizeValid = false;
     auto& index = _Objects.get<1>();
     auto pos = index.find(Obj);
 
@@ -387,10 +408,13 @@ void TransactionObject::setProperty(const Property* pcProp)
         static_cast<DynamicProperty::PropData&>(data) =
             pcProp->getContainer()->getDynamicPropertyData(pcProp);
         data.propertyOrig = pcProp;
-        data.property = pcProp->Copy();
+        data.property = pcProp->copyForUndo();
         data.propertyType = pcProp->getTypeId();
         data.property->setStatusValue(pcProp->getStatus());
     }
+    else if (data.property && data.propertyOrig == pcProp) {
+        pcProp->updateUndo(*data.property);
+    }
 }
 
 void TransactionObject::addOrRemoveProperty(const Property* pcProp, bool add)
@@ -428,7 +452,14 @@ void TransactionObject::addOrRemoveProperty(const Property* pcProp, bool add)
 
 unsigned int TransactionObject::getMemSize() const
 {
-    return 0;
+    std::size_t size = 0;
+    for (const auto& v : _PropChangeMap) {
+        if (v.second.property) {
+            size += v.second.property->getMemSize();
+        }
+    }
+    return static_cast<unsigned int>(
+        std::min<std::size_t>(size, std::numeric_limits<unsigned int>::max()));
 }
 
 void TransactionObject::Save(Base::Writer& /*writer*/) const
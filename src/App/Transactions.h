@@ -65,6 +65,11 @@ public:
     // the utf-8 name of the transaction
     std::string Name;
 
+    /** Returns the size of the stored undo data
+     * It is the sum of the memory sizes of the stored property copies and of
+     * the removed objects owned by the transaction. The value is cached until
+     * the transaction changes.
+     */
     unsigned int getMemSize() const override;
     void Save(Base::Writer& writer) const override;
     /// This method is used to restore properties from an XML document.
@@ -89,6 +94,8 @@ public:
 
 private:
     int transID;
+    mutable unsigned int memSize {0};
+    mutable bool memSizeValid {false};
     using Info = std::pair<const TransactionalObject*, TransactionObject*>;
     bmi::multi_index_container<
         Info,
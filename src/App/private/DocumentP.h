@@ -30,6 +30,7 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -42,6 +43,7 @@
 #include <App/DocumentObject.h>
 #include <App/DocumentObserver.h>
 #include <App/StringHasher.h>
+#include <Base/Parameter.h>
 #include <Base/UniqueNameManager.h>
 
 // using VertexProperty = boost::property<boost::vertex_root_t, DocumentObject* >;
@@ -65,6 +67,76 @@ namespace App
 using HasherMap = boost::bimap<StringHasherRef, int>;
 class Transaction;
 
+/** Incrementally maintained dependency graph of the objects of a document
+ *
+ * The edges mirror DocumentObject::getOutList(). Objects are marked dirty by
+ * the link hooks (DocumentObject::_addBackLink(), _removeBackLink() and
+ * clearOutListCache()), and their edges are refreshed on the next query. A
+ * topological rank (dependencies first) is maintained with the dynamic
+ * algorithm of Pearce and Kelly, so that a link change only reorders the
+ * region of the graph between the two linked objects.
+ */
+class DependencyGraph
+{
+public:
+    void addNode(DocumentObject* obj);
+    void removeNode(const DocumentObject* obj);
+    void markDirty(const DocumentObject* obj);
+    void clear();
+
+    /** Refresh the edges of all dirty objects
+     *
+     * @return false if the graph cannot be used for ordering, i.e. it contains
+     * a cycle or links to objects outside of the document.
+     */
+    bool update();
+
+    /// Return the topological rank of an object, or -1 if it is not part of the graph
+    int rank(const DocumentObject* obj) const;
+
+    /** Collect the given objects and all objects reachable from them
+     *
+     * @param objs: the start objects, which must be part of the graph
+     * @param dependents: if true follow the dependent objects, otherwise the dependencies
+     * @return the collected objects ordered by rank, i.e. dependencies first
+     */
+    std::vector<DocumentObject*> closure(const std::vector<DocumentObject*>& objs,
+                                         bool dependents) const;
+
+    /** Check if any of the given objects is in the recursive in list of an object
+     *
+     * The search follows DocumentObject::getInList() and only visits objects
+     * ranked between \a obj and the highest ranked candidate.
+     *
+     * @return 1 if found, 0 if not, -1 if the graph cannot answer the query
+     */
+    int isInInListRecursive(const DocumentObject* obj,
+                            const std::vector<DocumentObject*>& candidates);
+
+private:
+    struct Node
+    {
+        DocumentObject* object {nullptr};
+        /// dependencies inside the graph, sorted and unique
+        std::vector<DocumentObject*> outList;
+        /// dependents inside the graph
+        std::vector<DocumentObject*> inList;
+        /// number of dependencies outside of the graph
+        int external {0};
+        int rank {0};
+    };
+
+    void refresh(Node& node, std::vector<std::pair<DocumentObject*, DocumentObject*>>* added);
+    bool reorder(const DocumentObject* dependency, const DocumentObject* dependent);
+    bool rebuildOrder();
+
+    std::unordered_map<const DocumentObject*, Node> nodes;
+    std::unordered_set<const DocumentObject*> dirty;
+    int external {0};
+    int nextRank {0};
+    bool cyclic {false};
+};
+
 // Pimpl class
 struct DocumentP
 {
@@ -89,14 +161,24 @@ struct DocumentP
     bool opentransaction {false};
     std::bitset<32> StatusBits;
     int iUndoMode {0};
-    unsigned int UndoMemSize {0};
+    std::size_t UndoMemSize {0};  ///< undo/redo budget in bytes, 0 = unlimited
     unsigned int UndoMaxStackSize {20};
     std::string programVersion;
     mutable HasherMap hashers;
     std::multimap<const App::DocumentObject*, std::unique_ptr<App::DocumentObjectExecReturn>>
         _RecomputeLog;
+    /// guards the recompute log and undo recording during concurrent recompute
+    std::recursive_mutex recomputeMutex;
+    /// set while recompute workers run, the main thread then records undo under recomputeMutex
+    bool concurrentRecompute {false};
 
     StringHasherRef Hasher {new StringHasher};
+    DependencyGraph dependencyGraph;
+
+    /// preferences read on every recompute, bound once per document
+    ParameterGrp::handle hDocGrp;
+    ParameterValue<bool> canAbortRecompute;
+    ParameterValue<bool> parallelRecompute;
 
     DocumentP();
 
@@ -116,6 +198,7 @@ struct DocumentP
             delete returnCode;
             return;
         }
+        std::lock_guard<std::recursive_mutex> lock(recomputeMutex);
         _RecomputeLog.emplace(returnCode->Which,
                               std::unique_ptr<DocumentObjectExecReturn>(returnCode));
         returnCode->Which->setStatus(ObjectStatus::Error, true);
@@ -133,6 +216,7 @@ struct DocumentP
 
     void clearDocument()
     {
+        dependencyGraph.clear();
         objectLabelManager.clear();
         objectArray.clear();
         for (auto& v : objectMap) {
@@ -0,0 +1,608 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <unordered_map>
+#endif
+
+#include "BinaryXML.h"
+#include "Exception.h"
+
+
+using namespace Base;
+
+namespace
+{
+
+// The first byte can never start an XML document
+constexpr std::string_view binaryMagic {"\0FCBX", 5};
+constexpr char formatVersion = 1;
+
+enum Record : unsigned char
+{
+    RecordEndDocument = 0,
+    RecordStartElement = 1,
+    RecordStartEndElement = 2,
+    RecordEndElement = 3,
+    RecordCharacters = 4,
+    RecordCData = 5
+};
+
+bool isSpace(char ch)
+{
+    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r';
+}
+
+void appendUtf8(std::string& out, unsigned long code)
+{
+    if (code < 0x80) {
+        out += static_cast<char>(code);
+    }
+    else if (code < 0x800) {
+        out += static_cast<char>(0xC0 | (code >> 6));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+    else if (code < 0x10000) {
+        out += static_cast<char>(0xE0 | (code >> 12));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+    else {
+        out += static_cast<char>(0xF0 | (code >> 18));
+        out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+}
+
+/// Converts the XML text written by Base::Writer into records
+class Encoder
+{
+public:
+    explicit Encoder(std::string_view xml)
+        : xml(xml)
+    {
+        out.reserve(xml.size() / 2);
+        out.append(binaryMagic);
+        out += formatVersion;
+    }
+
+    std::string run()
+    {
+        bool hasRoot = false;
+        while (pos < xml.size()) {
+            if (xml[pos] != '<') {
+                text();
+            }
+            else if (startsWith("<?")) {
+                skipPast("?>");
+            }
+            else if (startsWith("<!--")) {
+                skipPast("-->");
+            }
+            else if (startsWith("<![CDATA[")) {
+                if (stack.empty()) {
+                    fail("character data outside of the root element");
+                }
+                pos += 9;
+                auto end = xml.find("]]>", pos);
+                if (end == std::string_view::npos) {
+                    fail("unterminated CDATA section");
+                }
+                buffer.clear();
+                normalizeLineEnds(xml.substr(pos, end - pos), buffer);
+                out += static_cast<char>(RecordCData);
+                writeString(buffer);
+                pos = end + 3;
+            }
+            else if (startsWith("<!")) {
+                fail("document type declarations are not supported");
+            }
+            else if (startsWith("</")) {
+                endElement();
+            }
+            else {
+                if (stack.empty() && hasRoot) {
+                    fail("more than one root element");
+                }
+                hasRoot = true;
+                startElement();
+            }
+        }
+        if (!hasRoot || !stack.empty()) {
+            fail("unexpected end of document");
+        }
+        out += static_cast<char>(RecordEndDocument);
+        return std::move(out);
+    }
+
+private:
+    [[noreturn]] void fail(const char* msg) const
+    {
+        throw XMLParseException(std::string("Cannot encode XML at offset ") + std::to_string(pos)
+                                + ": " + msg);
+    }
+
+    bool startsWith(std::string_view str) const
+    {
+        return xml.compare(pos, str.size(), str) == 0;
+    }
+
+    void skipPast(std::string_view end)
+    {
+        auto found = xml.find(end, pos);
+        if (found == std::string_view::npos) {
+            fail("unterminated markup");
+        }
+        pos = found + end.size();
+    }
+
+    void skipSpace()
+    {
+        while (pos < xml.size() && isSpace(xml[pos])) {
+            ++pos;
+        }
+    }
+
+    std::string_view name()
+    {
+        std::size_t start = pos;
+        while (pos < xml.size() && !isSpace(xml[pos]) && xml[pos] != '/' && xml[pos] != '>'
+               && xml[pos] != '=') {
+            ++pos;
+        }
+        if (pos == start) {
+            fail("missing name");
+        }
+        return xml.substr(start, pos - start);
+    }
+
+    void expect(char ch)
+    {
+        if (pos >= xml.size() || xml[pos] != ch) {
+            fail("unexpected character");
+        }
+        ++pos;
+    }
+
+    void writeSize(std::size_t size)
+    {
+        while (size >= 0x80) {
+            out += static_cast<char>((size & 0x7F) | 0x80);
+            size >>= 7;
+        }
+        out += static_cast<char>(size);
+    }
+
+    void writeString(std::string_view str)
+    {
+        writeSize(str.size());
+        out.append(str);
+        out += '\0';
+    }
+
+    void writeName(std::string_view str)
+    {
+        auto res = names.emplace(str, names.size() + 1);
+        if (res.second) {
+            writeSize(0);
+            writeString(str);
+        }
+        else {
+            writeSize(res.first->second);
+        }
+    }
+
+    static void normalizeLineEnds(std::string_view raw, std::string& res)
+    {
+        for (std::size_t i = 0; i < raw.size(); ++i) {
+            if (raw[i] == '\r') {
+                res += '\n';
+                if (i + 1 < raw.size() && raw[i + 1] == '\n') {
+                    ++i;
+                }
+            }
+            else {
+                res += raw[i];
+            }
+        }
+    }
+
+    /// Resolves references and normalizes line ends, and white space of attribute values
+    void decode(std::string_view raw, bool attribute, std::string& res)
+    {
+        for (std::size_t i = 0; i < raw.size(); ++i) {
+            char ch = raw[i];
+            if (ch == '&') {
+                auto end = raw.find(';', i);
+                if (end == std::string_view::npos) {
+                    fail("unterminated reference");
+                }
+                std::string_view ref = raw.substr(i + 1, end - i - 1);
+                if (ref == "lt") {
+                    res += '<';
+                }
+                else if (ref == "gt") {
+                    res += '>';
+                }
+                else if (ref == "amp") {
+                    res += '&';
+                }
+                else if (ref == "quot") {
+                    res += '"';
+                }
+                else if (ref == "apos") {
+                    res += '\'';
+                }
+                else if (ref.size() > 1 && ref[0] == '#') {
+                    std::string digits(ref.substr(1));
+                    int base = 10;
+                    if (digits[0] == 'x') {
+                        digits.erase(0, 1);
+                        base = 16;
+                    }
+                    char* last = nullptr;
+                    unsigned long code = std::strtoul(digits.c_str(), &last, base);
+                    if (digits.empty() || *last != '\0' || code > 0x10FFFF) {
+                        fail("invalid character reference");
+                    }
+                    appendUtf8(res, code);
+                }
+                else {
+                    fail("unknown entity");
+                }
+                i = end;
+            }
+            else if (ch == '\r') {
+                res += attribute ? ' ' : '\n';
+                if (i + 1 < raw.size() && raw[i + 1] == '\n') {
+                    ++i;
+                }
+            }
+            else if (attribute && (ch == '\n' || ch == '\t')) {
+                res += ' ';
+            }
+            else {
+                res += ch;
+            }
+        }
+    }
+
+    void text()
+    {
+        std::size_t start = pos;
+        pos = std::min(xml.find('<', pos), xml.size());
+        std::string_view raw = xml.substr(start, pos - start);
+        if (stack.empty()) {
+            for (char ch : raw) {
+                if (!isSpace(ch)) {
+                    fail("character data outside of the root element");
+                }
+            }
+            return;
+        }
+        buffer.clear();
+        decode(raw, false, buffer);
+        out += static_cast<char>(RecordCharacters);
+        writeString(buffer);
+    }
+
+    void startElement()
+    {
+        ++pos;
+        std::string_view elementName = name();
+        attrNames.clear();
+        std::size_t count = 0;
+        bool empty = false;
+        for (;;) {
+            skipSpace();
+            if (pos >= xml.size()) {
+                fail("unterminated start tag");
+            }
+            if (xml[pos] == '/') {
+                ++pos;
+                expect('>');
+                empty = true;
+                break;
+            }
+            if (xml[pos] == '>') {
+                ++pos;
+                break;
+            }
+            std::string_view attrName = name();
+            skipSpace();
+            expect('=');
+            skipSpace();
+            if (pos >= xml.size() || (xml[pos] != '"' && xml[pos] != '\'')) {
+                fail("missing attribute value");
+            }
+            char quote = xml[pos++];
+            auto end = xml.find(quote, pos);
+            if (end == std::string_view::npos) {
+                fail("unterminated attribute value");
+            }
+            if (attrValues.size() <= count) {
+                attrValues.emplace_back();
+            }
+            attrValues[count].clear();
+            decode(xml.substr(pos, end - pos), true, attrValues[count]);
+            attrNames.push_back(attrName);
+            ++count;
+            pos = end + 1;
+        }
+
+        out += static_cast<char>(empty ? RecordStartEndElement : RecordStartElement);
+        writeName(elementName);
+        writeSize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            writeName(attrNames[i]);
+            writeString(attrValues[i]);
+        }
+        if (!empty) {
+            stack.push_back(elementName);
+        }
+    }
+
+    void endElement()
+    {
+        pos += 2;
+        std::string_view elementName = name();
+        skipSpace();
+        expect('>');
+        if (stack.empty() || stack.back() != elementName) {
+            fail("mismatched end tag");
+        }
+        stack.pop_back();
+        out += static_cast<char>(RecordEndElement);
+    }
+
+    std::string_view xml;
+    std::size_t pos {0};
+    std::string out;
+    std::string buffer;
+    std::unordered_map<std::string_view, std::size_t> names;
+    std::vector<std::string_view> stack;
+    std::vector<std::string_view> attrNames;
+    std::vector<std::string> attrValues;
+};
+
+void writeEscaped(std::ostream& out, std::string_view str, bool attribute)
+{
+    std::size_t start = 0;
+    for (std::size_t i = 0; i < str.size(); ++i) {
+        const char* esc = nullptr;
+        switch (str[i]) {
+            case '<':
+                esc = "&lt;";
+                break;
+            case '>':
+                esc = "&gt;";
+                break;
+            case '&':
+                esc = "&amp;";
+                break;
+            case '"':
+                esc = attribute ? "&quot;" : nullptr;
+                break;
+            case '\n':
+                esc = attribute ? "&#10;" : nullptr;
+                break;
+            case '\r':
+                esc = "&#13;";
+                break;
+            case '\t':
+                esc = attribute ? "&#9;" : nullptr;
+                break;
+            default:
+                break;
+        }
+        if (esc) {
+            out.write(str.data() + start, static_cast<std::streamsize>(i - start));
+            out << esc;
+            start = i + 1;
+        }
+    }
+    out.write(str.data() + start, static_cast<std::streamsize>(str.size() - start));
+}
+
+}  // namespace
+
+bool Base::isBinaryXML(std::istream& str)
+{
+    return str.peek() == std::char_traits<char>::to_int_type(binaryMagic[0]);
+}
+
+void Base::encodeBinaryXML(std::string_view xml, std::ostream& out)
+{
+    std::string data = Encoder(xml).run();
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+void Base::decodeBinaryXML(std::string data, std::ostream& out)
+{
+    BinaryXMLCursor cursor(std::move(data));
+    out << "<?xml version='1.0' encoding='utf-8'?>\n";
+    for (;;) {
+        switch (cursor.next()) {
+            case BinaryXMLCursor::Token::StartElement:
+            case BinaryXMLCursor::Token::StartEndElement:
+                out << '<' << cursor.name();
+                for (const auto& [name, value] : cursor.attributes()) {
+                    out << ' ' << name << "=\"";
+                    writeEscaped(out, value, true);
+                    out << '"';
+                }
+                out << (cursor.token() == BinaryXMLCursor::Token::StartEndElement ? "/>" : ">");
+                break;
+            case BinaryXMLCursor::Token::EndElement:
+                out << "</" << cursor.name() << '>';
+                break;
+            case BinaryXMLCursor::Token::Characters:
+                writeEscaped(out, cursor.text(), false);
+                break;
+            case BinaryXMLCursor::Token::CData:
+                // split any ']]>' in the content across two sections
+                out << "<![CDATA[";
+                for (std::size_t start = 0;;) {
+                    auto end = cursor.text().find("]]>", start);
+                    if (end == std::string_view::npos) {
+                        out << cursor.text().substr(start);
+                        break;
+                    }
+                    out << cursor.text().substr(start, end + 2 - start) << "]]><![CDATA[";
+                    start = end + 2;
+                }
+                out << "]]>";
+                break;
+            case BinaryXMLCursor::Token::EndDocument:
+                out << '\n';
+                return;
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+BinaryXMLCursor::BinaryXMLCursor(std::string data)
+    : _data(std::move(data))
+{
+    if (_data.size() <= binaryMagic.size()
+        || std::string_view(_data).substr(0, binaryMagic.size()) != binaryMagic) {
+        throw XMLParseException("Invalid binary document header");
+    }
+    if (_data[binaryMagic.size()] != formatVersion) {
+        throw XMLParseException("Unsupported binary document version");
+    }
+    _pos = binaryMagic.size() + 1;
+}
+
+std::size_t BinaryXMLCursor::readSize()
+{
+    std::size_t size = 0;
+    for (unsigned shift = 0;; shift += 7) {
+        if (_pos >= _data.size() || shift >= sizeof(std::size_t) * 8) {
+            throw XMLParseException("Truncated binary document");
+        }
+        auto byte = static_cast<unsigned char>(_data[_pos++]);
+        size |= static_cast<std::size_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return size;
+        }
+    }
+}
+
+std::string_view BinaryXMLCursor::readString()
+{
+    std::size_t size = readSize();
+    if (size >= _data.size() - _pos || _data[_pos + size] != '\0') {
+        throw XMLParseException("Truncated binary document");
+    }
+    std::string_view res(_data.data() + _pos, size);
+    _pos += size + 1;
+    return res;
+}
+
+std::string_view BinaryXMLCursor::readName()
+{
+    std::size_t index = readSize();
+    if (index == 0) {
+        _names.push_back(readString());
+        return _names.back();
+    }
+    if (index > _names.size()) {
+        throw XMLParseException("Invalid name in binary document");
+    }
+    return _names[index - 1];
+}
+
+BinaryXMLCursor::Token BinaryXMLCursor::next()
+{
+    if (_done) {
+        return _token;
+    }
+    if (_pos >= _data.size()) {
+        throw XMLParseException("Truncated binary document");
+    }
+    switch (static_cast<unsigned char>(_data[_pos++])) {
+        case RecordStartElement:
+        case RecordStartEndElement: {
+            bool empty = _data[_pos - 1] == RecordStartEndElement;
+            _name = readName();
+            std::size_t count = readSize();
+            _attrs.clear();
+            for (std::size_t i = 0; i < count; ++i) {
+                std::string_view attrName = readName();
+                _attrs.emplace_back(attrName, readString());
+            }
+            if (empty) {
+                _token = Token::StartEndElement;
+            }
+            else {
+                _stack.push_back(_name);
+                _token = Token::StartElement;
+            }
+            break;
+        }
+        case RecordEndElement:
+            if (_stack.empty()) {
+                throw XMLParseException("Unbalanced binary document");
+            }
+            _name = _stack.back();
+            _stack.pop_back();
+            _token = Token::EndElement;
+            break;
+        case RecordCharacters:
+            _text = readString();
+            _token = Token::Characters;
+            break;
+        case RecordCData:
+            _text = readString();
+            _token = Token::CData;
+            break;
+        case RecordEndDocument:
+            if (!_stack.empty()) {
+                throw XMLParseException("Unbalanced binary document");
+            }
+            _done = true;
+            _token = Token::EndDocument;
+            break;
+        default:
+            throw XMLParseException("Invalid record in binary document");
+    }
+    return _token;
+}
+
+const char* BinaryXMLCursor::attribute(const char* name) const
+{
+    for (const auto& [attrName, value] : _attrs) {
+        if (attrName == name) {
+            return value.data();
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef BASE_BINARYXML_H
+#define BASE_BINARYXML_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <FCGlobal.h>
+
+namespace Base
+{
+
+/** @name Binary XML
+ *
+ * The binary encoding stores the SAX events of an XML document as tagged,
+ * length-prefixed records, so that XMLReader can restore it without running
+ * the XML parser. Element and attribute names are written once and referred
+ * to by index afterwards, every string is followed by a null byte so that it
+ * can be handed out without copying.
+ *
+ * The encoding keeps everything the XMLReader sees, i.e. elements, attributes
+ * and character data, so it converts back to equivalent XML. Comments,
+ * processing instructions and whitespace outside the root element are
+ * dropped.
+ */
+//@{
+
+/// Check if \a str is positioned at the start of binary encoded XML, nothing is consumed
+BaseExport bool isBinaryXML(std::istream& str);
+
+/** Encode the XML document \a xml into \a out
+ *
+ * Only the subset of XML written by Base::Writer is supported, i.e. no DTD
+ * and no entities beside the predefined and numeric ones.
+ * @throw XMLParseException if \a xml is not well-formed
+ */
+BaseExport void encodeBinaryXML(std::string_view xml, std::ostream& out);
+
+/** Write the binary encoded document \a data as XML into \a out
+ * @throw XMLParseException if \a data is not valid
+ */
+BaseExport void decodeBinaryXML(std::string data, std::ostream& out);
+
+//@}
+
+/** Reads binary encoded XML one event after another
+ *
+ * The names, attribute values and character data point into the buffer of
+ * the cursor and are valid until it is destroyed. They are null terminated.
+ */
+class BaseExport BinaryXMLCursor
+{
+public:
+    enum class Token : unsigned char
+    {
+        EndDocument,
+        StartElement,
+        StartEndElement,
+        EndElement,
+        Characters,
+        CData
+    };
+
+    /// @throw XMLParseException if \a data does not start with a valid header
+    explicit BinaryXMLCursor(std::string data);
+
+    BinaryXMLCursor(const BinaryXMLCursor&) = delete;
+    BinaryXMLCursor(BinaryXMLCursor&&) = delete;
+    BinaryXMLCursor& operator=(const BinaryXMLCursor&) = delete;
+    BinaryXMLCursor& operator=(BinaryXMLCursor&&) = delete;
+
+    /** Advance to the next event
+     * @throw XMLParseException if the data is truncated or corrupt
+     */
+    Token next();
+
+    Token token() const
+    {
+        return _token;
+    }
+    /// Element name of StartElement, StartEndElement and EndElement
+    std::string_view name() const
+    {
+        return _name;
+    }
+    /// Content of Characters and CData
+    std::string_view text() const
+    {
+        return _text;
+    }
+    /// Number of nested elements
+    std::size_t depth() const
+    {
+        return _stack.size();
+    }
+
+    /// Attributes of the last start element
+    const std::vector<std::pair<std::string_view, std::string_view>>& attributes() const
+    {
+        return _attrs;
+    }
+    /// Returns the value of the attribute \a name of the last start element or nullptr
+    const char* attribute(const char* name) const;
+
+private:
+    std::size_t readSize();
+    std::string_view readString();
+    std::string_view readName();
+
+    std::string _data;
+    std::size_t _pos {0};
+    std::vector<std::string_view> _names;
+    std::vector<std::string_view> _stack;
+    std::vector<std::pair<std::string_view, std::string_view>> _attrs;
+    std::string_view _name;
+    std::string_view _text;
+    Token _token {Token::EndDocument};
+    bool _done {false};
+};
+
+}  // namespace Base
+
+#endif  // BASE_BINARYXML_H
@@ -676,8 +676,59 @@ ParameterGrp::GetAttributeMap(ParamType Type, const char* sFilter) const
     return res;
 }
 
+template<typename T, typename Func>
+T ParameterGrp::_GetCached(ParamType Type, const char* Name, const T& Preset, Func Read) const
+{
+    if (!_pGroupNode) {
+        return Preset;
+    }
+
+    if (!Name) {
+        DOMElement* pcElem = FindElement(_pGroupNode, TypeName(Type), Name);
+        return pcElem ? Read(pcElem) : Preset;
+    }
+
+    std::lock_guard<std::mutex> lock(_CacheMutex);
+    auto& cache = _Cache[static_cast<int>(Type) - static_cast<int>(ParamType::FCText)];
+    auto it = cache.find(Name);
+    if (it == cache.end()) {
+        CachedValue entry;
+        DOMElement* pcElem = FindElement(_pGroupNode, TypeName(Type), Name);
+        if (pcElem) {
+            entry.found = true;
+            entry.value = Read(pcElem);
+        }
+        it = cache.emplace(Name, std::move(entry)).first;
+    }
+    return it->second.found ? std::get<T>(it->second.value) : Preset;
+}
+
+void ParameterGrp::_InvalidateCache(ParamType Type, const char* Name)
+{
+    {
+        std::lock_guard<std::mutex> lock(_CacheMutex);
+        if (Name && Type >= ParamType::FCText && Type <= ParamType::FCFloat) {
+            auto& cache = _Cache[static_cast<int>(Type) - static_cast<int>(ParamType::FCText)];
+            auto it = cache.find(Name);
+            if (it != cache.end()) {
+                cache.erase(it);
+            }
+        }
+        else {
+            for (auto& cache : _Cache) {
+                cache.clear();
+            }
+        }
+    }
+    _CacheVersion.fetch_add(1, std::memory_order_acq_rel);
+}
+
 void ParameterGrp::_Notify(ParamType Type, const char* Name, const char* Value)
 {
+    // Group notifications with a name only add or rename sub-groups
+    if (Type != ParamType::FCGroup || !Name) {
+        _InvalidateCache(Type, Name);
+    }
     if (_Manager) {
         _Manager->signalParamChanged(this, Type, Name, Value);
     }
@@ -725,16 +776,10 @@ bool ParameterGrp::GetBool(const char* Name, bool bPreset) const
         return bPreset;
     }
 
-    // check if Element in group
-    DOMElement* pcElem = FindElement(_pGroupNode, "FCBool", Name);
-    // if not return preset
-    if (!pcElem) {
-        return bPreset;
-    }
-
-    // if yes check the value and return
-    return (strcmp(StrX(pcElem->getAttribute(XStrLiteral("Value").unicodeForm())).c_str(), "1")
-            == 0);
+    return _GetCached(ParamType::FCBool, Name, bPreset, [](DOMElement* pcElem) {
+        return (strcmp(StrX(pcElem->getAttribute(XStrLiteral("Value").unicodeForm())).c_str(), "1")
+                == 0);
+    });
 }
 
 void ParameterGrp::SetBool(const char* Name, bool bValue)
@@ -804,14 +849,9 @@ long ParameterGrp::GetInt(const char* Name, long lPreset) const
         return lPreset;
     }
 
-    // check if Element in group
-    DOMElement* pcElem = FindElement(_pGroupNode, "FCInt", Name);
-    // if not return preset
-    if (!pcElem) {
-        return lPreset;
-    }
-    // if yes check the value and return
-    return atol(StrX(pcElem->getAttribute(XStrLiteral("Value").unicodeForm())).c_str());
+    return _GetCached(ParamType::FCInt, Name, lPreset, [](DOMElement* pcElem) {
+        return atol(StrX(pcElem->getAttribute(XStrLiteral("Value").unicodeForm())).c_str());
+    });
 }
 
 void ParameterGrp::SetInt(const char* Name, long lValue)
@@ -873,18 +913,12 @@ unsigned long ParameterGrp::GetUnsigned(const char* Name, unsigned long lPreset)
         return lPreset;
     }
 
-    // check if Element in group
-    DOMElement* pcElem = FindElement(_pGroupNode, "FCUInt", Name);
-    // if not return preset
-    if (!pcElem) {
-        return lPreset;
-    }
-
-    // if yes check the value and return
-    const int base = 10;
-    return strtoul(StrX(pcElem->getAttribute(XStrLiteral("Value").unicodeForm())).c_str(),
-                   nullptr,
-                   base);
+    return _GetCached(ParamType::FCUInt, Name, lPreset, [](DOMElement* pcElem) {
+        const int base = 10;
+        return strtoul(StrX(pcElem->getAttribute(XStrLiteral("Value").unicodeForm())).c_str(),
+                       nullptr,
+                       base);
+    });
 }
 
 void ParameterGrp::SetUnsigned(const char* Name, unsigned long lValue)
@@ -953,14 +987,9 @@ double ParameterGrp::GetFloat(const char* Name, double dPreset) const
         return dPreset;
     }
 
-    // check if Element in group
-    DOMElement* pcElem = FindElement(_pGroupNode, "FCFloat", Name);
-    // if not return preset
-    if (!pcElem) {
-        return dPreset;
-    }
-    // if yes check the value and return
-    return atof(StrX(pcElem->getAttribute(XStrLiteral("Value").unicodeForm())).c_str());
+    return _GetCached(ParamType::FCFloat, Name, dPreset, [](DOMElement* pcElem) {
+        return atof(StrX(pcElem->getAttribute(XStrLiteral("Value").unicodeForm())).c_str());
+    });
 }
 
 void ParameterGrp::SetFloat(const char* Name, double dValue)
@@ -1065,21 +1094,16 @@ std::string ParameterGrp::GetASCII(const char* Name, const char* pPreset) const
         return pPreset ? pPreset : "";
     }
 
-    // check if Element in group
-    DOMElement* pcElem = FindElement(_pGroupNode, "FCText", Name);
-    // if not return preset
-    if (!pcElem) {
-        if (!pPreset) {
-            return {};
-        }
-        return {pPreset};
-    }
-    // if yes check the value and return
-    DOMNode* pcElem2 = pcElem->getFirstChild();
-    if (pcElem2) {
-        return {StrXUTF8(pcElem2->getNodeValue()).c_str()};
-    }
-    return {};
+    return _GetCached(ParamType::FCText,
+                      Name,
+                      pPreset ? std::string(pPreset) : std::string(),
+                      [](DOMElement* pcElem) {
+                          DOMNode* pcElem2 = pcElem->getFirstChild();
+                          if (pcElem2) {
+                              return std::string(StrXUTF8(pcElem2->getNodeValue()).c_str());
+                          }
+                          return std::string();
+                      });
 }
 
 std::vector<std::string> ParameterGrp::GetASCIIs(const char* sFilter) const
@@ -1590,6 +1614,7 @@ void ParameterGrp::NotifyAll()
 void ParameterGrp::_Reset()
 {
     _pGroupNode = nullptr;
+    _InvalidateCache(ParamType::FCInvalid, nullptr);
     for (auto& v : _GroupMap) {
         v.second->_Reset();
     }
@@ -1919,6 +1944,7 @@ int ParameterManager::LoadDocument(const XERCES_CPP_NAMESPACE_QUALIFIER InputSou
     }
 
     _pGroupNode = FindElement(rootElem, "FCParamGroup", "Root");
+    _InvalidateCache(ParamType::FCInvalid, nullptr);
 
     if (!_pGroupNode) {
         throw XMLBaseException("Malformed Parameter document: Root group not found");
@@ -2045,6 +2071,7 @@ void ParameterManager::CreateDocument()
     _pGroupNode = _pDocument->createElement(XStrLiteral("FCParamGroup").unicodeForm());
     _pGroupNode->setAttribute(XStrLiteral("Name").unicodeForm(), XStrLiteral("Root").unicodeForm());
     rootElem->appendChild(_pGroupNode);
+    _InvalidateCache(ParamType::FCInvalid, nullptr);
 }
 
 void ParameterManager::CheckDocument() const
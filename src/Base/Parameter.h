@@ -45,7 +45,13 @@ using PyObject = struct _object;
 #undef isalnum
 #endif
 
+#include <array>
+#include <atomic>
 #include <map>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <variant>
 #include <vector>
 #include <boost/signals2.hpp>
 #include <xercesc/util/XercesDefs.hpp>
@@ -421,6 +427,15 @@ public:
      */
     void NotifyAll();
 
+    /** Returns the version of the typed value cache
+     *  The version changes whenever a value of this group may have changed.
+     *  ParameterValue uses it to skip the lookup while the value is unchanged.
+     */
+    unsigned long GetCacheVersion() const
+    {
+        return _CacheVersion.load(std::memory_order_acquire);
+    }
+
     ParameterGrp* Parent() const
     {
         return _Parent;
@@ -446,6 +461,15 @@ protected:
     void _SetAttribute(ParamType Type, const char* Name, const char* Value);
     void _Notify(ParamType Type, const char* Name, const char* Value);
 
+    /** Returns the value of \a Name read through the typed value cache
+     *  \a Read converts the DOM element to the value, it is only called when
+     *  the value is not cached yet.
+     */
+    template<typename T, typename Func>
+    T _GetCached(ParamType Type, const char* Name, const T& Preset, Func Read) const;
+    /// Drops the cached value of \a Name, or all cached values if \a Name is null
+    void _InvalidateCache(ParamType Type, const char* Name);
+
     XERCES_CPP_NAMESPACE_QUALIFIER DOMElement*
     FindNextElement(XERCES_CPP_NAMESPACE_QUALIFIER DOMNode* Prev, const char* Type) const;
 
@@ -495,6 +519,129 @@ protected:
      * This is used to prevent anynew value/sub-group to be added in observer
      */
     bool _Clearing = false;
+
+    /// Value read by GetBool(), GetInt(), GetUnsigned(), GetFloat() or GetASCII()
+    struct CachedValue
+    {
+        /// false if the group has no such entry and the preset is returned
+        bool found {false};
+        std::variant<bool, long, unsigned long, double, std::string> value;
+    };
+    /// Typed value cache, indexed by ParamType starting at FCText
+    mutable std::array<std::map<std::string, CachedValue, std::less<>>, 5> _Cache;
+    /** Guards the containers in _Cache only
+     *  A cache miss reads the DOM, which the setters change without this lock, so
+     *  a group must not be read from one thread while another thread changes it.
+     */
+    mutable std::mutex _CacheMutex;
+    std::atomic<unsigned long> _CacheVersion {0};
+};
+
+/** Typed handle to a single parameter
+ *  The handle binds a group and a key, so callers do not need to look up the
+ *  group by path on every read. Reading returns the value remembered from the
+ *  last read as long as the cache version of the group is unchanged, and only
+ *  then goes through the cached accessors of ParameterGrp.
+ *
+ *  T may be bool, long, unsigned long, double, std::string or Base::Color.
+ *  A handle is meant to be used by one thread at a time.
+ *  @code
+ *  // a member, so the group is bound for the lifetime of its owner
+ *  ParameterValue<bool> canAbort {hGrp, "CanAbortRecompute", true};
+ *  if (canAbort) { ... }
+ *  @endcode
+ */
+template<typename T>
+class ParameterValue
+{
+public:
+    ParameterValue(Base::Reference<ParameterGrp> group, std::string name, T preset = T())
+        : _Group(std::move(group))
+        , _Name(std::move(name))
+        , _Preset(std::move(preset))
+    {}
+
+    /// Returns the current value, or the preset if the parameter is not set
+    T get() const
+    {
+        // read the version first, a concurrent change then leads to a re-read next time
+        unsigned long version = _Group->GetCacheVersion();
+        if (!_Valid || version != _Version) {
+            _Value = read();
+            _Version = version;
+            _Valid = true;
+        }
+        return _Value;
+    }
+
+    operator T() const  // NOLINT
+    {
+        return get();
+    }
+
+    void set(const T& value)
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            _Group->SetBool(_Name.c_str(), value);
+        }
+        else if constexpr (std::is_same_v<T, long>) {
+            _Group->SetInt(_Name.c_str(), value);
+        }
+        else if constexpr (std::is_same_v<T, unsigned long>) {
+            _Group->SetUnsigned(_Name.c_str(), value);
+        }
+        else if constexpr (std::is_same_v<T, double>) {
+            _Group->SetFloat(_Name.c_str(), value);
+        }
+        else if constexpr (std::is_same_v<T, std::string>) {
+            _Group->SetASCII(_Name.c_str(), value);
+        }
+        else {
+            static_assert(std::is_same_v<T, Base::Color>, "unsupported parameter type");
+            _Group->SetColor(_Name.c_str(), value);
+        }
+    }
+
+    const Base::Reference<ParameterGrp>& group() const
+    {
+        return _Group;
+    }
+
+    const std::string& name() const
+    {
+        return _Name;
+    }
+
+private:
+    T read() const
+    {
+        if constexpr (std::is_same_v<T, bool>) {
+            return _Group->GetBool(_Name.c_str(), _Preset);
+        }
+        else if constexpr (std::is_same_v<T, long>) {
+            return _Group->GetInt(_Name.c_str(), _Preset);
+        }
+        else if constexpr (std::is_same_v<T, unsigned long>) {
+            return _Group->GetUnsigned(_Name.c_str(), _Preset);
+        }
+        else if constexpr (std::is_same_v<T, double>) {
+            return _Group->GetFloat(_Name.c_str(), _Preset);
+        }
+        else if constexpr (std::is_same_v<T, std::string>) {
+            return _Group->GetASCII(_Name.c_str(), _Preset.c_str());
+        }
+        else {
+            static_assert(std::is_same_v<T, Base::Color>, "unsupported parameter type");
+            return _Group->GetColor(_Name.c_str(), _Preset);
+        }
+    }
+
+    Base::Reference<ParameterGrp> _Group;
+    std::string _Name;
+    T _Preset;
+    mutable T _Value {};
+    mutable unsigned long _Version {0};
+    mutable bool _Valid {false};
 };
 
 /** The parameter serializer class
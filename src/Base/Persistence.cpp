@@ -25,6 +25,9 @@
 
 #ifndef _PreComp_
 #include <cassert>
+#include <iterator>
+#include <memory>
+#include <sstream>
 #endif
 
 #include <zipios++/zipinputstream.h>
@@ -74,6 +77,27 @@ void Persistence::SaveDocFile(Writer& /*writer*/) const
 void Persistence::RestoreDocFile(Reader& /*reader*/)
 {}
 
+std::function<void()> Persistence::decodeDocFile(Reader& reader)
+{
+    // not detachable, restore the file when the result is applied
+    auto data = std::make_shared<std::string>(std::istreambuf_iterator<char>(reader),
+                                              std::istreambuf_iterator<char>());
+    auto fileName = reader.getFileName();
+    auto version = reader.getFileVersion();
+    return [this, data, fileName, version]() {
+        std::istringstream str(*data, std::ios::in | std::ios::binary);
+        Reader dataReader(str, fileName, version);
+        RestoreDocFile(dataReader);
+    };
+}
+
+void Persistence::deferDocFile(std::shared_ptr<DeferredFile> file)
+{
+    file->read([this](Reader& reader) {
+        RestoreDocFile(reader);
+    });
+}
+
 std::string Persistence::encodeAttribute(const std::string& str)
 {
     std::string tmp;
@@ -122,6 +146,7 @@ void Persistence::dumpToStream(std::ostream& stream, int compression)
         writer.setLevel(compression);
         writer.putNextEntry("Persistence.xml");
         writer.setMode("BinaryBrep");
+        writer.setMode("BinaryElementMap");
 
         // save the content (we need to encapsulate it with xml tags to be able to read single
         // element xmls like happen for properties)
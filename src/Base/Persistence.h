@@ -24,10 +24,15 @@
 #ifndef APP_PERSISTENCE_H
 #define APP_PERSISTENCE_H
 
+#include <functional>
+#include <memory>
+#include <string>
+
 #include "BaseClass.h"
 
 namespace Base
 {
+class DeferredFile;
 class Reader;
 class Writer;
 class XMLReader;
@@ -145,6 +150,34 @@ public:
      * @see Base::Reader,Base::XMLReader
      */
     virtual void RestoreDocFile(Reader& /*reader*/);
+    /** Returns true if the file \a fileName can be restored with decodeDocFile()
+     * It is called on the thread reading the document.
+     */
+    virtual bool canDecodeDocFile(const std::string& /*fileName*/) const
+    {
+        return false;
+    }
+    /** Concurrent counterpart of RestoreDocFile()
+     * When the XMLReader restores files concurrently this method is called
+     * on a worker thread for the files accepted by canDecodeDocFile(). It must
+     * parse the data of \a reader into a detached result without modifying
+     * this object or any other shared state. The returned function is then
+     * called on the thread reading the document, in the order of the files,
+     * to apply the result to this object.
+     */
+    virtual std::function<void()> decodeDocFile(Reader& reader);
+    /** Returns true if reading the file \a fileName may be deferred
+     * @see XMLReader::setDeferFiles()
+     */
+    virtual bool canDeferDocFile(const std::string& /*fileName*/) const
+    {
+        return false;
+    }
+    /** Called instead of RestoreDocFile() for a file accepted by canDeferDocFile()
+     * The object keeps \a file and reads it when its data is needed. The
+     * default implementation reads the file right away.
+     */
+    virtual void deferDocFile(std::shared_ptr<DeferredFile> file);
     /// Encodes an attribute upon saving.
     static std::string encodeAttribute(const std::string&);
 
@@ -32,11 +32,20 @@
 #include <xercesc/sax2/Attributes.hpp>
 #endif
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <iterator>
 #include <locale>
+#include <mutex>
+#include <sstream>
+#include <thread>
 
 #include "Reader.h"
 #include "Base64.h"
 #include "Base64Filter.h"
+#include "BinaryXML.h"
 #include "Console.h"
 #include "Exception.h"
 #include "InputSource.h"
@@ -48,6 +57,7 @@
 #ifdef _MSC_VER
 #include <zipios++/zipios-config.h>
 #endif
+#include <zipios++/zipfile.h>
 #include <zipios++/zipinputstream.h>
 #include <boost/iostreams/filtering_stream.hpp>
 
@@ -74,6 +84,19 @@ Base::XMLReader::XMLReader(const char* FileName, std::istream& str)
     str.imbue(std::locale::classic());
 #endif
 
+    if (isBinaryXML(str)) {
+        try {
+            Binary = std::make_unique<BinaryXMLCursor>(
+                std::string(std::istreambuf_iterator<char>(str), std::istreambuf_iterator<char>()));
+            ReadType = StartDocument;
+            _valid = true;
+        }
+        catch (const Base::Exception& e) {
+            cerr << "Exception message is: \n" << e.what() << "\n";
+        }
+        return;
+    }
+
     // create the parser
     parser = XMLReaderFactory::createXMLReader();  // NOLINT
 
@@ -115,9 +138,24 @@ const char* Base::XMLReader::localName() const
 
 unsigned int Base::XMLReader::getAttributeCount() const
 {
+    if (Binary) {
+        return static_cast<unsigned int>(Binary->attributes().size());
+    }
     return static_cast<unsigned int>(AttrMap.size());
 }
 
+const char* Base::XMLReader::findAttribute(const char* AttrName) const
+{
+    if (Binary) {
+        return Binary->attribute(AttrName);
+    }
+    auto pos = AttrMap.find(AttrName);
+    if (pos == AttrMap.end()) {
+        return nullptr;
+    }
+    return pos->second.c_str();
+}
+
 namespace
 {
 template<typename T>
@@ -148,11 +186,10 @@ template<typename T>
     requires Base::XMLReader::instantiated<T>
 T Base::XMLReader::getAttribute(const char* AttrName, T defaultValue) const
 {
-    auto pos = AttrMap.find(AttrName);
-    if (pos == AttrMap.end()) {
+    const char* rawValue = findAttribute(AttrName);
+    if (!rawValue) {
         return defaultValue;
     }
-    const char* rawValue = pos->second.c_str();
     return readerCast<T>(rawValue);
 }
 
@@ -160,13 +197,12 @@ template<typename T>
     requires Base::XMLReader::instantiated<T>
 T Base::XMLReader::getAttribute(const char* AttrName) const
 {
-    auto pos = AttrMap.find(AttrName);
-    if (pos == AttrMap.end()) {
+    const char* rawValue = findAttribute(AttrName);
+    if (!rawValue) {
         // wrong name, use hasAttribute if not sure!
         std::string msg = std::string("XML Attribute: \"") + AttrName + "\" not found";
         throw Base::XMLAttributeError(msg);
     }
-    const char* rawValue = pos->second.c_str();
     return readerCast<T>(rawValue);
 }
 
@@ -195,13 +231,18 @@ Base::XMLReader::getAttribute<unsigned long>(const char* AttrName) const;
 
 bool Base::XMLReader::hasAttribute(const char* AttrName) const
 {
-    return AttrMap.find(AttrName) != AttrMap.end();
+    return findAttribute(AttrName) != nullptr;
 }
 
 bool Base::XMLReader::read()
 {
     ReadType = None;
 
+    if (Binary) {
+        readBinary();
+        return true;
+    }
+
     try {
         parser->parseNext(token);
     }
@@ -225,6 +266,45 @@ bool Base::XMLReader::read()
     return true;
 }
 
+void Base::XMLReader::readBinary()
+{
+    // Same state changes as the SAX handlers below
+    switch (Binary->next()) {
+        case BinaryXMLCursor::Token::StartElement:
+            Level++;
+            LocalName = Binary->name();
+            ReadType = StartElement;
+            break;
+        case BinaryXMLCursor::Token::StartEndElement:
+            LocalName = Binary->name();
+            ReadType = StartEndElement;
+            break;
+        case BinaryXMLCursor::Token::EndElement:
+            Level--;
+            LocalName = Binary->name();
+            ReadType = EndElement;
+            // the parser reports the end of the document together with the
+            // end of the root element
+            if (Binary->depth() == 0) {
+                Binary->next();
+                ReadType = EndDocument;
+            }
+            break;
+        case BinaryXMLCursor::Token::Characters:
+            Characters = Binary->text();
+            CharacterCount += Characters.size();
+            ReadType = Chars;
+            break;
+        case BinaryXMLCursor::Token::CData:
+            Characters = Binary->text();
+            ReadType = EndCDATA;
+            break;
+        case BinaryXMLCursor::Token::EndDocument:
+            ReadType = EndDocument;
+            break;
+    }
+}
+
 void Base::XMLReader::readElement(const char* ElementName)
 {
     bool ok {};
@@ -438,6 +518,82 @@ void Base::XMLReader::readBinFile(const char* filename)
     to.close();
 }
 
+namespace
+{
+// Runs the decoding of embedded files on a fixed number of worker threads
+class DecodeQueue
+{
+public:
+    using Task = std::packaged_task<std::function<void()>()>;
+
+    explicit DecodeQueue(unsigned threads)
+        : threads(threads)
+    {}
+    ~DecodeQueue()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            // tasks not started yet are dropped, their futures report a broken promise
+            tasks.clear();
+            closed = true;
+        }
+        changed.notify_all();
+        for (auto& it : workers) {
+            it.wait();
+        }
+    }
+    DecodeQueue(const DecodeQueue&) = delete;
+    DecodeQueue(DecodeQueue&&) = delete;
+    DecodeQueue& operator=(const DecodeQueue&) = delete;
+    DecodeQueue& operator=(DecodeQueue&&) = delete;
+
+    std::future<std::function<void()>> add(Task task)
+    {
+        auto result = task.get_future();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(std::move(task));
+        }
+        changed.notify_one();
+        // workers are started on demand, up to the given number
+        if (workers.size() < threads) {
+            workers.push_back(std::async(std::launch::async, [this]() {
+                run();
+            }));
+        }
+        return result;
+    }
+
+private:
+    void run()
+    {
+        for (;;) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                changed.wait(lock, [this]() {
+                    return closed || !tasks.empty();
+                });
+                if (tasks.empty()) {
+                    return;
+                }
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            // an exception is stored in the future of the task
+            task();
+        }
+    }
+
+    unsigned threads;
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<Task> tasks;
+    std::vector<std::future<void>> workers;
+    bool closed {false};
+};
+}  // anonymous namespace
+
 void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
 {
     // It's possible that not all objects inside the document could be created, e.g. if a module
@@ -457,6 +613,49 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
         // project file was created without GUI
         return;
     }
+
+    // Files decoded on worker threads. Their results are applied in the
+    // order of the files, before any file restored directly.
+    struct PendingFile
+    {
+        std::string fileName;
+        std::string entryName;
+        std::future<std::function<void()>> result;
+    };
+    std::deque<PendingFile> pending;
+    auto applyNext = [this, &pending]() {
+        PendingFile file = std::move(pending.front());
+        pending.pop_front();
+        try {
+            auto apply = file.result.get();
+            if (apply) {
+                apply();
+            }
+        }
+        catch (...) {
+            Base::Console().error("Reading failed from embedded file: %s\n",
+                                  file.entryName.c_str());
+            FailedFiles.push_back(file.fileName);
+        }
+    };
+    unsigned threads = FileThreadCount > 0 ? FileThreadCount
+                                           : std::max(std::thread::hardware_concurrency(), 1U);
+    DecodeQueue decoder(threads);
+
+    // Deferred files are read later on by random access into the archive
+    std::shared_ptr<zipios::ZipFile> archive;
+    if (DeferFiles) {
+        try {
+            archive = std::make_shared<zipios::ZipFile>(_File.filePath());
+            if (!archive->isValid()) {
+                archive.reset();
+            }
+        }
+        catch (const std::exception&) {
+            archive.reset();
+        }
+    }
+
     std::vector<FileEntry>::const_iterator it = FileList.begin();
     Base::SequencerLauncher seq("Importing project files...", FileList.size());
     while (entry->isValid() && it != FileList.end()) {
@@ -468,7 +667,54 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
         }
         // If this condition is true both file names match and we can read-in the data, otherwise
         // no file name for the current entry in the zip was registered.
-        if (jt != FileList.end()) {
+        if (jt != FileList.end() && archive && jt->Object->canDeferDocFile(jt->FileName)) {
+            while (!pending.empty()) {
+                applyNext();
+            }
+            try {
+                jt->Object->deferDocFile(
+                    std::make_shared<DeferredFile>(archive, jt->FileName, FileVersion));
+            }
+            catch (...) {
+                Base::Console().error("Reading failed from embedded file: %s\n",
+                                      entry->toString().c_str());
+                FailedFiles.push_back(jt->FileName);
+            }
+            it = jt + 1;
+        }
+        else if (jt != FileList.end() && threads > 1
+                 && jt->Object->canDecodeDocFile(jt->FileName)) {
+            // The zip stream can only be inflated sequentially, so copy the
+            // data and decode it on a worker thread
+            try {
+                std::string data {std::istreambuf_iterator<char>(zipstream),
+                                  std::istreambuf_iterator<char>()};
+                auto task = [object = jt->Object,
+                             fileName = jt->FileName,
+                             version = FileVersion,
+                             data = std::move(data)]() mutable {
+                    std::istringstream str(std::move(data), std::ios::in | std::ios::binary);
+                    Base::Reader reader(str, fileName, version);
+                    return object->decodeDocFile(reader);
+                };
+                pending.push_back({jt->FileName,
+                                   entry->toString(),
+                                   decoder.add(DecodeQueue::Task(std::move(task)))});
+            }
+            catch (...) {
+                Base::Console().error("Reading failed from embedded file: %s\n",
+                                      entry->toString().c_str());
+                FailedFiles.push_back(jt->FileName);
+            }
+            while (pending.size() > threads) {
+                applyNext();
+            }
+            it = jt + 1;
+        }
+        else if (jt != FileList.end()) {
+            while (!pending.empty()) {
+                applyNext();
+            }
             try {
                 Base::Reader reader(zipstream, jt->FileName, FileVersion);
                 jt->Object->RestoreDocFile(reader);
@@ -501,6 +747,10 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
             break;
         }
     }
+
+    while (!pending.empty()) {
+        applyNext();
+    }
 }
 
 const char* Base::XMLReader::addFile(const char* Name, Base::Persistence* Object)
@@ -729,3 +979,23 @@ std::shared_ptr<Base::XMLReader> Base::Reader::getLocalReader() const
 {
     return (this->localreader);
 }
+
+// ---------------------------------------------------------------------------
+
+Base::DeferredFile::DeferredFile(std::shared_ptr<zipios::ZipFile> archive,
+                                 std::string fileName,
+                                 int version)
+    : archive(std::move(archive))
+    , fileName(std::move(fileName))
+    , fileVersion(version)
+{}
+
+void Base::DeferredFile::read(const std::function<void(Base::Reader&)>& func) const
+{
+    std::unique_ptr<std::istream> str(archive->getInputStream(fileName));
+    if (!str) {
+        throw Base::FileException("Missing embedded file", fileName);
+    }
+    Base::Reader reader(*str, fileName, fileVersion);
+    func(reader);
+}
@@ -24,6 +24,7 @@
 #define SRC_BASE_READER_H_
 
 #include <bitset>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -39,6 +40,7 @@
 
 namespace zipios
 {
+class ZipFile;
 class ZipInputStream;
 }
 #ifndef XERCES_CPP_NAMESPACE_BEGIN
@@ -59,6 +61,7 @@ XERCES_CPP_NAMESPACE_END
 
 namespace Base
 {
+class BinaryXMLCursor;
 class Persistence;
 
 /** The XML reader class
@@ -138,7 +141,11 @@ public:
         PartialRestoreInProperty = 2,        // Local to the Property
         PartialRestoreInObject = 3           // Local to the object partially restored itself
     };
-    /// open the file and read the first element
+    /** open the file and read the first element
+     *
+     * The stream may also contain XML encoded with encodeBinaryXML(), which
+     * is then read without the XML parser.
+     */
     XMLReader(const char* FileName, std::istream&);
     ~XMLReader() override;
 
@@ -285,6 +292,25 @@ public:
     const char* addFile(const char* Name, Base::Persistence* Object);
     /// process the requested file writes
     void readFiles(zipios::ZipInputStream& zipstream) const;
+    /** Sets the number of threads used by readFiles()
+     * With more than one thread the files whose objects accept
+     * Persistence::canDecodeDocFile() are decoded concurrently. 0 means one
+     * thread per core, the default of 1 restores the files one by one.
+     */
+    void setFileThreadCount(unsigned count)
+    {
+        FileThreadCount = count;
+    }
+    /** Enables deferred reading of files
+     * If enabled, readFiles() hands the files accepted by
+     * Persistence::canDeferDocFile() to Persistence::deferDocFile() instead of
+     * reading them. The project file must not be modified while its files are
+     * referenced.
+     */
+    void setDeferFiles(bool on)
+    {
+        DeferFiles = on;
+    }
     /// Returns whether reader has any registered filenames
     bool hasFilenames() const;
     /// returns true if reading the file \a filename has failed
@@ -317,6 +343,10 @@ public:
 protected:
     /// read the next element
     bool read();
+    /// read the next element of a binary encoded document
+    void readBinary();
+    /// Returns the value of the attribute of the current element or nullptr
+    const char* findAttribute(const char* AttrName) const;
 
     // -----------------------------------------------------------------------
     //  Handlers for the SAX ContentHandler interface
@@ -384,7 +414,9 @@ private:
 
 
     FileInfo _File;
-    XERCES_CPP_NAMESPACE_QUALIFIER SAX2XMLReader* parser;
+    XERCES_CPP_NAMESPACE_QUALIFIER SAX2XMLReader* parser {nullptr};
+    /// Set instead of the parser for binary encoded documents
+    std::unique_ptr<BinaryXMLCursor> Binary;
     XERCES_CPP_NAMESPACE_QUALIFIER XMLPScanToken token;
     bool _valid {false};
     bool _verbose {true};
@@ -399,6 +431,8 @@ public:
 
 private:
     mutable std::vector<std::string> FailedFiles;
+    unsigned FileThreadCount {1};
+    bool DeferFiles {false};
 
     std::bitset<32> StatusBits;
 
@@ -422,6 +456,32 @@ private:
     std::shared_ptr<Base::XMLReader> localreader;
 };
 
+/** Reference to a file of a project archive that has not been read yet
+ * It keeps the name of the zip entry, whose position is looked up in the
+ * central directory of the archive, so that the file can be read at any time
+ * later on and from any thread.
+ * @see XMLReader::setDeferFiles()
+ */
+class BaseExport DeferredFile
+{
+public:
+    DeferredFile(std::shared_ptr<zipios::ZipFile> archive, std::string fileName, int version);
+
+    const std::string& getFileName() const
+    {
+        return fileName;
+    }
+    /** Opens the file and calls \a func with a reader of its data
+     * Throws Base::FileException if the file cannot be opened.
+     */
+    void read(const std::function<void(Base::Reader&)>& func) const;
+
+private:
+    std::shared_ptr<zipios::ZipFile> archive;
+    std::string fileName;
+    int fileVersion;
+};
+
 }  // namespace Base
 
 
@@ -0,0 +1,217 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <array>
+#include <cstdio>
+#include <ostream>
+#endif
+
+#include "TraceRecorder.h"
+#include "Exception.h"
+#include "FileInfo.h"
+#include "Stream.h"
+
+
+using namespace Base;
+
+std::atomic<bool> TraceRecorder::active {false};
+
+namespace
+{
+
+void writeJsonString(std::ostream& out, const std::string& text)
+{
+    out << '"';
+    for (char ch : text) {
+        switch (ch) {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            case '\n':
+                out << "\\n";
+                break;
+            case '\r':
+                out << "\\r";
+                break;
+            case '\t':
+                out << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20) {
+                    std::array<char, 8> buf {};
+                    std::snprintf(buf.data(), buf.size(), "\\u%04x", static_cast<unsigned>(ch));
+                    out << buf.data();
+                }
+                else {
+                    out << ch;
+                }
+                break;
+        }
+    }
+    out << '"';
+}
+
+}  // namespace
+
+TraceRecorder& TraceRecorder::instance()
+{
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+void TraceRecorder::start()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    events.clear();
+    origin = Clock::now();
+    active.store(true, std::memory_order_release);
+}
+
+void TraceRecorder::stop()
+{
+    active.store(false, std::memory_order_release);
+}
+
+void TraceRecorder::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    events.clear();
+}
+
+std::int64_t TraceRecorder::now() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - origin).count();
+}
+
+unsigned TraceRecorder::currentThread()
+{
+    static std::atomic<unsigned> counter {0};
+    thread_local unsigned id = ++counter;
+    return id;
+}
+
+void TraceRecorder::addEvent(const char* category,
+                             std::string name,
+                             std::int64_t start,
+                             std::int64_t duration,
+                             std::string detail)
+{
+    if (!isActive()) {
+        return;
+    }
+    Event event;
+    event.category = category;
+    event.name = std::move(name);
+    event.detail = std::move(detail);
+    event.start = start;
+    event.duration = duration;
+    event.thread = currentThread();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    events.push_back(std::move(event));
+}
+
+void TraceRecorder::addInstant(const char* category, std::string name, std::string detail)
+{
+    if (isActive()) {
+        addEvent(category, std::move(name), now(), -1, std::move(detail));
+    }
+}
+
+std::vector<TraceRecorder::Event> TraceRecorder::getEvents() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return events;
+}
+
+std::size_t TraceRecorder::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return events.size();
+}
+
+void TraceRecorder::writeChromeTrace(std::ostream& out) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (const auto& event : events) {
+        if (!first) {
+            out << ',';
+        }
+        first = false;
+        out << "\n{\"name\":";
+        writeJsonString(out, event.name);
+        out << ",\"cat\":";
+        writeJsonString(out, event.category);
+        if (event.duration < 0) {
+            out << ",\"ph\":\"i\",\"s\":\"t\"";
+        }
+        else {
+            out << ",\"ph\":\"X\",\"dur\":" << event.duration;
+        }
+        out << ",\"ts\":" << event.start << ",\"pid\":1,\"tid\":" << event.thread;
+        if (!event.detail.empty()) {
+            out << ",\"args\":{\"detail\":";
+            writeJsonString(out, event.detail);
+            out << '}';
+        }
+        out << '}';
+    }
+    out << "\n]}\n";
+}
+
+void TraceRecorder::saveChromeTrace(const std::string& fileName) const
+{
+    FileInfo fi(fileName);
+    Base::ofstream str(fi, std::ios::out | std::ios::trunc);
+    if (!str) {
+        throw FileException("Cannot open file for writing", fi);
+    }
+    writeChromeTrace(str);
+    str.close();
+    if (str.fail()) {
+        throw FileException("Failed to write trace file", fi);
+    }
+}
+
+void TraceScope::begin(std::string text)
+{
+    name = std::move(text);
+    start = TraceRecorder::instance().now();
+    running = true;
+}
+
+void TraceScope::end()
+{
+    auto& recorder = TraceRecorder::instance();
+    recorder.addEvent(category,
+                      std::move(name),
+                      start,
+                      recorder.now() - start,
+                      std::move(detail));
+}
@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef BASE_TRACERECORDER_H
+#define BASE_TRACERECORDER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <FCGlobal.h>
+
+namespace Base
+{
+
+/** In-process recorder of timed events
+ *
+ * Unlike the Tracy zones of Profiler.h the recorder is always compiled in and
+ * needs no external client. It is idle until start() is called; while idle a
+ * TraceScope costs a single atomic load. The recorded events can be written in
+ * the Chrome trace event format, which can be opened with chrome://tracing or
+ * https://ui.perfetto.dev.
+ *
+ * The recorder is thread safe, events are tagged with a small per-thread id.
+ */
+class BaseExport TraceRecorder
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Event
+    {
+        std::string name;
+        const char* category {""};
+        std::string detail;
+        /// Start time in microseconds since start()
+        std::int64_t start {0};
+        /// Duration in microseconds, negative for instant events
+        std::int64_t duration {-1};
+        unsigned thread {0};
+    };
+
+    static TraceRecorder& instance();
+
+    /// Returns true if events are currently recorded
+    static bool isActive() noexcept
+    {
+        return active.load(std::memory_order_relaxed);
+    }
+
+    /// Discards all events and starts recording
+    void start();
+    /// Stops recording, the recorded events are kept
+    void stop();
+    /// Discards all recorded events
+    void clear();
+
+    /// Microseconds elapsed since start()
+    std::int64_t now() const;
+    /// Records a completed event
+    void addEvent(const char* category,
+                  std::string name,
+                  std::int64_t start,
+                  std::int64_t duration,
+                  std::string detail = {});
+    /// Records an instant event at the current time
+    void addInstant(const char* category, std::string name, std::string detail = {});
+
+    std::vector<Event> getEvents() const;
+    std::size_t size() const;
+
+    /// Writes the events as Chrome trace event JSON
+    void writeChromeTrace(std::ostream& out) const;
+    /// Writes the events as Chrome trace event JSON to \a fileName, throws
+    /// Base::FileException on failure
+    void saveChromeTrace(const std::string& fileName) const;
+
+    /// Returns the small id used to tag events of the calling thread
+    static unsigned currentThread();
+
+private:
+    TraceRecorder() = default;
+
+    static std::atomic<bool> active;
+
+    mutable std::mutex mutex;
+    std::vector<Event> events;
+    Clock::time_point origin {Clock::now()};
+};
+
+/** Records the lifetime of the scope as a TraceRecorder event
+ *
+ * The name may be given as a callable returning a string so that it is only
+ * built while the recorder is active:
+ * @code
+ * Base::TraceScope trace("execute", [this]() { return getFullName(); });
+ * @endcode
+ */
+class BaseExport TraceScope
+{
+public:
+    TraceScope(const char* category, const char* name)
+        : category(category)
+    {
+        if (TraceRecorder::isActive()) {
+            begin(name);
+        }
+    }
+
+    template<typename NameFunc,
+             typename = std::enable_if_t<std::is_invocable_r_v<std::string, NameFunc>>>
+    TraceScope(const char* category, NameFunc&& nameFunc)
+        : category(category)
+    {
+        if (TraceRecorder::isActive()) {
+            begin(std::forward<NameFunc>(nameFunc)());
+        }
+    }
+
+    ~TraceScope()
+    {
+        if (running) {
+            end();
+        }
+    }
+
+    /// Attaches an additional text shown with the event
+    void setDetail(std::string text)
+    {
+        if (running) {
+            detail = std::move(text);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope(TraceScope&&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+    TraceScope& operator=(TraceScope&&) = delete;
+
+private:
+    void begin(std::string text);
+    void end();
+
+    const char* category;
+    std::string name;
+    std::string detail;
+    std::int64_t start {0};
+    bool running {false};
+};
+
+}  // namespace Base
+
+#endif  // BASE_TRACERECORDER_H
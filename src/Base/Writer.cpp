@@ -29,13 +29,19 @@
 #include <string>
 #endif
 
+#include <algorithm>
+#include <deque>
+#include <future>
 #include <limits>
 #include <locale>
 #include <iomanip>
+#include <thread>
+#include <zlib.h>
 
 #include "Writer.h"
 #include "Base64.h"
 #include "Base64Filter.h"
+#include "BinaryXML.h"
 #include "Exception.h"
 #include "FileInfo.h"
 #include "Persistence.h"
@@ -316,28 +322,101 @@ void Writer::putNextEntry(const char* file, const char* obj)
 
 // ----------------------------------------------------------------------------
 
-ZipWriter::ZipWriter(const char* FileName)
-    : ZipStream(FileName)
+namespace
+{
+
+void setupZipEntryStream(std::ostream& str)
 {
 #ifdef _MSC_VER
-    ZipStream.imbue(std::locale::empty());
+    str.imbue(std::locale::empty());
 #else
-    ZipStream.imbue(std::locale::classic());
+    str.imbue(std::locale::classic());
 #endif
-    ZipStream.precision(std::numeric_limits<double>::digits10 + 1);
-    ZipStream.setf(std::ios::fixed, std::ios::floatfield);
+    str.precision(std::numeric_limits<double>::digits10 + 1);
+    str.setf(std::ios::fixed, std::ios::floatfield);
+}
+
+// Entries smaller than this are deflated on the writing thread as
+// starting a task costs more than it saves.
+constexpr std::size_t minConcurrentDeflateSize = 64 * 1024;
+
+// zlib takes at most this many bytes per call
+constexpr std::size_t maxDeflateChunk = std::numeric_limits<uInt>::max();
+
+struct DeflatedEntry
+{
+    std::string fileName;
+    /// the deflated data, or the uncompressed data if ok is false
+    std::string data;
+    uLong crc {0};
+    std::size_t size {0};
+    bool ok {false};
+};
+
+DeflatedEntry deflateEntry(std::string fileName, std::string data, int level)
+{
+    DeflatedEntry entry;
+    entry.fileName = std::move(fileName);
+    entry.size = data.size();
+
+    auto input = reinterpret_cast<Bytef*>(data.data());  // NOLINT
+    entry.crc = crc32(0, Z_NULL, 0);
+    for (std::size_t pos = 0; pos < data.size(); pos += maxDeflateChunk) {
+        std::size_t len = std::min(maxDeflateChunk, data.size() - pos);
+        entry.crc = crc32(entry.crc, input + pos, static_cast<uInt>(len));  // NOLINT
+    }
+
+    // same raw deflate stream as zipios::DeflateOutputStreambuf
+    z_stream zs {};
+    if (deflateInit2(&zs, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        entry.data = std::move(data);
+        return entry;
+    }
+    std::string out;
+    std::size_t inPos = 0;
+    std::size_t outSize = 0;
+    int ret = Z_OK;
+    while (ret == Z_OK) {
+        if (zs.avail_in == 0 && inPos < data.size()) {
+            std::size_t len = std::min(maxDeflateChunk, data.size() - inPos);
+            zs.next_in = input + inPos;  // NOLINT
+            zs.avail_in = static_cast<uInt>(len);
+            inPos += len;
+        }
+        if (zs.avail_out == 0) {
+            outSize = out.size();
+            std::size_t grow = std::min(maxDeflateChunk,
+                                        std::max<std::size_t>(data.size() / 2, 64 * 1024));
+            out.resize(outSize + grow);
+            zs.next_out = reinterpret_cast<Bytef*>(out.data() + outSize);  // NOLINT
+            zs.avail_out = static_cast<uInt>(grow);
+        }
+        ret = deflate(&zs, inPos < data.size() ? Z_NO_FLUSH : Z_FINISH);
+    }
+    deflateEnd(&zs);
+    out.resize(out.size() - zs.avail_out);
+
+    // zip entries without the zip64 extension are limited to 32 bit sizes
+    constexpr std::size_t maxEntrySize = std::numeric_limits<zipios::uint32>::max();
+    entry.ok = ret == Z_STREAM_END && out.size() <= maxEntrySize && data.size() <= maxEntrySize;
+    entry.data = entry.ok ? std::move(out) : std::move(data);
+    return entry;
+}
+
+}  // namespace
+
+ZipWriter::ZipWriter(const char* FileName)
+    : ZipStream(FileName)
+    , CurrentStream(&ZipStream)
+{
+    setupZipEntryStream(ZipStream);
 }
 
 ZipWriter::ZipWriter(std::ostream& os)
     : ZipStream(os)
+    , CurrentStream(&ZipStream)
 {
-#ifdef _MSC_VER
-    ZipStream.imbue(std::locale::empty());
-#else
-    ZipStream.imbue(std::locale::classic());
-#endif
-    ZipStream.precision(std::numeric_limits<double>::digits10 + 1);
-    ZipStream.setf(std::ios::fixed, std::ios::floatfield);
+    setupZipEntryStream(ZipStream);
 }
 
 void ZipWriter::putNextEntry(const char* file, const char* obj)
@@ -349,7 +428,32 @@ void ZipWriter::putNextEntry(const char* file, const char* obj)
     Writer::checkErrNo();
 }
 
-void ZipWriter::writeFiles()
+void ZipWriter::beginBinaryXML(const char* entryName)
+{
+    if (XMLBuffer) {
+        throw Base::RuntimeError("Binary XML already started");
+    }
+    XMLBuffer = std::make_unique<std::ostringstream>(std::ios::out | std::ios::binary);
+    setupZipEntryStream(*XMLBuffer);
+    CurrentStream = XMLBuffer.get();
+    BinaryEntry = entryName;
+}
+
+void ZipWriter::endBinaryXML()
+{
+    if (!XMLBuffer) {
+        return;
+    }
+    CurrentStream = &ZipStream;
+    std::string xml = std::move(*XMLBuffer).str();
+    XMLBuffer.reset();
+    ZipStream.write(xml.data(), static_cast<std::streamsize>(xml.size()));
+    putNextEntry(BinaryEntry.c_str());
+    encodeBinaryXML(xml, ZipStream);
+    Writer::checkErrNo();
+}
+
+void ZipWriter::writeFilesSerial()
 {
     // use a while loop because it is possible that while
     // processing the files new ones can be added
@@ -364,6 +468,76 @@ void ZipWriter::writeFiles()
     }
 }
 
+void ZipWriter::writeFiles()
+{
+    unsigned threads = ThreadCount > 0 ? ThreadCount : std::thread::hardware_concurrency();
+    if (threads <= 1) {
+        writeFilesSerial();
+        return;
+    }
+
+    // SaveDocFile() is not thread safe, so the entries are still serialised
+    // one by one, but into memory. Only the deflating runs concurrently and
+    // the results are written in order, keeping the central directory in the
+    // same order as FileList. At most 'threads' entries are held in memory.
+    std::deque<std::future<DeflatedEntry>> pending;
+    auto writeNext = [this, &pending]() {
+        DeflatedEntry deflated = pending.front().get();
+        pending.pop_front();
+        if (!deflated.ok) {
+            // let the zip stream compress the entry as writeFilesSerial() does
+            ZipStream.putNextEntry(deflated.fileName);
+            ZipStream.write(deflated.data.data(),
+                            static_cast<std::streamsize>(deflated.data.size()));
+            Writer::checkErrNo();
+            return;
+        }
+        zipios::ZipCDirEntry entry(deflated.fileName);
+        entry.setMethod(zipios::DEFLATED);
+        entry.setSize(static_cast<zipios::uint32>(deflated.size));
+        entry.setCrc(static_cast<zipios::uint32>(deflated.crc));
+        ZipStream.putPrecompressedEntry(entry,
+                                        deflated.data.data(),
+                                        static_cast<zipios::uint32>(deflated.data.size()));
+        Writer::checkErrNo();
+    };
+
+    // use a while loop because it is possible that while
+    // processing the files new ones can be added
+    size_t index = 0;
+    while (index < FileList.size()) {
+        FileEntry entry = FileList[index];
+        Writer::putNextEntry(entry.FileName.c_str());
+        indent = 0;
+        indBuf[0] = 0;
+
+        std::ostringstream buffer(std::ios::out | std::ios::binary);
+        setupZipEntryStream(buffer);
+        CurrentStream = &buffer;
+        try {
+            entry.Object->SaveDocFile(*this);
+        }
+        catch (...) {
+            CurrentStream = &ZipStream;
+            throw;
+        }
+        CurrentStream = &ZipStream;
+
+        std::string data = std::move(buffer).str();
+        auto policy = data.size() < minConcurrentDeflateSize ? std::launch::deferred
+                                                               : std::launch::async;
+        pending.push_back(std::async(policy, deflateEntry, entry.FileName, std::move(data), Level));
+        while (pending.size() > threads) {
+            writeNext();
+        }
+        index++;
+    }
+
+    while (!pending.empty()) {
+        writeNext();
+    }
+}
+
 ZipWriter::~ZipWriter()
 {
     ZipStream.close();
@@ -205,11 +205,16 @@ public:
     explicit ZipWriter(std::ostream&);
     ~ZipWriter() override;
 
+    /** Writes the files added with addFile()
+     * The files are serialised one after another but, unless the thread
+     * count is set to 1, deflated concurrently in memory. They are stored
+     * in the order they were added.
+     */
     void writeFiles() override;
 
     std::ostream& Stream() override
     {
-        return ZipStream;
+        return *CurrentStream;
     }
 
     void setComment(const char* str)
@@ -218,17 +223,43 @@ public:
     }
     void setLevel(int level)
     {
+        Level = level;
         ZipStream.setLevel(level);
     }
+    /** Sets the number of threads used by writeFiles()
+     * With more than one thread the files are deflated concurrently. 0 means
+     * one thread per core, the default of 1 writes the files one by one.
+     */
+    void setThreadCount(unsigned count)
+    {
+        ThreadCount = count;
+    }
     void putNextEntry(const char* filename, const char* objName = nullptr) override;
 
+    /** Start collecting the XML written to the current entry
+     *
+     * Until endBinaryXML() the XML is written into memory. Then it is added
+     * to the current entry as plain text, and to the new entry \a entryName in
+     * the encoding of encodeBinaryXML(). Readers that don't know the binary
+     * encoding keep using the plain XML entry.
+     */
+    void beginBinaryXML(const char* entryName);
+    void endBinaryXML();
+
     ZipWriter(const ZipWriter&) = delete;
     ZipWriter(ZipWriter&&) = delete;
     ZipWriter& operator=(const ZipWriter&) = delete;
     ZipWriter& operator=(ZipWriter&&) = delete;
 
 private:
+    void writeFilesSerial();
+
     zipios::ZipOutputStream ZipStream;
+    std::ostream* CurrentStream;
+    std::unique_ptr<std::ostringstream> XMLBuffer;
+    std::string BinaryEntry;
+    int Level {6};
+    unsigned ThreadCount {1};
 };
 
 /** The StringWriter class
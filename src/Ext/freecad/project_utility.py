@@ -51,7 +51,13 @@ def extractDocument(filename, outpath):
         output.close()
 
 def createDocument(filename, outpath):
-    """ Create project archive """
+    """ Create project archive
+
+    Only Document.xml, GuiDocument.xml and the files they reference are
+    packed. An extracted Document.fcbin, the optional binary copy of
+    Document.xml, is left out because FreeCAD would restore it instead of
+    the possibly edited Document.xml.
+    """
     files = getFilesList(filename)
     dirname = os.path.dirname(filename)
     guixml = os.path.join(dirname, "GuiDocument.xml")
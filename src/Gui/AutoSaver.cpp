@@ -184,6 +184,7 @@ void AutoSaver::saveDocument(const std::string& name, AutoSaveProperty& saver)
                 // So, always force binary format because ASCII
                 // is not reentrant. See PropertyPartShape::SaveDocFile
                 writer.setMode("BinaryBrep");
+                writer.setMode("BinaryElementMap");
 
                 writer.putNextEntry("Document.xml");
 
@@ -206,6 +207,8 @@ void AutoSaver::saveDocument(const std::string& name, AutoSaveProperty& saver)
                     Base::ZipWriter writer(file);
                     if (hGrp->GetBool("SaveBinaryBrep", true))
                         writer.setMode("BinaryBrep");
+                    if (hGrp->GetBool("SaveBinaryElementMap", true))
+                        writer.setMode("BinaryElementMap");
 
                     writer.setComment("AutoRecovery file");
                     writer.setLevel(1); // apparently the fastest compression
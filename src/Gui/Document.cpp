@@ -41,6 +41,15 @@
 # include <QTimer>
 # include <QStatusBar>
 # include <Inventor/actions/SoSearchAction.h>
+# include <Inventor/fields/SoMFColor.h>
+# include <Inventor/fields/SoMFFloat.h>
+# include <Inventor/fields/SoMFInt32.h>
+# include <Inventor/fields/SoMFUInt32.h>
+# include <Inventor/fields/SoMFVec2f.h>
+# include <Inventor/fields/SoMFVec3d.h>
+# include <Inventor/fields/SoMFVec3f.h>
+# include <Inventor/fields/SoSFFloat.h>
+# include <Inventor/lists/SoFieldList.h>
 # include <Inventor/nodes/SoSeparator.h>
 #endif
 
@@ -142,6 +151,7 @@ struct DocumentP
     Connection connectTransactionAppend;
     Connection connectTransactionRemove;
     Connection connectTouchedObject;
+    Connection connectMemoryReport;
     Connection connectChangePropertyEditor;
     Connection connectChangeDocument;
 
@@ -498,6 +508,8 @@ Document::Document(App::Document* pcDocument,Application * app)
         (std::bind(&Gui::Document::slotSkipRecompute, this, sp::_1, sp::_2));
     d->connectTouchedObject = pcDocument->signalTouchedObject.connect
         (std::bind(&Gui::Document::slotTouchedObject, this, sp::_1));
+    d->connectMemoryReport = pcDocument->signalMemoryReport.connect
+        (std::bind(&Gui::Document::slotMemoryReport, this, sp::_1, sp::_2));
 
     d->connectTransactionAppend = pcDocument->signalTransactionAppend.connect
         (std::bind(&Gui::Document::slotTransactionAppend, this, sp::_1, sp::_2));
@@ -516,6 +528,9 @@ Document::Document(App::Document* pcDocument,Application * app)
         d->_pcDocument->setUndoMode(1);
         // set the maximum stack size
         d->_pcDocument->setMaxUndoStackSize(hGrp->GetInt("MaxUndoSize",20));
+        // set the maximum size of the undo data, given in MB
+        d->_pcDocument->setUndoBudget(
+            static_cast<std::size_t>(hGrp->GetUnsigned("MaxUndoMemory", 0)) * 1024 * 1024);
     }
 
     d->_changeViewTouchDocument = hGrp->GetBool("ChangeViewProviderTouchDocument", true);
@@ -546,6 +561,7 @@ Document::~Document()
     d->connectTransactionAppend.disconnect();
     d->connectTransactionRemove.disconnect();
     d->connectTouchedObject.disconnect();
+    d->connectMemoryReport.disconnect();
     d->connectChangePropertyEditor.disconnect();
     d->connectChangeDocument.disconnect();
 
@@ -1184,6 +1200,55 @@ void Document::slotSkipRecompute(const App::Document& doc, const std::vector<App
     obj->recomputeFeature(true);
 }
 
+static std::size_t fieldMemSize(const SoField* field)
+{
+    // single value fields are counted with the node
+    if (!field->isOfType(SoMField::getClassTypeId()))
+        return 0;
+
+    std::size_t elementSize = sizeof(void*);
+    if (field->isOfType(SoMFVec3f::getClassTypeId()) || field->isOfType(SoMFColor::getClassTypeId()))
+        elementSize = sizeof(SbVec3f);
+    else if (field->isOfType(SoMFVec3d::getClassTypeId()))
+        elementSize = sizeof(SbVec3d);
+    else if (field->isOfType(SoMFVec2f::getClassTypeId()))
+        elementSize = sizeof(SbVec2f);
+    else if (field->isOfType(SoMFInt32::getClassTypeId())
+             || field->isOfType(SoMFUInt32::getClassTypeId())
+             || field->isOfType(SoMFFloat::getClassTypeId()))
+        elementSize = sizeof(int32_t);
+    return static_cast<const SoMField*>(field)->getNum() * elementSize;
+}
+
+static std::size_t sceneGraphMemSize(SoNode* node, std::set<const SoNode*>& visited)
+{
+    // nodes shared by several view providers, e.g. by links, are counted once
+    if (!node || !visited.insert(node).second)
+        return 0;
+
+    SoFieldList fields;
+    int count = node->getFields(fields);
+    std::size_t size = sizeof(SoNode) + count * sizeof(SoSFFloat);
+    for (int i = 0; i < count; ++i)
+        size += fieldMemSize(fields[i]);
+
+    if (node->isOfType(SoGroup::getClassTypeId())) {
+        auto group = static_cast<SoGroup*>(node);
+        for (int i = 0, n = group->getNumChildren(); i < n; ++i)
+            size += sceneGraphMemSize(group->getChild(i), visited);
+    }
+    return size;
+}
+
+void Document::slotMemoryReport(const App::Document&, App::MemoryReport& report)
+{
+    std::set<const SoNode*> visited;
+    for (const auto& [obj, vp] : d->_ViewProviderMap) {
+        if (auto usage = report.findObject(obj->getNameInDocument()))
+            usage->viewProvider += sceneGraphMemSize(vp->getRoot(), visited);
+    }
+}
+
 void Document::slotTouchedObject(const App::DocumentObject &Obj)
 {
     getMainWindow()->updateActions(true);
@@ -43,6 +43,7 @@ namespace App {
 class Document;
 class DocumentObject;
 class DocumentObjectGroup;
+class MemoryReport;
 class Property;
 class Transaction;
 }
@@ -93,6 +94,7 @@ protected:
     void slotRecomputed(const App::Document&);
     void slotSkipRecompute(const App::Document &doc, const std::vector<App::DocumentObject*> &objs);
     void slotTouchedObject(const App::DocumentObject &);
+    void slotMemoryReport(const App::Document&, App::MemoryReport&);
     void slotChangePropertyEditor(const App::Document&, const App::Property &);
     //@}
 
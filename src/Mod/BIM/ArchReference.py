@@ -385,6 +385,8 @@ class ArchReference:
         parts = {}
         materials = {}
         zdoc = zipfile.ZipFile(filename)
+        # Document.xml is always plain XML, even if the file also contains
+        # the binary copy Document.fcbin
         with zdoc.open("Document.xml") as docf:
             name = None
             label = None
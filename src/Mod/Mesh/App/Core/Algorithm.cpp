@@ -24,7 +24,10 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <atomic>
+#include <iterator>
 #include <limits>
+#include <thread>
 #endif
 
 #include <Base/Console.h>
@@ -32,7 +35,9 @@
 
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "BVH.h"
 #include "Elements.h"
+#include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "Triangulation.h"
@@ -143,6 +148,15 @@ bool MeshAlgorithm::NearestFacetOnRay(const Base::Vector3f& rclPt,
     return false;
 }
 
+bool MeshAlgorithm::NearestFacetOnRay(const Base::Vector3f& rclPt,
+                                      const Base::Vector3f& rclDir,
+                                      const MeshFacetBVH& rclBVH,
+                                      Base::Vector3f& rclRes,
+                                      FacetIndex& rulFacet) const
+{
+    return rclBVH.NearestFacetOnRay(rclPt, rclDir, rclRes, rulFacet);
+}
+
 bool MeshAlgorithm::NearestFacetOnRay(const Base::Vector3f& rclPt,
                                       const Base::Vector3f& rclDir,
                                       float fMaxSearchArea,
@@ -2168,3 +2182,272 @@ const Base::Vector3f& MeshRefNormalToPoints::operator[](PointIndex pos) const
 {
     return _norm[pos];
 }
+
+//----------------------------------------------------------------------------
+
+template<class Pairs>
+void MeshIndexAdjacency::Build(std::size_t numRows, std::size_t numItems, Pairs pairs)
+{
+    int threads = int(std::thread::hardware_concurrency());
+
+    // First pass: count the entries of each row
+    std::vector<std::atomic<std::size_t>> cursor(numRows);
+    auto countEntry = [&cursor](ElementIndex row, ElementIndex /*index*/) {
+        cursor[row].fetch_add(1, std::memory_order_relaxed);
+    };
+    MeshCore::parallel_for(
+        0,
+        numItems,
+        [&pairs, &countEntry](std::size_t item) {
+            pairs(item, countEntry);
+        },
+        threads);
+
+    _offsets.assign(numRows + 1, 0);
+    for (std::size_t row = 0; row < numRows; ++row) {
+        _offsets[row + 1] = _offsets[row] + cursor[row].load(std::memory_order_relaxed);
+        cursor[row].store(_offsets[row], std::memory_order_relaxed);
+    }
+
+    // Second pass: fill in the entries, their order within a row depends on the scheduling
+    _indices.resize(_offsets[numRows]);
+    auto fillEntry = [this, &cursor](ElementIndex row, ElementIndex index) {
+        _indices[cursor[row].fetch_add(1, std::memory_order_relaxed)] = index;
+    };
+    MeshCore::parallel_for(
+        0,
+        numItems,
+        [&pairs, &fillEntry](std::size_t item) {
+            pairs(item, fillEntry);
+        },
+        threads);
+
+    // Sort the rows and remove duplicates, keep the remaining size of each row
+    MeshCore::parallel_for(
+        0,
+        numRows,
+        [this, &cursor](std::size_t row) {
+            auto first = _indices.begin() + static_cast<std::ptrdiff_t>(_offsets[row]);
+            auto last = _indices.begin() + static_cast<std::ptrdiff_t>(_offsets[row + 1]);
+            std::sort(first, last);
+            auto size = static_cast<std::size_t>(std::unique(first, last) - first);
+            cursor[row].store(size, std::memory_order_relaxed);
+        },
+        threads);
+
+    // Close the gaps left by removed duplicates
+    std::size_t size = 0;
+    for (std::size_t row = 0; row < numRows; ++row) {
+        std::size_t first = _offsets[row];
+        std::size_t count = cursor[row].load(std::memory_order_relaxed);
+        if (size != first) {
+            std::copy_n(_indices.begin() + static_cast<std::ptrdiff_t>(first),
+                        count,
+                        _indices.begin() + static_cast<std::ptrdiff_t>(size));
+        }
+        _offsets[row] = size;
+        size += count;
+    }
+    _offsets[numRows] = size;
+    _indices.resize(size);
+    _indices.shrink_to_fit();
+}
+
+namespace
+{
+template<class Range>
+std::vector<ElementIndex> intersectRanges(const Range& range1, const MeshIndexRange& range2)
+{
+    std::vector<ElementIndex> intersection;
+    std::set_intersection(range1.begin(),
+                          range1.end(),
+                          range2.begin(),
+                          range2.end(),
+                          std::back_inserter(intersection));
+    return intersection;
+}
+
+void searchNeighbours(const MeshKernel& rclMesh,
+                      const MeshCompactPointToFacets& pt2f,
+                      FacetIndex index,
+                      const Base::Vector3f& rclCenter,
+                      float fMaxDist2,
+                      std::set<FacetIndex>& visited,
+                      MeshCollector& collect)
+{
+    if (visited.find(index) != visited.end()) {
+        return;
+    }
+
+    const MeshFacet& face = rclMesh.GetFacets()[index];
+    if (Base::DistanceP2(rclCenter, rclMesh.GetFacet(face).GetGravityPoint()) > fMaxDist2) {
+        return;
+    }
+
+    visited.insert(index);
+    collect.Append(rclMesh, index);
+    for (PointIndex ptIndex : face._aulPoints) {
+        for (FacetIndex j : pt2f[ptIndex]) {
+            searchNeighbours(rclMesh, pt2f, j, rclCenter, fMaxDist2, visited, collect);
+        }
+    }
+}
+}  // namespace
+
+void MeshCompactPointToFacets::Rebuild()
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    Build(_rclMesh.CountPoints(), rFacets.size(), [&rFacets](std::size_t index, auto&& add) {
+        for (PointIndex ptIndex : rFacets[index]._aulPoints) {
+            add(ptIndex, index);
+        }
+    });
+}
+
+Base::Vector3f MeshCompactPointToFacets::GetNormal(PointIndex pos) const
+{
+    Base::Vector3f normal;
+    MeshGeomFacet f;
+    for (FacetIndex it : (*this)[pos]) {
+        f = _rclMesh.GetFacet(it);
+        normal += f.Area() * f.GetNormal();
+    }
+
+    normal.Normalize();
+    return normal;
+}
+
+std::set<PointIndex> MeshCompactPointToFacets::NeighbourPoints(const std::vector<PointIndex>& pt,
+                                                               int level) const
+{
+    std::set<PointIndex> cp, nb, lp;
+    cp.insert(pt.begin(), pt.end());
+    lp.insert(pt.begin(), pt.end());
+    auto f_it = _rclMesh.GetFacets().begin();
+    for (int i = 0; i < level; i++) {
+        std::set<PointIndex> cur;
+        for (PointIndex it : lp) {
+            for (FacetIndex jt : (*this)[it]) {
+                for (PointIndex index : f_it[jt]._aulPoints) {
+                    if (cp.find(index) == cp.end() && nb.find(index) == nb.end()) {
+                        nb.insert(index);
+                        cur.insert(index);
+                    }
+                }
+            }
+        }
+
+        lp = cur;
+        if (lp.empty()) {
+            break;
+        }
+    }
+    return nb;
+}
+
+std::set<PointIndex> MeshCompactPointToFacets::NeighbourPoints(PointIndex pos) const
+{
+    std::set<PointIndex> p;
+    for (FacetIndex it : (*this)[pos]) {
+        for (PointIndex index : _rclMesh.GetFacets()[it]._aulPoints) {
+            if (index != pos) {
+                p.insert(index);
+            }
+        }
+    }
+
+    return p;
+}
+
+void MeshCompactPointToFacets::Neighbours(FacetIndex ulFacetInd,
+                                          float fMaxDist,
+                                          MeshCollector& collect) const
+{
+    std::set<FacetIndex> visited;
+    Base::Vector3f clCenter = _rclMesh.GetFacet(ulFacetInd).GetGravityPoint();
+    searchNeighbours(_rclMesh, *this, ulFacetInd, clCenter, fMaxDist * fMaxDist, visited, collect);
+}
+
+MeshFacetArray::_TConstIterator MeshCompactPointToFacets::GetFacet(FacetIndex index) const
+{
+    return _rclMesh.GetFacets().begin() + index;
+}
+
+std::vector<FacetIndex> MeshCompactPointToFacets::GetIndices(PointIndex pos1,
+                                                             PointIndex pos2) const
+{
+    return intersectRanges((*this)[pos1], (*this)[pos2]);
+}
+
+std::vector<FacetIndex>
+MeshCompactPointToFacets::GetIndices(PointIndex pos1, PointIndex pos2, PointIndex pos3) const
+{
+    return intersectRanges(GetIndices(pos1, pos2), (*this)[pos3]);
+}
+
+//----------------------------------------------------------------------------
+
+void MeshCompactFacetToFacets::Rebuild()
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    MeshCompactPointToFacets vertexFace(_rclMesh);
+    Build(rFacets.size(),
+          rFacets.size(),
+          [&rFacets, &vertexFace](std::size_t index, auto&& add) {
+              for (PointIndex ptIndex : rFacets[index]._aulPoints) {
+                  for (FacetIndex face : vertexFace[ptIndex]) {
+                      add(index, face);
+                  }
+              }
+          });
+}
+
+std::vector<FacetIndex> MeshCompactFacetToFacets::GetIndices(FacetIndex pos1,
+                                                             FacetIndex pos2) const
+{
+    return intersectRanges((*this)[pos1], (*this)[pos2]);
+}
+
+//----------------------------------------------------------------------------
+
+void MeshCompactPointToPoints::Rebuild()
+{
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    Build(_rclMesh.CountPoints(), rFacets.size(), [&rFacets](std::size_t index, auto&& add) {
+        const PointIndex* pts = rFacets[index]._aulPoints;
+        add(pts[0], pts[1]);
+        add(pts[0], pts[2]);
+        add(pts[1], pts[0]);
+        add(pts[1], pts[2]);
+        add(pts[2], pts[0]);
+        add(pts[2], pts[1]);
+    });
+}
+
+Base::Vector3f MeshCompactPointToPoints::GetNormal(PointIndex pos) const
+{
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    MeshCore::PlaneFit pf;
+    pf.AddPoint(rPoints[pos]);
+    for (PointIndex cv_it : (*this)[pos]) {
+        pf.AddPoint(rPoints[cv_it]);
+    }
+
+    pf.Fit();
+
+    Base::Vector3f normal = pf.GetNormal();
+    normal.Normalize();
+    return normal;
+}
+
+float MeshCompactPointToPoints::GetAverageEdgeLength(PointIndex index) const
+{
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    float len = 0.0F;
+    MeshIndexRange n = (*this)[index];
+    const Base::Vector3f& p = rPoints[index];
+    for (PointIndex it : n) {
+        len += Base::Distance(p, rPoints[it]);
+    }
+    return (len / static_cast<float>(n.size()));
+}
@@ -23,6 +23,8 @@
 #ifndef MESHALGORITHM_H
 #define MESHALGORITHM_H
 
+#include <algorithm>
+#include <cstddef>
 #include <map>
 #include <set>
 #include <vector>
@@ -46,6 +48,7 @@ class MeshGeomFacet;
 class MeshGeomEdge;
 class MeshKernel;
 class MeshFacetGrid;
+class MeshFacetBVH;
 class MeshFacetArray;
 class MeshRefPointToFacets;
 class AbstractPolygonTriangulator;
@@ -99,6 +102,19 @@ public:
                            const MeshFacetGrid& rclGrid,
                            Base::Vector3f& rclRes,
                            FacetIndex& rulFacet) const;
+    /**
+     * Searches for the nearest facet to the ray defined by
+     * (\a rclPt, \a rclDir).
+     * The point \a rclRes holds the intersection point with the ray and the
+     * nearest facet with index \a rulFacet.
+     * \note This method uses the bounding volume hierarchy \a rclBVH. Unlike the grid
+     * version it treats the ray as a line and also finds facets behind \a rclPt.
+     */
+    bool NearestFacetOnRay(const Base::Vector3f& rclPt,
+                           const Base::Vector3f& rclDir,
+                           const MeshFacetBVH& rclBVH,
+                           Base::Vector3f& rclRes,
+                           FacetIndex& rulFacet) const;
     /**
      * Searches for the nearest facet to the ray defined by
      * (\a rclPt, \a rclDir).
@@ -638,6 +654,174 @@ private:
     std::vector<Base::Vector3f> _norm;
 };
 
+/**
+ * The MeshIndexRange is a read-only view of the sorted indices that a MeshIndexAdjacency
+ * stores for one element. It offers the part of the std::set interface that is used on the
+ * sets of MeshRefPointToFacets and friends.
+ */
+class MeshIndexRange
+{
+public:
+    using value_type = ElementIndex;
+    using const_iterator = const ElementIndex*;
+    using iterator = const_iterator;
+
+    MeshIndexRange(const ElementIndex* first, const ElementIndex* last)
+        : _first(first)
+        , _last(last)
+    {}
+
+    const_iterator begin() const
+    {
+        return _first;
+    }
+    const_iterator end() const
+    {
+        return _last;
+    }
+    std::size_t size() const
+    {
+        return static_cast<std::size_t>(_last - _first);
+    }
+    bool empty() const
+    {
+        return _first == _last;
+    }
+    ElementIndex operator[](std::size_t pos) const
+    {
+        return _first[pos];
+    }
+    const_iterator find(ElementIndex index) const
+    {
+        const_iterator it = std::lower_bound(_first, _last, index);
+        return (it != _last && *it == index) ? it : _last;
+    }
+    std::size_t count(ElementIndex index) const
+    {
+        return find(index) != _last ? 1 : 0;
+    }
+
+private:
+    const ElementIndex* _first;
+    const ElementIndex* _last;
+};
+
+/**
+ * The MeshIndexAdjacency stores a sorted list of unique indices per element in compressed
+ * sparse row format, i.e. a single index array plus the offset of each element into it.
+ * Unlike a std::vector<std::set<>> it does not allocate a tree node per entry, but it cannot
+ * be modified after it has been built.
+ */
+class MeshExport MeshIndexAdjacency
+{
+public:
+    MeshIndexRange operator[](ElementIndex pos) const
+    {
+        return {_indices.data() + _offsets[pos], _indices.data() + _offsets[pos + 1]};
+    }
+    /// Returns the number of elements
+    std::size_t size() const
+    {
+        return _offsets.empty() ? 0 : _offsets.size() - 1;
+    }
+    void clear()
+    {
+        _offsets.clear();
+        _indices.clear();
+    }
+
+protected:
+    /**
+     * Builds \a numRows rows in two parallel passes over \a numItems items. For each item
+     * \a pairs(item, add) calls add(row, index) for all entries the item contributes to.
+     * The first pass counts the entries of each row, the second one fills them in.
+     */
+    template<class Pairs>
+    void Build(std::size_t numRows, std::size_t numItems, Pairs pairs);
+
+private:
+    std::vector<std::size_t> _offsets;
+    std::vector<ElementIndex> _indices;
+};
+
+/**
+ * The MeshCompactPointToFacets is the compact counterpart of MeshRefPointToFacets. It
+ * needs a fraction of the memory and is built in parallel, but it cannot be modified.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshCompactPointToFacets: public MeshIndexAdjacency
+{
+public:
+    /// Construction
+    explicit MeshCompactPointToFacets(const MeshKernel& rclM)
+        : _rclMesh(rclM)
+    {
+        Rebuild();
+    }
+
+    /// Rebuilds up data structure
+    void Rebuild();
+    std::vector<FacetIndex> GetIndices(PointIndex, PointIndex) const;
+    std::vector<FacetIndex> GetIndices(PointIndex, PointIndex, PointIndex) const;
+    MeshFacetArray::_TConstIterator GetFacet(FacetIndex) const;
+    std::set<PointIndex> NeighbourPoints(const std::vector<PointIndex>&, int level) const;
+    std::set<PointIndex> NeighbourPoints(PointIndex) const;
+    void Neighbours(FacetIndex ulFacetInd, float fMaxDist, MeshCollector& collect) const;
+    Base::Vector3f GetNormal(PointIndex) const;
+
+private:
+    const MeshKernel& _rclMesh; /**< The mesh kernel. */
+};
+
+/**
+ * The MeshCompactFacetToFacets is the compact counterpart of MeshRefFacetToFacets.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshCompactFacetToFacets: public MeshIndexAdjacency
+{
+public:
+    /// Construction
+    explicit MeshCompactFacetToFacets(const MeshKernel& rclM)
+        : _rclMesh(rclM)
+    {
+        Rebuild();
+    }
+    /// Rebuilds up data structure
+    void Rebuild();
+
+    /// Returns an array of common facets of the passed facet indexes.
+    std::vector<FacetIndex> GetIndices(FacetIndex, FacetIndex) const;
+
+private:
+    const MeshKernel& _rclMesh; /**< The mesh kernel. */
+};
+
+/**
+ * The MeshCompactPointToPoints is the compact counterpart of MeshRefPointToPoints.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshCompactPointToPoints: public MeshIndexAdjacency
+{
+public:
+    /// Construction
+    explicit MeshCompactPointToPoints(const MeshKernel& rclM)
+        : _rclMesh(rclM)
+    {
+        Rebuild();
+    }
+
+    /// Rebuilds up data structure
+    void Rebuild();
+    Base::Vector3f GetNormal(PointIndex) const;
+    float GetAverageEdgeLength(PointIndex) const;
+
+private:
+    const MeshKernel& _rclMesh; /**< The mesh kernel. */
+};
+
 }  // namespace MeshCore
 
 #endif  // MESH_ALGORITHM_H
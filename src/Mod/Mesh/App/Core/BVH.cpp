@@ -0,0 +1,459 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <queue>
+#include <thread>
+#endif
+
+#include "BVH.h"
+#include "Elements.h"
+#include "Functional.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+constexpr int numBins = 16;
+constexpr std::uint32_t noParent = std::numeric_limits<std::uint32_t>::max();
+
+float surfaceArea(const Base::BoundBox3f& box)
+{
+    if (!box.IsValid()) {
+        return 0.0F;
+    }
+    float dx = box.LengthX();
+    float dy = box.LengthY();
+    float dz = box.LengthZ();
+    return 2.0F * (dx * dy + dy * dz + dz * dx);
+}
+
+// Intersects the line (base, dir) with the box. The parameters of the entry and exit point are
+// returned in t0 and t1 and may be negative.
+bool intersectLine(const Base::BoundBox3f& box,
+                   const Base::Vector3f& base,
+                   const Base::Vector3f& dir,
+                   float& t0,
+                   float& t1)
+{
+    const std::array<float, 3> bmin {box.MinX, box.MinY, box.MinZ};
+    const std::array<float, 3> bmax {box.MaxX, box.MaxY, box.MaxZ};
+    t0 = -std::numeric_limits<float>::max();
+    t1 = std::numeric_limits<float>::max();
+    for (unsigned short axis = 0; axis < 3; axis++) {
+        float org = base[axis];
+        float dif = dir[axis];
+        if (std::fabs(dif) < std::numeric_limits<float>::epsilon()) {
+            // parallel to the slab
+            if (org < bmin[axis] || org > bmax[axis]) {
+                return false;
+            }
+            continue;
+        }
+        float ta = (bmin[axis] - org) / dif;
+        float tb = (bmax[axis] - org) / dif;
+        if (ta > tb) {
+            std::swap(ta, tb);
+        }
+        t0 = std::max(t0, ta);
+        t1 = std::min(t1, tb);
+        if (t0 > t1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Returns the lowest distance from base to the points of the box on the line (base, dir)
+// or a negative value if the line misses the box
+float distanceOnLine(const Base::BoundBox3f& box,
+                     const Base::Vector3f& base,
+                     const Base::Vector3f& dir)
+{
+    float t0 {};
+    float t1 {};
+    if (!intersectLine(box, base, dir, t0, t1)) {
+        return -1.0F;
+    }
+    if (t0 <= 0.0F && t1 >= 0.0F) {
+        return 0.0F;
+    }
+    return std::min(std::fabs(t0), std::fabs(t1));
+}
+
+// Returns the squared distance from the point to the box, zero if it's inside
+float distanceToBox2(const Base::BoundBox3f& box, const Base::Vector3f& pnt)
+{
+    auto outside = [](float val, float min, float max) {
+        return val < min ? min - val : (val > max ? val - max : 0.0F);
+    };
+    float dx = outside(pnt.x, box.MinX, box.MaxX);
+    float dy = outside(pnt.y, box.MinY, box.MaxY);
+    float dz = outside(pnt.z, box.MinZ, box.MaxZ);
+    return dx * dx + dy * dy + dz * dz;
+}
+
+}  // namespace
+
+MeshFacetBVH::MeshFacetBVH(const MeshKernel& mesh, unsigned int maxLeafSize)
+    : _mesh(mesh)
+    , _maxLeafSize(std::max(maxLeafSize, 1U))
+{
+    Build();
+}
+
+void MeshFacetBVH::Rebuild()
+{
+    Build();
+}
+
+void MeshFacetBVH::Build()
+{
+    _nodes.clear();
+    _facets.clear();
+
+    const MeshPointArray& points = _mesh.GetPoints();
+    const MeshFacetArray& facets = _mesh.GetFacets();
+    std::size_t numFacets = facets.size();
+    if (numFacets == 0) {
+        return;
+    }
+
+    std::vector<Base::BoundBox3f> boxes(numFacets);
+    std::vector<Base::Vector3f> centers(numFacets);
+    int threads = int(std::thread::hardware_concurrency());
+    MeshCore::parallel_for(
+        0,
+        numFacets,
+        [&](std::size_t index) {
+            const MeshFacet& face = facets[index];
+            Base::BoundBox3f box;
+            box.Add(points[face._aulPoints[0]]);
+            box.Add(points[face._aulPoints[1]]);
+            box.Add(points[face._aulPoints[2]]);
+            boxes[index] = box;
+            centers[index] = box.GetCenter();
+        },
+        threads);
+
+    _facets.resize(numFacets);
+    std::iota(_facets.begin(), _facets.end(), FacetIndex(0));
+    _nodes.reserve(2 * numFacets / _maxLeafSize + 1);
+
+    // The boxes of the nodes are slightly enlarged so that the rounding errors of
+    // the slab test cannot reject a facet that is hit at its border
+    float eps = _mesh.GetBoundBox().CalcDiagonalLength() * 1.0e-6F;
+
+    struct Task
+    {
+        std::uint32_t begin;
+        std::uint32_t end;
+        std::uint32_t parent;
+    };
+
+    struct Bin
+    {
+        Base::BoundBox3f box;
+        std::uint32_t count {0};
+    };
+
+    // The left child of a node is always built directly after its parent, so only the
+    // parent of a right child must be told where it has been placed
+    std::vector<Task> tasks;
+    tasks.push_back({0, std::uint32_t(numFacets), noParent});
+    while (!tasks.empty()) {
+        Task task = tasks.back();
+        tasks.pop_back();
+
+        auto nodeIndex = std::uint32_t(_nodes.size());
+        if (task.parent != noParent) {
+            _nodes[task.parent].index = nodeIndex;
+        }
+
+        Node node;
+        Base::BoundBox3f centerBox;
+        for (std::uint32_t i = task.begin; i < task.end; i++) {
+            node.box.Add(boxes[_facets[i]]);
+            centerBox.Add(centers[_facets[i]]);
+        }
+        node.box.Enlarge(eps);
+
+        std::uint32_t count = task.end - task.begin;
+        std::uint32_t mid = task.begin;
+        if (count > _maxLeafSize) {
+            // binned surface area heuristic, the constant costs are the same for all
+            // splits and thus omitted
+            float bestCost = std::numeric_limits<float>::max();
+            int bestAxis = -1;
+            int bestBin = 0;
+            const std::array<float, 3> cmin {centerBox.MinX, centerBox.MinY, centerBox.MinZ};
+            const std::array<float, 3> clen {centerBox.LengthX(),
+                                             centerBox.LengthY(),
+                                             centerBox.LengthZ()};
+            for (unsigned short axis = 0; axis < 3; axis++) {
+                if (clen[axis] <= 0.0F) {
+                    continue;
+                }
+
+                float scale = float(numBins) / clen[axis];
+                auto binOf = [&](FacetIndex facet) {
+                    int bin = int((centers[facet][axis] - cmin[axis]) * scale);
+                    return std::clamp(bin, 0, numBins - 1);
+                };
+
+                std::array<Bin, numBins> bins;
+                for (std::uint32_t i = task.begin; i < task.end; i++) {
+                    Bin& bin = bins[binOf(_facets[i])];
+                    bin.box.Add(boxes[_facets[i]]);
+                    bin.count++;
+                }
+
+                std::array<float, numBins> rightCost {};
+                Base::BoundBox3f rightBox;
+                std::uint32_t rightCount = 0;
+                for (int i = numBins - 1; i > 0; i--) {
+                    rightBox.Add(bins[i].box);
+                    rightCount += bins[i].count;
+                    rightCost[i] = surfaceArea(rightBox) * float(rightCount);
+                }
+
+                Base::BoundBox3f leftBox;
+                std::uint32_t leftCount = 0;
+                for (int i = 0; i < numBins - 1; i++) {
+                    leftBox.Add(bins[i].box);
+                    leftCount += bins[i].count;
+                    if (leftCount == 0 || leftCount == count) {
+                        continue;
+                    }
+                    float cost = surfaceArea(leftBox) * float(leftCount) + rightCost[i + 1];
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        bestAxis = axis;
+                        bestBin = i;
+                    }
+                }
+            }
+
+            if (bestAxis >= 0) {
+                auto axis = static_cast<unsigned short>(bestAxis);
+                float scale = float(numBins) / clen[axis];
+                auto it = std::partition(_facets.begin() + task.begin,
+                                         _facets.begin() + task.end,
+                                         [&](FacetIndex facet) {
+                                             int bin = int((centers[facet][axis] - cmin[axis])
+                                                           * scale);
+                                             return std::clamp(bin, 0, numBins - 1) <= bestBin;
+                                         });
+                mid = std::uint32_t(it - _facets.begin());
+            }
+        }
+
+        if (mid == task.begin || mid == task.end) {
+            // small enough or all facet centers coincide
+            node.index = task.begin;
+            node.count = count;
+            _nodes.push_back(node);
+        }
+        else {
+            _nodes.push_back(node);
+            tasks.push_back({mid, task.end, nodeIndex});
+            tasks.push_back({task.begin, mid, noParent});
+        }
+    }
+}
+
+bool MeshFacetBVH::NearestFacetOnRay(const Base::Vector3f& rclPt,
+                                     const Base::Vector3f& rclDir,
+                                     Base::Vector3f& rclRes,
+                                     FacetIndex& rulFacet,
+                                     float fMaxAngle) const
+{
+    float len = rclDir.Length();
+    if (_nodes.empty() || len == 0.0F) {
+        return false;
+    }
+    Base::Vector3f dir = rclDir / len;
+
+    bool found = false;
+    float minDist = std::numeric_limits<float>::max();
+
+    // visit the nearer child first so that the farther one can mostly be skipped
+    std::vector<std::pair<std::uint32_t, float>> stack;
+    float rootDist = distanceOnLine(_nodes[0].box, rclPt, dir);
+    if (rootDist >= 0.0F) {
+        stack.emplace_back(0, rootDist);
+    }
+    while (!stack.empty()) {
+        auto [index, dist] = stack.back();
+        stack.pop_back();
+        if (dist > minDist) {
+            continue;
+        }
+
+        const Node& node = _nodes[index];
+        if (node.count > 0) {
+            Base::Vector3f clRes;
+            for (std::uint32_t i = node.index; i < node.index + node.count; i++) {
+                MeshGeomFacet facet = _mesh.GetFacet(_facets[i]);
+                if (facet.Foraminate(rclPt, rclDir, clRes, fMaxAngle)) {
+                    float facetDist = Base::Distance(clRes, rclPt);
+                    if (facetDist < minDist) {
+                        found = true;
+                        minDist = facetDist;
+                        rclRes = clRes;
+                        rulFacet = _facets[i];
+                    }
+                }
+            }
+        }
+        else {
+            std::uint32_t left = index + 1;
+            std::uint32_t right = node.index;
+            float leftDist = distanceOnLine(_nodes[left].box, rclPt, dir);
+            float rightDist = distanceOnLine(_nodes[right].box, rclPt, dir);
+            if (leftDist > rightDist) {
+                std::swap(left, right);
+                std::swap(leftDist, rightDist);
+            }
+            if (rightDist >= 0.0F && rightDist <= minDist) {
+                stack.emplace_back(right, rightDist);
+            }
+            if (leftDist >= 0.0F && leftDist <= minDist) {
+                stack.emplace_back(left, leftDist);
+            }
+        }
+    }
+
+    return found;
+}
+
+std::vector<MeshFacetBVH::RayHit>
+MeshFacetBVH::NearestFacetsOnRays(const std::vector<Ray>& rays, float fMaxAngle) const
+{
+    std::vector<RayHit> hits(rays.size());
+    int threads = int(std::thread::hardware_concurrency());
+    MeshCore::parallel_for(
+        0,
+        rays.size(),
+        [&](std::size_t index) {
+            RayHit& hit = hits[index];
+            if (!NearestFacetOnRay(rays[index].first,
+                                   rays[index].second,
+                                   hit.point,
+                                   hit.facet,
+                                   fMaxAngle)) {
+                hit.facet = FACET_INDEX_MAX;
+            }
+        },
+        threads,
+        64);
+    return hits;
+}
+
+FacetIndex MeshFacetBVH::NearestFacet(const Base::Vector3f& rclPt, float fMaxDist) const
+{
+    auto nearest = NearestFacets(rclPt, 1, fMaxDist);
+    return nearest.empty() ? FACET_INDEX_MAX : nearest.front().first;
+}
+
+std::vector<std::pair<FacetIndex, float>>
+MeshFacetBVH::NearestFacets(const Base::Vector3f& rclPt, std::size_t k, float fMaxDist) const
+{
+    using Candidate = std::pair<float, FacetIndex>;
+    // max-heap of the best candidates so far, the top is the farthest one
+    std::priority_queue<Candidate> best;
+    auto bound = [&]() {
+        return best.size() < k ? fMaxDist : best.top().first;
+    };
+
+    std::vector<std::pair<std::uint32_t, float>> stack;
+    if (!_nodes.empty() && k > 0) {
+        stack.emplace_back(0, std::sqrt(distanceToBox2(_nodes[0].box, rclPt)));
+    }
+    while (!stack.empty()) {
+        auto [index, dist] = stack.back();
+        stack.pop_back();
+        if (dist > bound()) {
+            continue;
+        }
+
+        const Node& node = _nodes[index];
+        if (node.count > 0) {
+            for (std::uint32_t i = node.index; i < node.index + node.count; i++) {
+                float facetDist = _mesh.GetFacet(_facets[i]).DistanceToPoint(rclPt);
+                if (facetDist <= bound()) {
+                    best.emplace(facetDist, _facets[i]);
+                    if (best.size() > k) {
+                        best.pop();
+                    }
+                }
+            }
+        }
+        else {
+            std::uint32_t left = index + 1;
+            std::uint32_t right = node.index;
+            float leftDist = std::sqrt(distanceToBox2(_nodes[left].box, rclPt));
+            float rightDist = std::sqrt(distanceToBox2(_nodes[right].box, rclPt));
+            if (leftDist > rightDist) {
+                std::swap(left, right);
+                std::swap(leftDist, rightDist);
+            }
+            stack.emplace_back(right, rightDist);
+            stack.emplace_back(left, leftDist);
+        }
+    }
+
+    std::vector<std::pair<FacetIndex, float>> result(best.size());
+    for (auto it = result.rbegin(); it != result.rend(); ++it) {
+        *it = {best.top().second, best.top().first};
+        best.pop();
+    }
+    return result;
+}
+
+void MeshFacetBVH::Inside(const Base::BoundBox3f& rclBB,
+                          std::vector<FacetIndex>& raulFacets) const
+{
+    std::vector<FacetIndex> facets;
+    Collect(
+        [&rclBB](const Base::BoundBox3f& box) {
+            return box && rclBB;
+        },
+        facets);
+    for (FacetIndex index : facets) {
+        if (_mesh.GetFacet(index).GetBoundBox() && rclBB) {
+            raulFacets.push_back(index);
+        }
+    }
+}
+
+Base::BoundBox3f MeshFacetBVH::GetBoundBox() const
+{
+    return _nodes.empty() ? Base::BoundBox3f() : _nodes.front().box;
+}
@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef MESH_BVH_H
+#define MESH_BVH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <Base/BoundBox.h>
+
+#include "Definitions.h"
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshFacetBVH is a bounding volume hierarchy over the facets of a mesh. It is an
+ * alternative to MeshFacetGrid for ray and nearest facet queries. The grid cells have a
+ * fixed size, so they hold thousands of facets on meshes with very uneven facet sizes,
+ * while the nodes of the hierarchy adapt to the local facet density.
+ *
+ * The hierarchy is built with the surface area heuristic (SAH) on binned facet centers.
+ * All queries are const and can run from several threads at the same time.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshFacetBVH
+{
+public:
+    /// A ray given by its base point and direction
+    using Ray = std::pair<Base::Vector3f, Base::Vector3f>;
+
+    /// The result of a ray query, facet is FACET_INDEX_MAX if no facet was hit
+    struct RayHit
+    {
+        FacetIndex facet {FACET_INDEX_MAX};
+        Base::Vector3f point;
+    };
+
+    /// Construction
+    explicit MeshFacetBVH(const MeshKernel& mesh, unsigned int maxLeafSize = 4);
+
+    /// Rebuilds the data structure
+    void Rebuild();
+
+    /**
+     * Searches for the nearest facet to the ray defined by (\a rclPt, \a rclDir), like
+     * MeshAlgorithm::NearestFacetOnRay(). The ray is treated as a line, so facets behind
+     * \a rclPt are found as well. The point \a rclRes holds the intersection point with the
+     * nearest facet with index \a rulFacet. The angle between the ray and the facet normal
+     * must not be higher than \a fMaxAngle.
+     */
+    bool NearestFacetOnRay(const Base::Vector3f& rclPt,
+                           const Base::Vector3f& rclDir,
+                           Base::Vector3f& rclRes,
+                           FacetIndex& rulFacet,
+                           float fMaxAngle = Mathf::PI) const;
+    /**
+     * Searches the nearest facet for each ray of \a rays. The rays are distributed over all
+     * available threads.
+     */
+    std::vector<RayHit> NearestFacetsOnRays(const std::vector<Ray>& rays,
+                                            float fMaxAngle = Mathf::PI) const;
+    /**
+     * Returns the index of the facet nearest to \a rclPt, like
+     * MeshFacetGrid::SearchNearestFromPoint(). Only facets within \a fMaxDist are considered,
+     * FACET_INDEX_MAX is returned if there is none.
+     */
+    FacetIndex NearestFacet(const Base::Vector3f& rclPt,
+                            float fMaxDist = std::numeric_limits<float>::max()) const;
+    /**
+     * Returns the up to \a k facets nearest to \a rclPt together with their distances, sorted
+     * by increasing distance. Only facets within \a fMaxDist are considered.
+     */
+    std::vector<std::pair<FacetIndex, float>>
+    NearestFacets(const Base::Vector3f& rclPt,
+                  std::size_t k,
+                  float fMaxDist = std::numeric_limits<float>::max()) const;
+    /// Collects the facets whose bounding box intersects \a rclBB
+    void Inside(const Base::BoundBox3f& rclBB, std::vector<FacetIndex>& raulFacets) const;
+    /**
+     * Collects the facets of all leaves whose bounding box is accepted by \a accept. A node
+     * whose bounding box is rejected is skipped together with its children.
+     */
+    template<class Pred>
+    void Collect(Pred accept, std::vector<FacetIndex>& raulFacets) const;
+
+    /// Returns the bounding box of the whole mesh
+    Base::BoundBox3f GetBoundBox() const;
+    /// Returns the number of nodes of the hierarchy
+    std::size_t CountNodes() const
+    {
+        return _nodes.size();
+    }
+
+private:
+    struct Node
+    {
+        Base::BoundBox3f box;
+        /// leaves: position of the first facet in _facets, inner nodes: index of the right child
+        std::uint32_t index {0};
+        /// number of facets of a leaf, zero for inner nodes whose left child follows the node
+        std::uint32_t count {0};
+    };
+
+    void Build();
+
+    const MeshKernel& _mesh; /**< The mesh kernel. */
+    unsigned int _maxLeafSize;
+    std::vector<Node> _nodes;
+    std::vector<FacetIndex> _facets;
+};
+
+template<class Pred>
+void MeshFacetBVH::Collect(Pred accept, std::vector<FacetIndex>& raulFacets) const
+{
+    std::vector<std::uint32_t> stack;
+    if (!_nodes.empty()) {
+        stack.push_back(0);
+    }
+    while (!stack.empty()) {
+        std::uint32_t index = stack.back();
+        stack.pop_back();
+        const Node& node = _nodes[index];
+        if (!accept(node.box)) {
+            continue;
+        }
+        if (node.count > 0) {
+            raulFacets.insert(raulFacets.end(),
+                              _facets.begin() + node.index,
+                              _facets.begin() + node.index + node.count);
+        }
+        else {
+            stack.push_back(node.index);
+            stack.push_back(index + 1);
+        }
+    }
+}
+
+}  // namespace MeshCore
+
+#endif  // MESH_BVH_H
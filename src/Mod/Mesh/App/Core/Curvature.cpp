@@ -70,7 +70,7 @@ MeshCurvature::MeshCurvature(const MeshKernel& kernel, std::vector<FacetIndex> s
 void MeshCurvature::ComputePerFace(bool parallel)
 {
     myCurvature.clear();
-    MeshRefPointToFacets search(myKernel);
+    MeshCompactPointToFacets search(myKernel);
     FacetCurvature face(myKernel, search, myRadius, myMinPoints);
 
     if (!parallel) {
@@ -130,8 +130,8 @@ void MeshCurvature::ComputePerVertex()
     // get all points
     const MeshPointArray& pts = myKernel.GetPoints();
 
-    MeshCore::MeshRefPointToFacets pt2f(myKernel);
-    MeshCore::MeshRefPointToPoints pt2p(myKernel);
+    MeshCore::MeshCompactPointToFacets pt2f(myKernel);
+    MeshCore::MeshCompactPointToPoints pt2p(myKernel);
     unsigned long numPoints = myKernel.CountPoints();
 
     myCurvature.clear();
@@ -165,8 +165,8 @@ void MeshCurvature::ComputePerVertex()
 
         int iV0 = i;
         int iV1;
-        const std::set<unsigned long>& nb = pt2p[i];
-        for (std::set<unsigned long>::const_iterator it = nb.begin(); it != nb.end(); ++it) {
+        MeshCore::MeshIndexRange nb = pt2p[i];
+        for (MeshCore::MeshIndexRange::const_iterator it = nb.begin(); it != nb.end(); ++it) {
             iV1 = *it;
 
             // Compute edge from V0 to V1, project to tangent plane of vertex,
@@ -373,7 +373,7 @@ private:
 // --------------------------------------------------------
 
 FacetCurvature::FacetCurvature(const MeshKernel& kernel,
-                               const MeshRefPointToFacets& search,
+                               const MeshCompactPointToFacets& search,
                                float r,
                                unsigned long pt)
     : myKernel(kernel)
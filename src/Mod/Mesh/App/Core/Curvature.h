@@ -31,7 +31,7 @@ namespace MeshCore
 {
 
 class MeshKernel;
-class MeshRefPointToFacets;
+class MeshCompactPointToFacets;
 
 /** Curvature information. */
 struct MeshExport CurvatureInfo
@@ -44,14 +44,14 @@ class MeshExport FacetCurvature
 {
 public:
     FacetCurvature(const MeshKernel& kernel,
-                   const MeshRefPointToFacets& search,
+                   const MeshCompactPointToFacets& search,
                    float,
                    unsigned long);
     CurvatureInfo Compute(FacetIndex index) const;
 
 private:
     const MeshKernel& myKernel;
-    const MeshRefPointToFacets& mySearch;
+    const MeshCompactPointToFacets& mySearch;
     unsigned long myMinPoints;
     float myRadius;
 };
@@ -22,135 +22,356 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
+#include <array>
 #include <limits>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
 #endif
 
 #include "Decimation.h"
+#include "Functional.h"
 #include "MeshKernel.h"
 #include "Simplify.h"
 
 
 using namespace MeshCore;
 
-MeshSimplify::MeshSimplify(MeshKernel& mesh)
-    : myKernel(mesh)
-{}
+namespace
+{
 
-void MeshSimplify::simplify(float tolerance, float reduction)
+// Meshes are not split into clusters smaller than this to use more threads
+constexpr std::size_t minClusterSize = 20000;
+constexpr std::size_t clustersPerThread = 4;
+
+// Number of triangle rings around the cluster boundaries that are simplified in the final pass
+constexpr int bandRings = 3;
+
+struct Patch
 {
-    Simplify alg;
+    std::vector<Base::Vector3f> points;
+    std::vector<std::array<int, 3>> triangles;
+};
 
-    const MeshPointArray& points = myKernel.GetPoints();
-    for (std::size_t i = 0; i < points.size(); i++) {
+/**
+ * Splits the triangles of \a mesh at the median of their centers until each cluster has at
+ * most \a maxSize triangles.
+ */
+std::vector<std::vector<int>> splitIntoClusters(const Patch& mesh, std::size_t maxSize, int threads)
+{
+    std::size_t count = mesh.triangles.size();
+    std::vector<Base::Vector3f> centers(count);
+    MeshCore::parallel_for(
+        0,
+        count,
+        [&](std::size_t index) {
+            const auto& tria = mesh.triangles[index];
+            centers[index] =
+                (mesh.points[tria[0]] + mesh.points[tria[1]] + mesh.points[tria[2]]) / 3.0F;
+        },
+        threads);
+
+    std::vector<int> order(count);
+    std::iota(order.begin(), order.end(), 0);
+
+    // All ranges of a level are split at the same time
+    using Range = std::pair<std::size_t, std::size_t>;
+    std::vector<std::vector<int>> clusters;
+    std::vector<Range> ranges {{0, count}};
+    while (!ranges.empty()) {
+        auto leaves = std::partition(ranges.begin(), ranges.end(), [maxSize](const Range& range) {
+            return range.second - range.first > maxSize;
+        });
+        for (auto it = leaves; it != ranges.end(); ++it) {
+            clusters.emplace_back(order.begin() + it->first, order.begin() + it->second);
+        }
+        ranges.erase(leaves, ranges.end());
+
+        std::vector<Range> next(2 * ranges.size());
+        MeshCore::parallel_for(
+            0,
+            ranges.size(),
+            [&](std::size_t index) {
+                auto [first, last] = ranges[index];
+                Base::BoundBox3f box;
+                for (std::size_t i = first; i < last; i++) {
+                    box.Add(centers[order[i]]);
+                }
+                unsigned short axis = 0;
+                if (box.LengthY() > box.LengthX()) {
+                    axis = 1;
+                }
+                if (box.LengthZ() > std::max(box.LengthX(), box.LengthY())) {
+                    axis = 2;
+                }
+
+                std::size_t mid = first + (last - first) / 2;
+                std::nth_element(order.begin() + first,
+                                 order.begin() + mid,
+                                 order.begin() + last,
+                                 [&centers, axis](int lhs, int rhs) {
+                                     return centers[lhs][axis] < centers[rhs][axis];
+                                 });
+                next[2 * index] = {first, mid};
+                next[2 * index + 1] = {mid, last};
+            },
+            threads,
+            1);
+        ranges.swap(next);
+    }
+
+    return clusters;
+}
+
+/**
+ * Simplifies the triangles \a facets of \a mesh. Vertices marked in \a locked are neither moved
+ * nor removed. The id of the returned vertices is the index in \a mesh.
+ */
+Simplify simplifyPatch(const Patch& mesh,
+                       const std::vector<int>& facets,
+                       const std::vector<char>& locked,
+                       int targetSize,
+                       double tolerance)
+{
+    std::vector<int> ids;
+    ids.reserve(facets.size() * 3);
+    for (int index : facets) {
+        const auto& tria = mesh.triangles[index];
+        ids.insert(ids.end(), tria.begin(), tria.end());
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+    Simplify alg;
+    alg.vertices.reserve(ids.size());
+    for (int id : ids) {
         Simplify::Vertex v;
         v.tstart = 0;
         v.tcount = 0;
         v.border = 0;
-        v.p = points[i];
+        v.p = mesh.points[id];
+        v.locked = locked.empty() ? 0 : locked[id];
+        v.id = id;
         alg.vertices.push_back(v);
     }
 
-    const MeshFacetArray& facets = myKernel.GetFacets();
-    for (std::size_t i = 0; i < facets.size(); i++) {
+    alg.triangles.reserve(facets.size());
+    for (int index : facets) {
         Simplify::Triangle t;
         t.deleted = 0;
         t.dirty = 0;
         for (double& j : t.err) {
             j = 0.0;
         }
+        const auto& tria = mesh.triangles[index];
         for (int j = 0; j < 3; j++) {
-            t.v[j] = facets[i]._aulPoints[j];
+            auto it = std::lower_bound(ids.begin(), ids.end(), tria[j]);
+            t.v[j] = static_cast<int>(it - ids.begin());
         }
         alg.triangles.push_back(t);
     }
 
-    int target_count = static_cast<int>(static_cast<float>(facets.size()) * (1.0F - reduction));
+    alg.simplify_mesh(targetSize, tolerance);
+    return alg;
+}
 
-    // Simplification starts
-    alg.simplify_mesh(target_count, tolerance);
+/**
+ * Joins the triangles \a kept of \a mesh with the simplified \a patches. The locked vertices
+ * are shared by all patches, \a seam is set for them in the returned mesh.
+ */
+Patch joinPatches(const Patch& mesh,
+                  const std::vector<int>& kept,
+                  const std::vector<Simplify>& patches,
+                  std::vector<char>& seam)
+{
+    Patch result;
+    std::vector<int> index(mesh.points.size(), -1);
+    auto mapPoint = [&](int id) {
+        if (index[id] < 0) {
+            index[id] = static_cast<int>(result.points.size());
+            result.points.push_back(mesh.points[id]);
+        }
+        return index[id];
+    };
 
-    // Simplification done
-    MeshPointArray new_points;
-    new_points.reserve(alg.vertices.size());
-    for (const auto& vertex : alg.vertices) {
-        new_points.push_back(vertex.p);
+    for (int facet : kept) {
+        const auto& tria = mesh.triangles[facet];
+        result.triangles.push_back({mapPoint(tria[0]), mapPoint(tria[1]), mapPoint(tria[2])});
     }
 
-    std::size_t numFacets = 0;
-    for (const auto& triangle : alg.triangles) {
-        if (!triangle.deleted) {
-            numFacets++;
+    std::vector<int> seamPoints;
+    for (const auto& alg : patches) {
+        std::vector<int> local(alg.vertices.size());
+        for (std::size_t i = 0; i < alg.vertices.size(); i++) {
+            const auto& v = alg.vertices[i];
+            if (v.locked) {
+                local[i] = mapPoint(v.id);
+                seamPoints.push_back(local[i]);
+            }
+            else {
+                local[i] = static_cast<int>(result.points.size());
+                result.points.push_back(v.p);
+            }
         }
-    }
-    MeshFacetArray new_facets;
-    new_facets.reserve(numFacets);
-    for (const auto& triangle : alg.triangles) {
-        if (!triangle.deleted) {
-            MeshFacet face;
-            face._aulPoints[0] = triangle.v[0];
-            face._aulPoints[1] = triangle.v[1];
-            face._aulPoints[2] = triangle.v[2];
-            new_facets.push_back(face);
+        for (const auto& t : alg.triangles) {
+            result.triangles.push_back({local[t.v[0]], local[t.v[1]], local[t.v[2]]});
         }
     }
 
-    myKernel.Adopt(new_points, new_facets, true);
+    seam.assign(result.points.size(), 0);
+    for (int id : seamPoints) {
+        seam[id] = 1;
+    }
+    return result;
+}
+
+}  // namespace
+
+MeshSimplify::MeshSimplify(MeshKernel& mesh)
+    : myKernel(mesh)
+{}
+
+void MeshSimplify::simplify(float tolerance, float reduction)
+{
+    const MeshFacetArray& facets = myKernel.GetFacets();
+    int target_count = static_cast<int>(static_cast<float>(facets.size()) * (1.0F - reduction));
+    reduce(static_cast<std::size_t>(std::max(target_count, 0)), tolerance);
 }
 
 void MeshSimplify::simplify(int targetSize)
 {
-    Simplify alg;
+    reduce(static_cast<std::size_t>(std::max(targetSize, 0)), std::numeric_limits<float>::max());
+}
 
+void MeshSimplify::reduce(std::size_t targetSize, float tolerance)
+{
+    Patch mesh;
     const MeshPointArray& points = myKernel.GetPoints();
-    for (std::size_t i = 0; i < points.size(); i++) {
-        Simplify::Vertex v;
-        v.tstart = 0;
-        v.tcount = 0;
-        v.border = 0;
-        v.p = points[i];
-        alg.vertices.push_back(v);
+    mesh.points.assign(points.begin(), points.end());
+    const MeshFacetArray& facets = myKernel.GetFacets();
+    mesh.triangles.reserve(facets.size());
+    for (const auto& facet : facets) {
+        mesh.triangles.push_back({static_cast<int>(facet._aulPoints[0]),
+                                  static_cast<int>(facet._aulPoints[1]),
+                                  static_cast<int>(facet._aulPoints[2])});
     }
 
-    const MeshFacetArray& facets = myKernel.GetFacets();
-    for (std::size_t i = 0; i < facets.size(); i++) {
-        Simplify::Triangle t;
-        t.deleted = 0;
-        t.dirty = 0;
-        for (double& j : t.err) {
-            j = 0.0;
-        }
-        for (int j = 0; j < 3; j++) {
-            t.v[j] = facets[i]._aulPoints[j];
+    std::size_t numFacets = mesh.triangles.size();
+    int threads = int(std::thread::hardware_concurrency());
+    std::size_t maxSize = myMaxClusterSize;
+    if (maxSize == 0) {
+        // A few clusters per thread to balance the load, a single thread does it in one go
+        maxSize = numFacets;
+        if (threads > 1) {
+            maxSize = std::max(minClusterSize, numFacets / (clustersPerThread * threads));
         }
-        alg.triangles.push_back(t);
     }
 
-    // Simplification starts
-    alg.simplify_mesh(targetSize, std::numeric_limits<float>::max());
-
-    // Simplification done
-    MeshPointArray new_points;
-    new_points.reserve(alg.vertices.size());
-    for (const auto& vertex : alg.vertices) {
-        new_points.push_back(vertex.p);
+    std::vector<char> seam;
+    if (numFacets <= maxSize) {
+        std::vector<int> all(numFacets);
+        std::iota(all.begin(), all.end(), 0);
+        std::vector<Simplify> result(1);
+        result[0] = simplifyPatch(mesh, all, {}, static_cast<int>(targetSize), tolerance);
+        mesh = joinPatches(mesh, {}, result, seam);
     }
+    else {
+        double ratio = std::min(1.0, double(targetSize) / double(numFacets));
 
-    std::size_t numFacets = 0;
-    for (const auto& triangle : alg.triangles) {
-        if (!triangle.deleted) {
-            numFacets++;
+        // Vertices shared by several clusters must be kept to stitch the clusters together
+        std::vector<std::vector<int>> clusters = splitIntoClusters(mesh, maxSize, threads);
+        std::vector<char> locked(mesh.points.size(), 0);
+        {
+            std::vector<int> owner(mesh.points.size(), -1);
+            for (std::size_t i = 0; i < clusters.size(); i++) {
+                for (int facet : clusters[i]) {
+                    for (int id : mesh.triangles[facet]) {
+                        if (owner[id] < 0) {
+                            owner[id] = int(i);
+                        }
+                        else if (owner[id] != int(i)) {
+                            locked[id] = 1;
+                        }
+                    }
+                }
+            }
         }
+
+        std::vector<Simplify> results(clusters.size());
+        MeshCore::parallel_for(
+            0,
+            clusters.size(),
+            [&](std::size_t index) {
+                // The triangles at the locked vertices are left to the final pass
+                const std::vector<int>& cluster = clusters[index];
+                auto strip = std::count_if(cluster.begin(), cluster.end(), [&](int facet) {
+                    const auto& tria = mesh.triangles[facet];
+                    return locked[tria[0]] || locked[tria[1]] || locked[tria[2]];
+                });
+                double target = double(strip) + ratio * double(cluster.size() - strip);
+                results[index] =
+                    simplifyPatch(mesh, cluster, locked, static_cast<int>(target), tolerance);
+            },
+            threads,
+            1);
+        clusters.clear();
+        mesh = joinPatches(mesh, {}, results, seam);
+        results.clear();
+
+        // Final pass over a band of a few rings of triangles around the cluster boundaries.
+        // Its outer vertices are locked now, the former cluster boundaries can be simplified.
+        for (int ring = 1; ring < bandRings; ring++) {
+            std::vector<char> grown(seam);
+            for (const auto& tria : mesh.triangles) {
+                if (seam[tria[0]] || seam[tria[1]] || seam[tria[2]]) {
+                    grown[tria[0]] = grown[tria[1]] = grown[tria[2]] = 1;
+                }
+            }
+            seam.swap(grown);
+        }
+
+        std::vector<int> band;
+        std::vector<int> kept;
+        for (std::size_t i = 0; i < mesh.triangles.size(); i++) {
+            const auto& tria = mesh.triangles[i];
+            if (seam[tria[0]] || seam[tria[1]] || seam[tria[2]]) {
+                band.push_back(int(i));
+            }
+            else {
+                kept.push_back(int(i));
+            }
+        }
+
+        locked.assign(mesh.points.size(), 0);
+        for (int facet : kept) {
+            for (int id : mesh.triangles[facet]) {
+                locked[id] = 1;
+            }
+        }
+
+        auto remaining = static_cast<double>(targetSize) - static_cast<double>(kept.size());
+        double target = std::max(remaining, ratio * double(band.size()));
+        std::vector<Simplify> result(1);
+        result[0] = simplifyPatch(mesh, band, locked, static_cast<int>(target), tolerance);
+        mesh = joinPatches(mesh, kept, result, seam);
     }
+
+    MeshPointArray new_points;
+    new_points.reserve(mesh.points.size());
+    for (const auto& point : mesh.points) {
+        new_points.push_back(point);
+    }
+
     MeshFacetArray new_facets;
-    new_facets.reserve(numFacets);
-    for (const auto& triangle : alg.triangles) {
-        if (!triangle.deleted) {
-            MeshFacet face;
-            face._aulPoints[0] = triangle.v[0];
-            face._aulPoints[1] = triangle.v[1];
-            face._aulPoints[2] = triangle.v[2];
-            new_facets.push_back(face);
-        }
+    new_facets.reserve(mesh.triangles.size());
+    for (const auto& tria : mesh.triangles) {
+        MeshFacet face;
+        face._aulPoints[0] = tria[0];
+        face._aulPoints[1] = tria[1];
+        face._aulPoints[2] = tria[2];
+        new_facets.push_back(face);
     }
 
     myKernel.Adopt(new_points, new_facets, true);
@@ -24,21 +24,48 @@
 #ifndef MESH_DECIMATION_H
 #define MESH_DECIMATION_H
 
+#include <cstddef>
+
 #include <Mod/Mesh/MeshGlobal.h>
 
 namespace MeshCore
 {
 class MeshKernel;
 
+/**
+ * The MeshSimplify class reduces the number of facets of a mesh with the quadric error metric.
+ *
+ * Large meshes are split into spatial clusters of facets that are simplified concurrently. The
+ * vertices shared by several clusters are locked so that the clusters can be stitched together
+ * afterwards. A final pass then simplifies the band of facets around the former cluster
+ * boundaries.
+ */
 class MeshExport MeshSimplify
 {
 public:
     explicit MeshSimplify(MeshKernel&);
+    /**
+     * Removes up to \a reduction (in the range [0.0, 1.0]) of the facets as long as the
+     * quadric error stays below \a tolerance.
+     */
     void simplify(float tolerance, float reduction);
+    /// Reduces the mesh to about \a targetSize facets
     void simplify(int targetSize);
+    /**
+     * Sets the maximum number of facets of a cluster. Meshes with fewer facets are simplified as
+     * a whole. With 0, the default, the mesh is split into a few clusters per available thread.
+     */
+    void setMaxClusterSize(std::size_t size)
+    {
+        myMaxClusterSize = size;
+    }
+
+private:
+    void reduce(std::size_t targetSize, float tolerance);
 
 private:
     MeshKernel& myKernel;
+    std::size_t myMaxClusterSize {0};
 };
 
 }  // namespace MeshCore
@@ -24,7 +24,9 @@
 #define MESH_FUNCTIONAL_H
 
 #include <algorithm>
+#include <cstddef>
 #include <future>
+#include <vector>
 
 
 namespace MeshCore
@@ -62,6 +64,43 @@ static void parallel_sort(Iter begin, Iter end, Pred comp, int threads)
     }
 }
 
+/**
+ * Calls \a func(i) for all i in [begin, end). The range is split into one block per thread,
+ * blocks have at least \a grain elements.
+ */
+template<class Func>
+static void
+parallel_for(std::size_t begin, std::size_t end, Func func, int threads, std::size_t grain = 1024)
+{
+    std::size_t count = end > begin ? end - begin : 0;
+    std::size_t blocks =
+        std::min<std::size_t>(std::max(threads, 1), count / std::max<std::size_t>(grain, 1));
+    if (blocks < 2) {
+        for (std::size_t i = begin; i < end; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    auto run = [&func](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            func(i);
+        }
+    };
+    std::vector<std::future<void>> futures;
+    futures.reserve(blocks - 1);
+    std::size_t size = count / blocks;
+    for (std::size_t block = 1; block < blocks; ++block) {
+        std::size_t first = begin + block * size;
+        std::size_t last = block + 1 < blocks ? first + size : end;
+        futures.push_back(std::async(std::launch::async, run, first, last));
+    }
+    run(begin, begin + size);
+    for (auto& future : futures) {
+        future.get();
+    }
+}
+
 }  // namespace MeshCore
 
 
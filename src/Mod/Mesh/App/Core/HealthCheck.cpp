@@ -0,0 +1,474 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <future>
+#include <thread>
+#include <boost/math/special_functions/fpclassify.hpp>
+#endif
+
+#include "Algorithm.h"
+#include "BVH.h"
+#include "Elements.h"
+#include "Evaluation.h"
+#include "Functional.h"
+#include "HealthCheck.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+// Number of elements a worker of the block-wise checks processes at a time
+constexpr std::size_t blockSize = 4096;
+
+// Bits of the defects of a single facet
+enum FacetDefect : unsigned char
+{
+    PointOutOfRange = 1,
+    FacetOutOfRange = 2,
+    Corrupted = 4,
+    Degenerated = 8
+};
+
+struct FacetEdge
+{
+    PointIndex p0, p1;
+    FacetIndex f;
+
+    bool operator<(const FacetEdge& other) const
+    {
+        if (p0 != other.p0) {
+            return p0 < other.p0;
+        }
+        if (p1 != other.p1) {
+            return p1 < other.p1;
+        }
+        return f < other.f;
+    }
+    bool SameEdge(const FacetEdge& other) const
+    {
+        return p0 == other.p0 && p1 == other.p1;
+    }
+};
+
+template<class Index>
+std::vector<Index> collectFlagged(const std::vector<unsigned char>& flags, unsigned char mask)
+{
+    std::vector<Index> indices;
+    for (std::size_t i = 0; i < flags.size(); i++) {
+        if (flags[i] & mask) {
+            indices.push_back(Index(i));
+        }
+    }
+    return indices;
+}
+
+bool shareVertex(const MeshFacet& f1, const MeshFacet& f2)
+{
+    for (PointIndex p1 : f1._aulPoints) {
+        for (PointIndex p2 : f2._aulPoints) {
+            if (p1 == p2) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+bool MeshHealthReport::IsValid() const
+{
+    return invalidPoints.empty() && duplicatedPoints.empty() && pointsOutOfRange.empty()
+        && facetsOutOfRange.empty() && corruptedFacets.empty() && degeneratedFacets.empty()
+        && duplicatedFacets.empty() && nonManifoldEdges.empty() && nonManifoldPoints.empty()
+        && invalidNeighbourhood.empty() && nonUniformOrientedFacets.empty()
+        && selfIntersections.empty() && foldsOnSurface.empty() && foldsOnBoundary.empty()
+        && foldOversOnSurface.empty();
+}
+
+// ----------------------------------------------------------------------
+
+MeshHealthCheck::MeshHealthCheck(const MeshKernel& rclM, float fEpsilon)
+    : _rclMesh(rclM)
+    , _fEpsilon(fEpsilon)
+    , _threads(int(std::thread::hardware_concurrency()))
+{}
+
+MeshHealthReport MeshHealthCheck::Evaluate() const
+{
+    MeshHealthReport report;
+    std::vector<Base::Vector3f> normals;
+
+    auto duplicatedPoints = std::async(std::launch::async, [this] {
+        return FindDuplicatedPoints();
+    });
+    CheckElements(report, normals);
+
+    // all further checks rely on valid indices
+    if (report.pointsOutOfRange.empty() && report.facetsOutOfRange.empty()) {
+        std::vector<std::future<void>> tasks;
+        auto run = [&tasks](auto func) {
+            tasks.push_back(std::async(std::launch::async, func));
+        };
+
+        run([this, &report] {
+            CheckEdges(report);
+        });
+        run([this, &report] {
+            report.nonManifoldPoints = FindNonManifoldPoints();
+        });
+        run([this, &report] {
+            report.duplicatedFacets = FindDuplicatedFacets();
+        });
+        run([this, &report, &normals] {
+            CheckFolds(report, normals);
+        });
+        if (_checkSelfIntersections) {
+            run([this, &report] {
+                report.selfIntersections = FindSelfIntersections();
+            });
+        }
+
+        for (auto& task : tasks) {
+            task.get();
+        }
+
+        // MeshKernel::GetFacet() copies the facet flags, so this must not run concurrently
+        // to the other checks
+        MeshEvalOrientation orientation(_rclMesh);
+        report.nonUniformOrientedFacets = orientation.GetIndices();
+    }
+
+    report.duplicatedPoints = duplicatedPoints.get();
+    return report;
+}
+
+void MeshHealthCheck::CheckElements(MeshHealthReport& report,
+                                    std::vector<Base::Vector3f>& normals) const
+{
+    const MeshPointArray& points = _rclMesh.GetPoints();
+    const MeshFacetArray& facets = _rclMesh.GetFacets();
+    std::size_t countPoints = points.size();
+    std::size_t countFacets = facets.size();
+
+    std::vector<unsigned char> invalid(countPoints);
+    parallel_for(
+        0,
+        countPoints,
+        [&](std::size_t index) {
+            const MeshPoint& pt = points[index];
+            invalid[index] = boost::math::isnan(pt.x) || boost::math::isnan(pt.y)
+                || boost::math::isnan(pt.z);
+        },
+        _threads);
+    report.invalidPoints = collectFlagged<PointIndex>(invalid, 1);
+
+    std::vector<unsigned char> defects(countFacets);
+    normals.resize(countFacets);
+    parallel_for(
+        0,
+        countFacets,
+        [&](std::size_t index) {
+            const MeshFacet& face = facets[index];
+            unsigned char defect = 0;
+            for (int i = 0; i < 3; i++) {
+                if (face._aulPoints[i] >= countPoints) {
+                    defect |= PointOutOfRange;
+                }
+                FacetIndex neighbour = face._aulNeighbours[i];
+                if (neighbour >= countFacets && neighbour != FACET_INDEX_MAX) {
+                    defect |= FacetOutOfRange;
+                }
+            }
+            if (face.IsDegenerated()) {
+                defect |= Corrupted;
+            }
+            if (!(defect & PointOutOfRange)) {
+                MeshGeomFacet triangle = _rclMesh.GetFacet(face);
+                if (triangle.IsDegenerated(_fEpsilon)) {
+                    defect |= Degenerated;
+                }
+                normals[index] = triangle.GetNormal();
+            }
+            defects[index] = defect;
+        },
+        _threads);
+
+    report.pointsOutOfRange = collectFlagged<FacetIndex>(defects, PointOutOfRange);
+    report.facetsOutOfRange = collectFlagged<FacetIndex>(defects, FacetOutOfRange);
+    report.corruptedFacets = collectFlagged<FacetIndex>(defects, Corrupted);
+    report.degeneratedFacets = collectFlagged<FacetIndex>(defects, Degenerated);
+}
+
+void MeshHealthCheck::CheckEdges(MeshHealthReport& report) const
+{
+    // one edge table for the checks of MeshEvalTopology, MeshEvalNeighbourhood and MeshEvalSolid
+    const MeshFacetArray& facets = _rclMesh.GetFacets();
+    std::vector<FacetEdge> edges(3 * facets.size());
+    parallel_for(
+        0,
+        facets.size(),
+        [&](std::size_t index) {
+            const MeshFacet& face = facets[index];
+            for (int i = 0; i < 3; i++) {
+                PointIndex p0 = face._aulPoints[i];
+                PointIndex p1 = face._aulPoints[(i + 1) % 3];
+                edges[3 * index + i] = {std::min(p0, p1), std::max(p0, p1), FacetIndex(index)};
+            }
+        },
+        _threads);
+    parallel_sort(edges.begin(), edges.end(), std::less<>(), _threads);
+
+    std::vector<FacetIndex> invalid;
+    for (auto it = edges.begin(); it != edges.end();) {
+        auto next = std::find_if(it + 1, edges.end(), [it](const FacetEdge& edge) {
+            return !it->SameEdge(edge);
+        });
+        PointIndex p0 = it->p0;
+        PointIndex p1 = it->p1;
+        std::ptrdiff_t count = next - it;
+        if (count > 2) {
+            report.nonManifoldEdges.emplace_back(p0, p1);
+        }
+        else if (count == 2) {
+            // both facets must reference each other as neighbours
+            FacetIndex f0 = it->f;
+            FacetIndex f1 = (it + 1)->f;
+            const MeshFacet& face0 = facets[f0];
+            const MeshFacet& face1 = facets[f1];
+            if (face0._aulNeighbours[face0.Side(p0, p1)] != f1
+                || face1._aulNeighbours[face1.Side(p0, p1)] != f0) {
+                invalid.push_back(f0);
+                invalid.push_back(f1);
+            }
+        }
+        else {
+            // an open edge must not have a neighbour
+            report.openEdges++;
+            const MeshFacet& face = facets[it->f];
+            if (face._aulNeighbours[face.Side(p0, p1)] != FACET_INDEX_MAX) {
+                invalid.push_back(it->f);
+            }
+        }
+        it = next;
+    }
+
+    std::sort(invalid.begin(), invalid.end());
+    invalid.erase(std::unique(invalid.begin(), invalid.end()), invalid.end());
+    report.invalidNeighbourhood = std::move(invalid);
+}
+
+void MeshHealthCheck::CheckFolds(MeshHealthReport& report,
+                                 const std::vector<Base::Vector3f>& normals) const
+{
+    const MeshFacetArray& facets = _rclMesh.GetFacets();
+    std::vector<FacetIndex> folds;
+    for (FacetIndex index = 0; index < facets.size(); index++) {
+        const MeshFacet& face = facets[index];
+        const Base::Vector3f& normal = normals[index];
+        bool foldOver = false;
+        for (int i = 0; i < 3; i++) {
+            FacetIndex n1 = face._aulNeighbours[i];
+            FacetIndex n2 = face._aulNeighbours[(i + 1) % 3];
+            if (n1 == FACET_INDEX_MAX || n2 == FACET_INDEX_MAX) {
+                continue;
+            }
+
+            // see MeshEvalFoldsOnSurface
+            const Base::Vector3f& v2 = normals[n1];
+            const Base::Vector3f& v3 = normals[n2];
+            if (v2 * v3 > 0.0F && normal * v2 < -0.1F && normal * v3 < -0.1F) {
+                folds.push_back(n1);
+                folds.push_back(n2);
+                folds.push_back(index);
+            }
+
+            // see MeshEvalFoldOversOnSurface
+            if (!foldOver && face.HasSameOrientation(facets[n1])
+                && face.HasSameOrientation(facets[n2]) && v2 * v3 < -0.5F) {
+                foldOver = true;
+            }
+        }
+        if (foldOver) {
+            report.foldOversOnSurface.push_back(index);
+        }
+
+        // see MeshEvalFoldsOnBoundary
+        if (face.CountOpenEdges() == 2) {
+            for (FacetIndex neighbour : face._aulNeighbours) {
+                if (neighbour != FACET_INDEX_MAX && normal * normals[neighbour] <= 0.5F) {
+                    report.foldsOnBoundary.push_back(index);
+                }
+            }
+        }
+    }
+
+    std::sort(folds.begin(), folds.end());
+    folds.erase(std::unique(folds.begin(), folds.end()), folds.end());
+    report.foldsOnSurface = std::move(folds);
+}
+
+std::vector<PointIndex> MeshHealthCheck::FindDuplicatedPoints() const
+{
+    // Sort by location and index, so the point with the lowest index of a group is kept
+    const MeshPointArray& points = _rclMesh.GetPoints();
+    std::vector<PointIndex> order(points.size());
+    for (PointIndex index = 0; index < order.size(); index++) {
+        order[index] = index;
+    }
+    parallel_sort(
+        order.begin(),
+        order.end(),
+        [&points](PointIndex a, PointIndex b) {
+            if (points[a] < points[b]) {
+                return true;
+            }
+            if (points[b] < points[a]) {
+                return false;
+            }
+            return a < b;
+        },
+        _threads);
+
+    std::vector<PointIndex> duplicates;
+    for (std::size_t i = 1; i < order.size(); i++) {
+        const MeshPoint& prev = points[order[i - 1]];
+        const MeshPoint& curr = points[order[i]];
+        if (!(prev < curr) && !(curr < prev)) {
+            duplicates.push_back(order[i]);
+        }
+    }
+    std::sort(duplicates.begin(), duplicates.end());
+    return duplicates;
+}
+
+std::vector<FacetIndex> MeshHealthCheck::FindDuplicatedFacets() const
+{
+    // A facet is identified by its sorted point indices, the last entry is the facet index
+    const MeshFacetArray& facets = _rclMesh.GetFacets();
+    std::vector<std::array<ElementIndex, 4>> keys(facets.size());
+    parallel_for(
+        0,
+        facets.size(),
+        [&](std::size_t index) {
+            const MeshFacet& face = facets[index];
+            auto& key = keys[index];
+            key = {face._aulPoints[0], face._aulPoints[1], face._aulPoints[2], index};
+            std::sort(key.begin(), key.begin() + 3);
+        },
+        _threads);
+    parallel_sort(keys.begin(), keys.end(), std::less<>(), _threads);
+
+    std::vector<FacetIndex> duplicates;
+    for (std::size_t i = 1; i < keys.size(); i++) {
+        if (std::equal(keys[i].begin(), keys[i].begin() + 3, keys[i - 1].begin())) {
+            duplicates.push_back(keys[i][3]);
+        }
+    }
+    std::sort(duplicates.begin(), duplicates.end());
+    return duplicates;
+}
+
+std::vector<PointIndex> MeshHealthCheck::FindNonManifoldPoints() const
+{
+    // A point is non-manifold if it has more neighbour points than a fan of its facets
+    // would have, see MeshEvalPointManifolds
+    const MeshFacetArray& facets = _rclMesh.GetFacets();
+    MeshCompactPointToFacets pointFacets(_rclMesh);
+    std::size_t countPoints = _rclMesh.CountPoints();
+    std::size_t countBlocks = (countPoints + blockSize - 1) / blockSize;
+
+    std::vector<unsigned char> nonManifold(countPoints);
+    parallel_for(
+        0,
+        countBlocks,
+        [&](std::size_t block) {
+            std::vector<PointIndex> neighbours;
+            std::size_t last = std::min(countPoints, (block + 1) * blockSize);
+            for (std::size_t index = block * blockSize; index < last; index++) {
+                MeshIndexRange range = pointFacets[index];
+                neighbours.clear();
+                for (FacetIndex facet : range) {
+                    for (PointIndex point : facets[facet]._aulPoints) {
+                        if (point != index) {
+                            neighbours.push_back(point);
+                        }
+                    }
+                }
+                std::sort(neighbours.begin(), neighbours.end());
+                auto count = std::unique(neighbours.begin(), neighbours.end()) - neighbours.begin();
+                nonManifold[index] = std::size_t(count) > range.size() + 1;
+            }
+        },
+        _threads,
+        1);
+
+    return collectFlagged<PointIndex>(nonManifold, 1);
+}
+
+std::vector<std::pair<FacetIndex, FacetIndex>> MeshHealthCheck::FindSelfIntersections() const
+{
+    // Each pair is tested by the facet with the lower index, see MeshEvalSelfIntersection
+    const MeshFacetArray& facets = _rclMesh.GetFacets();
+    MeshFacetBVH bvh(_rclMesh);
+    std::size_t countFacets = facets.size();
+    std::size_t countBlocks = (countFacets + blockSize - 1) / blockSize;
+
+    std::vector<std::vector<std::pair<FacetIndex, FacetIndex>>> results(countBlocks);
+    parallel_for(
+        0,
+        countBlocks,
+        [&](std::size_t block) {
+            std::vector<FacetIndex> candidates;
+            Base::Vector3f pt1, pt2;
+            std::size_t last = std::min(countFacets, (block + 1) * blockSize);
+            for (FacetIndex index = block * blockSize; index < last; index++) {
+                MeshGeomFacet facet1 = _rclMesh.GetFacet(index);
+                candidates.clear();
+                bvh.Inside(facet1.GetBoundBox(), candidates);
+                std::sort(candidates.begin(), candidates.end());
+                for (FacetIndex other : candidates) {
+                    if (other <= index || shareVertex(facets[index], facets[other])) {
+                        continue;
+                    }
+                    MeshGeomFacet facet2 = _rclMesh.GetFacet(other);
+                    if (facet1.IntersectWithFacet(facet2, pt1, pt2) == 2) {
+                        results[block].emplace_back(index, other);
+                    }
+                }
+            }
+        },
+        _threads,
+        1);
+
+    std::vector<std::pair<FacetIndex, FacetIndex>> intersections;
+    for (const auto& result : results) {
+        intersections.insert(intersections.end(), result.begin(), result.end());
+    }
+    return intersections;
+}
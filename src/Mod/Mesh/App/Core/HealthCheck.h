@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef MESH_HEALTHCHECK_H
+#define MESH_HEALTHCHECK_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <Base/Vector3D.h>
+
+#include "Definitions.h"
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshHealthReport holds the result of MeshHealthCheck. For each kind of defect it lists
+ * the offending elements, the number of defects is the size of the list.
+ */
+struct MeshExport MeshHealthReport
+{
+    /// Points with a NaN coordinate, see MeshEvalNaNPoints
+    std::vector<PointIndex> invalidPoints;
+    /// Points at the location of a point with a lower index, see MeshEvalDuplicatePoints
+    std::vector<PointIndex> duplicatedPoints;
+    /// Facets with a point index out of range, see MeshEvalRangePoint
+    std::vector<FacetIndex> pointsOutOfRange;
+    /// Facets with a neighbour index out of range, see MeshEvalRangeFacet
+    std::vector<FacetIndex> facetsOutOfRange;
+    /// Facets that reference a point more than once, see MeshEvalCorruptedFacets
+    std::vector<FacetIndex> corruptedFacets;
+    /// Facets with a vanishing area, see MeshEvalDegeneratedFacets
+    std::vector<FacetIndex> degeneratedFacets;
+    /// Facets with the points of a facet with a lower index, see MeshEvalDuplicateFacets
+    std::vector<FacetIndex> duplicatedFacets;
+    /// Edges, given by their end points, shared by more than two facets, see MeshEvalTopology
+    std::vector<std::pair<PointIndex, PointIndex>> nonManifoldEdges;
+    /// see MeshEvalPointManifolds
+    std::vector<PointIndex> nonManifoldPoints;
+    /// Facets with wrong neighbour indices, see MeshEvalNeighbourhood
+    std::vector<FacetIndex> invalidNeighbourhood;
+    /// Facets with the opposite orientation of their component, see MeshEvalOrientation
+    std::vector<FacetIndex> nonUniformOrientedFacets;
+    /// Pairs of intersecting facets, the lower index comes first, see MeshEvalSelfIntersection
+    std::vector<std::pair<FacetIndex, FacetIndex>> selfIntersections;
+    /// see MeshEvalFoldsOnSurface
+    std::vector<FacetIndex> foldsOnSurface;
+    /// see MeshEvalFoldsOnBoundary
+    std::vector<FacetIndex> foldsOnBoundary;
+    /// see MeshEvalFoldOversOnSurface
+    std::vector<FacetIndex> foldOversOnSurface;
+    /// Number of edges with only one facet, zero for a solid, see MeshEvalSolid
+    std::size_t openEdges {0};
+
+    /// Returns true if no defect was found, open edges are not regarded as a defect
+    bool IsValid() const;
+};
+
+/**
+ * The MeshHealthCheck class runs the checks of the MeshEval... classes listed in
+ * MeshHealthReport in one go. The checks of single points and facets are done in one parallel
+ * pass, then the other checks run concurrently and share the facet normals computed in the
+ * first pass. The edge table, the point to facet adjacency and the bounding volume hierarchy
+ * for the self-intersections are built once instead of once per check.
+ *
+ * If there are point or neighbour indices out of range, only the checks of single elements
+ * and the duplicated points are done because the others would access invalid elements.
+ * \note Like MeshEvalOrientation the check uses the VISIT and TMP0 flags of the facets.
+ */
+class MeshExport MeshHealthCheck
+{
+public:
+    /// Construction, \a fEpsilon is passed to MeshGeomFacet::IsDegenerated()
+    explicit MeshHealthCheck(const MeshKernel& rclM, float fEpsilon = 0.0F);
+
+    /// Enables or disables the check for self-intersections, by default it is enabled
+    void SetCheckSelfIntersections(bool on)
+    {
+        _checkSelfIntersections = on;
+    }
+    /// Runs all checks
+    MeshHealthReport Evaluate() const;
+
+private:
+    void CheckElements(MeshHealthReport& report, std::vector<Base::Vector3f>& normals) const;
+    void CheckEdges(MeshHealthReport& report) const;
+    void CheckFolds(MeshHealthReport& report, const std::vector<Base::Vector3f>& normals) const;
+    std::vector<PointIndex> FindDuplicatedPoints() const;
+    std::vector<FacetIndex> FindDuplicatedFacets() const;
+    std::vector<PointIndex> FindNonManifoldPoints() const;
+    std::vector<std::pair<FacetIndex, FacetIndex>> FindSelfIntersections() const;
+
+    const MeshKernel& _rclMesh; /**< The mesh kernel. */
+    float _fEpsilon;
+    bool _checkSelfIntersections {true};
+    int _threads;
+};
+
+}  // namespace MeshCore
+
+#endif  // MESH_HEALTHCHECK_H
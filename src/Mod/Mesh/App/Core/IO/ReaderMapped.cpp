@@ -0,0 +1,813 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <future>
+#include <sstream>
+#include <thread>
+#endif
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/version.hpp>
+
+#include "Core/MeshIO.h"
+#include "Core/MeshKernel.h"
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+
+#include "ReaderMapped.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+namespace bip = boost::interprocess;
+
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& filename)
+    {
+        try {
+#if defined(FC_OS_WIN32) && (BOOST_VERSION >= 107600)
+            Base::FileInfo fi(filename);
+            mapping = bip::file_mapping(fi.toStdWString().c_str(), bip::read_only);
+#else
+            mapping = bip::file_mapping(filename.c_str(), bip::read_only);
+#endif
+            region = bip::mapped_region(mapping, bip::read_only);
+            region.advise(bip::mapped_region::advice_sequential);
+        }
+        catch (const bip::interprocess_exception&) {
+            // empty files or file systems without memory mapping
+            region = bip::mapped_region();
+        }
+    }
+
+    const char* data() const
+    {
+        return static_cast<const char*>(region.get_address());
+    }
+    std::size_t size() const
+    {
+        return region.get_size();
+    }
+
+private:
+    bip::file_mapping mapping;
+    bip::mapped_region region;
+};
+
+bool isLittleEndian()
+{
+    const std::uint16_t value = 1;
+    unsigned char byte {};
+    std::memcpy(&byte, &value, 1);
+    return byte == 1;
+}
+
+template<class T>
+T readValue(const char* ptr, bool swap)
+{
+    std::array<char, sizeof(T)> bytes {};
+    std::memcpy(bytes.data(), ptr, sizeof(T));
+    if (swap) {
+        std::reverse(bytes.begin(), bytes.end());
+    }
+    T value {};
+    std::memcpy(&value, bytes.data(), sizeof(T));
+    return value;
+}
+
+Base::Vector3f readVector(const char* ptr)
+{
+    std::array<float, 3> xyz {};
+    std::memcpy(xyz.data(), ptr, sizeof(xyz));
+    return Base::Vector3f(xyz[0], xyz[1], xyz[2]);
+}
+
+std::uint64_t hashPoint(const Base::Vector3f& pnt)
+{
+    // -0.0 and 0.0 compare equal, so they must get the same hash
+    std::array<float, 3> xyz {pnt.x + 0.0F, pnt.y + 0.0F, pnt.z + 0.0F};
+    std::array<std::uint32_t, 3> bits {};
+    std::memcpy(bits.data(), xyz.data(), sizeof(bits));
+    std::uint64_t hash = (std::uint64_t(bits[0]) << 32) | bits[1];
+    hash ^= std::uint64_t(bits[2]) * 0x9E3779B97F4A7C15ULL;
+    // finalizer of splitmix64
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+    return hash ^ (hash >> 31);
+}
+
+// Exact comparison like MeshFastBuilder, Base::Vector3f::operator==() has a tolerance
+bool samePoint(const Base::Vector3f& pnt1, const Base::Vector3f& pnt2)
+{
+    return pnt1.x == pnt2.x && pnt1.y == pnt2.y && pnt1.z == pnt2.z;
+}
+
+bool isSpace(char ch)
+{
+    return ch == ' ' || ch == '\t' || ch == '\r';
+}
+
+const char* skipSpaces(const char* pos, const char* end)
+{
+    while (pos < end && isSpace(*pos)) {
+        ++pos;
+    }
+    return pos;
+}
+
+const char* skipToken(const char* pos, const char* end)
+{
+    while (pos < end && !isSpace(*pos)) {
+        ++pos;
+    }
+    return pos;
+}
+
+// Reads the float of the next token, the mapped data is not null terminated
+// so it is copied first
+bool parseFloat(const char*& pos, const char* end, float& value)
+{
+    const char* start = skipSpaces(pos, end);
+    pos = skipToken(start, end);
+    std::array<char, 64> buf {};
+    auto len = std::size_t(pos - start);
+    if (len == 0 || len >= buf.size()) {
+        return false;
+    }
+    std::memcpy(buf.data(), start, len);
+    char* last {};
+    value = std::strtof(buf.data(), &last);
+    return last == buf.data() + len;
+}
+
+// Reads the vertex index of the next face token, i.e. 'v', 'v/vt', 'v//vn' or 'v/vt/vn'
+bool parseIndex(const char*& pos, const char* end, long long& value)
+{
+    pos = skipSpaces(pos, end);
+    const char* start = pos;
+    bool negative = false;
+    if (pos < end && (*pos == '-' || *pos == '+')) {
+        negative = *pos == '-';
+        ++pos;
+    }
+    const char* digits = pos;
+    value = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9') {
+        value = value * 10 + (*pos - '0');
+        ++pos;
+    }
+    if (pos == digits || (pos < end && !isSpace(*pos) && *pos != '/')) {
+        pos = start;
+        return false;
+    }
+    if (negative) {
+        value = -value;
+    }
+    pos = skipToken(pos, end);
+    return true;
+}
+
+bool startsWith(const char* pos, const char* end, const char* keyword)
+{
+    std::size_t len = std::strlen(keyword);
+    return std::size_t(end - pos) > len && std::memcmp(pos, keyword, len) == 0
+        && isSpace(pos[len]);
+}
+
+enum class ObjLine
+{
+    Ignored,
+    Vertex,
+    Face,
+    Unsupported
+};
+
+ObjLine classifyObjLine(const char*& pos, const char* end)
+{
+    pos = skipSpaces(pos, end);
+    if (startsWith(pos, end, "v")) {
+        pos += 1;
+        return ObjLine::Vertex;
+    }
+    if (startsWith(pos, end, "f")) {
+        pos += 1;
+        return ObjLine::Face;
+    }
+    if (startsWith(pos, end, "g") || startsWith(pos, end, "usemtl")
+        || startsWith(pos, end, "mtllib")) {
+        return ObjLine::Unsupported;
+    }
+    return ObjLine::Ignored;
+}
+
+// Parses the vertex line and returns false if it has not exactly three coordinates
+bool parseObjVertex(const char* pos, const char* end, Base::Vector3f& pnt)
+{
+    if (!parseFloat(pos, end, pnt.x) || !parseFloat(pos, end, pnt.y)
+        || !parseFloat(pos, end, pnt.z)) {
+        return false;
+    }
+    return skipSpaces(pos, end) == end;
+}
+
+// Parses the face line and returns the number of corners, zero if unsupported
+int parseObjFace(const char* pos, const char* end, std::array<long long, 4>& corners)
+{
+    int count = 0;
+    while (skipSpaces(pos, end) != end) {
+        if (count == 4 || !parseIndex(pos, end, corners[count])) {
+            return 0;
+        }
+        count++;
+    }
+    return count >= 3 ? count : 0;
+}
+
+template<class Func>
+void forEachLine(const char* begin, const char* end, Func func)
+{
+    while (begin < end) {
+        auto next = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+        const char* last = next ? next : end;
+        if (!func(begin, last)) {
+            return;
+        }
+        begin = next ? next + 1 : end;
+    }
+}
+
+}  // namespace
+
+ReaderMapped::ReaderMapped(MeshKernel& kernel)
+    : _kernel(kernel)
+{}
+
+void ReaderMapped::SetProgress(const Progress& progress)
+{
+    _progress = progress;
+}
+
+void ReaderMapped::ReportProgress(float value) const
+{
+    if (_progress && !_progress(value)) {
+        throw Base::AbortException();
+    }
+}
+
+template<class Func>
+void ReaderMapped::RunChunks(std::size_t count, float from, float to, Func func) const
+{
+    std::atomic<std::size_t> next {0};
+    std::atomic<std::size_t> done {0};
+    std::atomic<bool> cancel {false};
+    auto worker = [&]() {
+        try {
+            for (std::size_t chunk = next++; chunk < count && !cancel; chunk = next++) {
+                func(chunk);
+                ++done;
+            }
+        }
+        catch (...) {
+            cancel = true;
+            throw;
+        }
+    };
+
+    std::size_t threads =
+        std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1U), count);
+    std::vector<std::future<void>> workers;
+    workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; i++) {
+        workers.push_back(std::async(std::launch::async, worker));
+    }
+
+    // Only this thread reports the progress, so the callback doesn't need to be thread-safe
+    std::exception_ptr error;
+    for (auto& it : workers) {
+        while (it.wait_for(std::chrono::milliseconds(50)) != std::future_status::ready) {
+            if (!error) {
+                try {
+                    ReportProgress(from + (to - from) * float(done) / float(count));
+                }
+                catch (...) {
+                    error = std::current_exception();
+                    cancel = true;
+                }
+            }
+        }
+    }
+    for (auto& it : workers) {
+        it.get();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    ReportProgress(to);
+}
+
+template<class Vertex>
+bool ReaderMapped::MergePoints(std::size_t numVertices,
+                               Vertex vertex,
+                               MeshPointArray& points,
+                               MeshFacetArray& facets) const
+{
+    if (numVertices >= std::numeric_limits<std::uint32_t>::max()) {
+        return false;
+    }
+    if (numVertices == 0) {
+        points.clear();
+        return true;
+    }
+
+    // The vertices are distributed into buckets by their hash. Equal vertices
+    // end up in the same bucket, so the buckets can be merged independently.
+    constexpr int bucketBits = 10;
+    constexpr std::size_t numBuckets = std::size_t(1) << bucketBits;
+    constexpr std::size_t chunkSize = 1 << 16;
+    std::size_t numChunks = std::min<std::size_t>((numVertices + chunkSize - 1) / chunkSize, 256);
+    std::size_t verticesPerChunk = (numVertices + numChunks - 1) / numChunks;
+    auto chunkRange = [&](std::size_t chunk) {
+        std::size_t begin = chunk * verticesPerChunk;
+        return std::make_pair(begin, std::min(begin + verticesPerChunk, numVertices));
+    };
+    auto bucketOf = [](const Base::Vector3f& pnt) {
+        return std::size_t(hashPoint(pnt) >> (64 - bucketBits));
+    };
+
+    // count the vertices of each bucket per chunk
+    std::vector<std::uint32_t> offsets(numChunks * numBuckets);
+    RunChunks(numChunks, 0.0F, 0.2F, [&](std::size_t chunk) {
+        auto [begin, end] = chunkRange(chunk);
+        std::uint32_t* count = &offsets[chunk * numBuckets];
+        for (std::size_t i = begin; i < end; i++) {
+            count[bucketOf(vertex(i))]++;
+        }
+    });
+
+    // turn the counts into the positions where each chunk writes its vertices
+    std::vector<std::uint32_t> bucketStart(numBuckets + 1);
+    std::uint32_t sum = 0;
+    for (std::size_t bucket = 0; bucket < numBuckets; bucket++) {
+        bucketStart[bucket] = sum;
+        for (std::size_t chunk = 0; chunk < numChunks; chunk++) {
+            std::uint32_t count = offsets[chunk * numBuckets + bucket];
+            offsets[chunk * numBuckets + bucket] = sum;
+            sum += count;
+        }
+    }
+    bucketStart[numBuckets] = sum;
+
+    std::vector<std::uint32_t> refs(numVertices);
+    RunChunks(numChunks, 0.2F, 0.4F, [&](std::size_t chunk) {
+        auto [begin, end] = chunkRange(chunk);
+        std::uint32_t* offset = &offsets[chunk * numBuckets];
+        for (std::size_t i = begin; i < end; i++) {
+            refs[offset[bucketOf(vertex(i))]++] = std::uint32_t(i);
+        }
+    });
+    offsets.clear();
+    offsets.shrink_to_fit();
+
+    // merge the vertices of each bucket, the facets get the index inside the bucket
+    std::vector<std::vector<std::uint32_t>> unique(numBuckets);
+    RunChunks(numBuckets, 0.4F, 0.7F, [&](std::size_t bucket) {
+        std::uint32_t begin = bucketStart[bucket];
+        std::uint32_t end = bucketStart[bucket + 1];
+        std::size_t capacity = 16;
+        while (capacity < 2 * std::size_t(end - begin)) {
+            capacity *= 2;
+        }
+        std::size_t mask = capacity - 1;
+        // positions in firstRefs plus one, zero for empty slots
+        std::vector<std::uint32_t> slots(capacity);
+        std::vector<std::uint32_t>& firstRefs = unique[bucket];
+        for (std::uint32_t i = begin; i < end; i++) {
+            std::uint32_t ref = refs[i];
+            Base::Vector3f pnt = vertex(ref);
+            std::size_t slot = hashPoint(pnt) & mask;
+            while (slots[slot] != 0 && !samePoint(vertex(firstRefs[slots[slot] - 1]), pnt)) {
+                slot = (slot + 1) & mask;
+            }
+            if (slots[slot] == 0) {
+                firstRefs.push_back(ref);
+                slots[slot] = std::uint32_t(firstRefs.size());
+            }
+            facets[ref / 3]._aulPoints[ref % 3] = slots[slot] - 1;
+        }
+    });
+
+    std::vector<PointIndex> pointStart(numBuckets + 1);
+    for (std::size_t bucket = 0; bucket < numBuckets; bucket++) {
+        pointStart[bucket + 1] = pointStart[bucket] + unique[bucket].size();
+    }
+
+    points.resize(pointStart[numBuckets]);
+    RunChunks(numBuckets, 0.7F, 0.8F, [&](std::size_t bucket) {
+        PointIndex start = pointStart[bucket];
+        const std::vector<std::uint32_t>& firstRefs = unique[bucket];
+        for (std::size_t i = 0; i < firstRefs.size(); i++) {
+            points[start + i] = MeshPoint(vertex(firstRefs[i]));
+        }
+        for (std::uint32_t i = bucketStart[bucket]; i < bucketStart[bucket + 1]; i++) {
+            std::uint32_t ref = refs[i];
+            facets[ref / 3]._aulPoints[ref % 3] += start;
+        }
+    });
+
+    return true;
+}
+
+void ReaderMapped::CleanupMesh(MeshPointArray& points, MeshFacetArray& facets)
+{
+    MeshCleanup meshCleanup(points, facets);
+    meshCleanup.RemoveInvalids();
+    ReportProgress(0.9F);
+    _kernel.Clear();
+    _kernel.Adopt(points, facets, true);
+    ReportProgress(1.0F);
+}
+
+bool ReaderMapped::LoadBinarySTL(const std::string& filename)
+{
+    MappedFile file(filename);
+    const char* data = file.data();
+    std::size_t size = file.size();
+    constexpr std::size_t headerSize = 84;
+    constexpr std::size_t facetSize = 50;
+    if (size < headerSize) {
+        return false;
+    }
+
+    auto count = readValue<std::uint32_t>(data + 80, false);
+    if (headerSize + facetSize * std::size_t(count) > size) {
+        return false;
+    }
+
+    // the same check as MeshInput::LoadSTL() for ASCII files that accidentally
+    // have a plausible facet count
+    std::size_t numBytes = std::min<std::size_t>(count > 1 ? 100 : 50, size - headerSize);
+    std::string text(data + headerSize, numBytes);
+    std::transform(text.begin(), text.end(), text.begin(), [](char ch) {
+        return static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+    });
+    for (const char* keyword : {"SOLID", "FACET", "NORMAL", "VERTEX", "ENDFACET", "ENDLOOP"}) {
+        if (text.find(keyword) != std::string::npos) {
+            return false;
+        }
+    }
+
+    MeshPointArray points;
+    MeshFacetArray facets(count);
+    auto vertex = [data](std::size_t index) {
+        // skip the normal at the start of the facet
+        return readVector(data + headerSize + facetSize * (index / 3) + 12 * (index % 3 + 1));
+    };
+    if (!MergePoints(3 * std::size_t(count), vertex, points, facets)) {
+        return false;
+    }
+
+    _kernel.Clear();
+    _kernel.Adopt(points, facets, true);
+    ReportProgress(1.0F);
+    return true;
+}
+
+bool ReaderMapped::LoadPLY(const std::string& filename)
+{
+    MappedFile file(filename);
+    const char* data = file.data();
+    std::size_t size = file.size();
+    const char* end = data + size;
+    if (size < 4 || std::memcmp(data, "ply", 3) != 0) {
+        return false;
+    }
+
+    struct Property
+    {
+        std::string name;
+        std::string type;
+        bool list {false};
+        std::string countType;
+    };
+    struct Element
+    {
+        std::string name;
+        std::size_t count {0};
+        std::vector<Property> props;
+    };
+
+    auto sizeOfType = [](const std::string& type) -> std::size_t {
+        if (type == "char" || type == "int8" || type == "uchar" || type == "uint8") {
+            return 1;
+        }
+        if (type == "short" || type == "int16" || type == "ushort" || type == "uint16") {
+            return 2;
+        }
+        if (type == "int" || type == "int32" || type == "uint" || type == "uint32"
+            || type == "float" || type == "float32") {
+            return 4;
+        }
+        if (type == "double" || type == "float64") {
+            return 8;
+        }
+        return 0;
+    };
+
+    // read the header
+    std::string format;
+    std::vector<Element> elements;
+    const char* body = nullptr;
+    forEachLine(data, end, [&](const char* line, const char* last) {
+        std::istringstream str(std::string(line, last));
+        std::string keyword;
+        str >> keyword;
+        if (keyword == "format") {
+            std::string version;
+            str >> format >> version;
+            if (version != "1.0") {
+                format.clear();
+            }
+        }
+        else if (keyword == "element") {
+            Element element;
+            str >> element.name >> element.count;
+            elements.push_back(element);
+        }
+        else if (keyword == "property" && !elements.empty()) {
+            Property prop;
+            str >> prop.type;
+            if (prop.type == "list") {
+                prop.list = true;
+                str >> prop.countType >> prop.type;
+            }
+            str >> prop.name;
+            elements.back().props.push_back(prop);
+        }
+        else if (keyword == "end_header") {
+            body = last < end ? last + 1 : end;
+            return false;
+        }
+        return true;
+    });
+
+    bool swap = false;
+    if (format == "binary_little_endian") {
+        swap = !isLittleEndian();
+    }
+    else if (format == "binary_big_endian") {
+        swap = isLittleEndian();
+    }
+    else {
+        return false;
+    }
+
+    if (!body || elements.size() < 2 || elements[0].name != "vertex"
+        || elements[1].name != "face") {
+        return false;
+    }
+
+    // fixed-size vertices without colors
+    std::size_t vertexSize = 0;
+    std::array<std::size_t, 3> coordOffset {};
+    std::array<std::string, 3> coordType;
+    int numCoords = 0;
+    for (const auto& prop : elements[0].props) {
+        std::size_t propSize = sizeOfType(prop.type);
+        if (prop.list || propSize == 0 || prop.name == "red" || prop.name == "green"
+            || prop.name == "blue" || prop.name.rfind("diffuse_", 0) == 0) {
+            return false;
+        }
+        int coord = prop.name == "x" ? 0 : (prop.name == "y" ? 1 : (prop.name == "z" ? 2 : -1));
+        if (coord >= 0) {
+            coordOffset[coord] = vertexSize;
+            coordType[coord] = prop.type;
+            numCoords++;
+        }
+        vertexSize += propSize;
+    }
+    if (numCoords != 3) {
+        return false;
+    }
+
+    // triangles with one byte count and four byte indices only
+    const auto& faceProps = elements[1].props;
+    if (faceProps.size() != 1 || !faceProps[0].list || sizeOfType(faceProps[0].countType) != 1
+        || sizeOfType(faceProps[0].type) != 4 || faceProps[0].type.rfind("float", 0) == 0
+        || (faceProps[0].name != "vertex_indices" && faceProps[0].name != "vertex_index")) {
+        return false;
+    }
+    constexpr std::size_t faceSize = 1 + 3 * 4;
+
+    std::size_t numPoints = elements[0].count;
+    std::size_t numFacets = elements[1].count;
+    const char* vertexData = body;
+    const char* faceData = vertexData + numPoints * vertexSize;
+    if (std::size_t(end - body) < numPoints * vertexSize + numFacets * faceSize) {
+        return false;
+    }
+
+    auto readCoord = [swap](const char* ptr, const std::string& type) -> float {
+        if (type == "float" || type == "float32") {
+            return readValue<float>(ptr, swap);
+        }
+        if (type == "double" || type == "float64") {
+            return static_cast<float>(readValue<double>(ptr, swap));
+        }
+        if (type == "char" || type == "int8") {
+            return static_cast<float>(readValue<std::int8_t>(ptr, swap));
+        }
+        if (type == "uchar" || type == "uint8") {
+            return static_cast<float>(readValue<std::uint8_t>(ptr, swap));
+        }
+        if (type == "short" || type == "int16") {
+            return static_cast<float>(readValue<std::int16_t>(ptr, swap));
+        }
+        if (type == "ushort" || type == "uint16") {
+            return static_cast<float>(readValue<std::uint16_t>(ptr, swap));
+        }
+        if (type == "int" || type == "int32") {
+            return static_cast<float>(readValue<std::int32_t>(ptr, swap));
+        }
+        return static_cast<float>(readValue<std::uint32_t>(ptr, swap));
+    };
+
+    constexpr std::size_t chunkSize = 1 << 16;
+    MeshPointArray points(numPoints);
+    RunChunks((numPoints + chunkSize - 1) / chunkSize, 0.0F, 0.4F, [&](std::size_t chunk) {
+        std::size_t last = std::min(numPoints, (chunk + 1) * chunkSize);
+        for (std::size_t i = chunk * chunkSize; i < last; i++) {
+            const char* ptr = vertexData + i * vertexSize;
+            points[i] = MeshPoint(Base::Vector3f(readCoord(ptr + coordOffset[0], coordType[0]),
+                                                 readCoord(ptr + coordOffset[1], coordType[1]),
+                                                 readCoord(ptr + coordOffset[2], coordType[2])));
+        }
+    });
+
+    // Facets with out of range indices are removed afterwards
+    std::atomic<bool> triangles {true};
+    MeshFacetArray facets(numFacets);
+    RunChunks((numFacets + chunkSize - 1) / chunkSize, 0.4F, 0.8F, [&](std::size_t chunk) {
+        std::size_t last = std::min(numFacets, (chunk + 1) * chunkSize);
+        for (std::size_t i = chunk * chunkSize; i < last && triangles; i++) {
+            const char* ptr = faceData + i * faceSize;
+            if (*ptr != 3) {
+                triangles = false;
+                break;
+            }
+            facets[i]._aulPoints[0] = readValue<std::uint32_t>(ptr + 1, swap);
+            facets[i]._aulPoints[1] = readValue<std::uint32_t>(ptr + 5, swap);
+            facets[i]._aulPoints[2] = readValue<std::uint32_t>(ptr + 9, swap);
+        }
+    });
+    if (!triangles) {
+        return false;
+    }
+
+    CleanupMesh(points, facets);
+    return true;
+}
+
+bool ReaderMapped::LoadOBJ(const std::string& filename)
+{
+    MappedFile file(filename);
+    const char* data = file.data();
+    std::size_t size = file.size();
+    if (size == 0) {
+        return false;
+    }
+
+    // split the data into chunks of whole lines
+    constexpr std::size_t chunkSize = 1 << 22;
+    std::vector<const char*> bounds {data};
+    while (std::size_t(bounds.back() - data) + chunkSize < size) {
+        const char* pos = bounds.back() + chunkSize;
+        auto next = static_cast<const char*>(std::memchr(pos, '\n', data + size - pos));
+        if (!next) {
+            break;
+        }
+        bounds.push_back(next + 1);
+    }
+    bounds.push_back(data + size);
+    std::size_t numChunks = bounds.size() - 1;
+
+    // count the vertices and triangles of each chunk
+    std::atomic<bool> supported {true};
+    std::vector<std::size_t> pointStart(numChunks + 1);
+    std::vector<std::size_t> facetStart(numChunks + 1);
+    RunChunks(numChunks, 0.0F, 0.3F, [&](std::size_t chunk) {
+        std::size_t numPoints = 0;
+        std::size_t numFacets = 0;
+        forEachLine(bounds[chunk], bounds[chunk + 1], [&](const char* pos, const char* last) {
+            std::array<long long, 4> corners {};
+            Base::Vector3f pnt;
+            switch (classifyObjLine(pos, last)) {
+                case ObjLine::Vertex:
+                    if (!parseObjVertex(pos, last, pnt)) {
+                        supported = false;
+                    }
+                    numPoints++;
+                    break;
+                case ObjLine::Face: {
+                    int count = parseObjFace(pos, last, corners);
+                    if (count == 0) {
+                        supported = false;
+                    }
+                    else {
+                        numFacets += count - 2;
+                    }
+                } break;
+                case ObjLine::Unsupported:
+                    supported = false;
+                    break;
+                default:
+                    break;
+            }
+            return bool(supported);
+        });
+        pointStart[chunk + 1] = numPoints;
+        facetStart[chunk + 1] = numFacets;
+    });
+    if (!supported) {
+        return false;
+    }
+
+    for (std::size_t chunk = 0; chunk < numChunks; chunk++) {
+        pointStart[chunk + 1] += pointStart[chunk];
+        facetStart[chunk + 1] += facetStart[chunk];
+    }
+
+    MeshPointArray points(pointStart[numChunks]);
+    MeshFacetArray facets(facetStart[numChunks]);
+    RunChunks(numChunks, 0.3F, 0.8F, [&](std::size_t chunk) {
+        PointIndex numPoints = pointStart[chunk];
+        FacetIndex numFacets = facetStart[chunk];
+        forEachLine(bounds[chunk], bounds[chunk + 1], [&](const char* pos, const char* last) {
+            std::array<long long, 4> corners {};
+            Base::Vector3f pnt;
+            switch (classifyObjLine(pos, last)) {
+                case ObjLine::Vertex:
+                    parseObjVertex(pos, last, pnt);
+                    points[numPoints++] = MeshPoint(pnt);
+                    break;
+                case ObjLine::Face: {
+                    int count = parseObjFace(pos, last, corners);
+                    // relative indices refer to the vertices read so far, invalid
+                    // indices are removed afterwards
+                    std::array<PointIndex, 4> index {};
+                    for (int i = 0; i < count; i++) {
+                        long long value = corners[i];
+                        index[i] = PointIndex(value > 0 ? value - 1 : value + (long long)numPoints);
+                    }
+                    // the same segment as ReaderOBJ for files without groups
+                    MeshFacet& facet = facets[numFacets++];
+                    facet.SetVertices(index[0], index[1], index[2]);
+                    facet.SetProperty(1);
+                    if (count == 4) {
+                        MeshFacet& other = facets[numFacets++];
+                        other.SetVertices(index[2], index[3], index[0]);
+                        other.SetProperty(1);
+                    }
+                } break;
+                default:
+                    break;
+            }
+            return true;
+        });
+    });
+
+    CleanupMesh(points, facets);
+    return true;
+}
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef MESH_IO_READER_MAPPED_H
+#define MESH_IO_READER_MAPPED_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/MeshGlobal.h>
+
+namespace MeshCore
+{
+
+/** Loads binary STL, binary PLY and OBJ files through a memory mapping.
+ *
+ * The file data is decoded in chunks on all available threads and written
+ * straight into the point and facet arrays of the kernel. Duplicated STL
+ * vertices are merged by distributing them into hash buckets that are then
+ * processed in parallel, so no intermediate facet list is needed.
+ *
+ * Only the common subset of the formats is handled: PLY files must store
+ * vertices without colors followed by triangles, OBJ files must not use
+ * groups, materials or vertex colors. The Load functions return false for
+ * anything else, including files that cannot be mapped, so that the caller
+ * can fall back to the stream based readers.
+ */
+class MeshExport ReaderMapped
+{
+public:
+    /** Gets the fraction of the work done. It is only called from the thread
+     * that started loading. Returning false cancels loading.
+     */
+    using Progress = std::function<bool(float)>;
+
+    explicit ReaderMapped(MeshKernel& kernel);
+
+    void SetProgress(const Progress& progress);
+
+    /// @throw Base::AbortException if cancelled by the progress callback
+    bool LoadBinarySTL(const std::string& filename);
+    /// @throw Base::AbortException if cancelled by the progress callback
+    bool LoadPLY(const std::string& filename);
+    /// @throw Base::AbortException if cancelled by the progress callback
+    bool LoadOBJ(const std::string& filename);
+
+private:
+    template<class Func>
+    void RunChunks(std::size_t count, float from, float to, Func func) const;
+    template<class Vertex>
+    bool MergePoints(std::size_t numVertices,
+                     Vertex vertex,
+                     MeshPointArray& points,
+                     MeshFacetArray& facets) const;
+    void ReportProgress(float value) const;
+    void CleanupMesh(MeshPointArray& points, MeshFacetArray& facets);
+
+private:
+    MeshKernel& _kernel;
+    Progress _progress;
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_IO_READER_MAPPED_H
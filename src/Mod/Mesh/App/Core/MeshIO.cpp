@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <cmath>
 #include <iomanip>
+#include <memory>
 #include <sstream>
 #include <string_view>
 #endif
@@ -37,6 +38,7 @@
 #include <boost/regex.hpp>
 
 #include "IO/Reader3MF.h"
+#include "IO/ReaderMapped.h"
 #include "IO/ReaderOBJ.h"
 #include "IO/ReaderPLY.h"
 #include "IO/Writer3MF.h"
@@ -231,6 +233,17 @@ bool MeshInput::LoadAny(const char* FileName)
         throw Base::FileException("No permission on the file", FileName);
     }
 
+    // binary STL, PLY and OBJ files are preferably decoded in parallel
+    try {
+        if (LoadMapped(FileName)) {
+            return true;
+        }
+    }
+    catch (const Base::AbortException&) {
+        _rclMesh.Clear();
+        return false;
+    }
+
     Base::ifstream str(fi, std::ios::in | std::ios::binary);
 
     if (fi.hasExtension("bms")) {
@@ -280,6 +293,37 @@ bool MeshInput::LoadAny(const char* FileName)
     return ok;
 }
 
+bool MeshInput::LoadMapped(const char* FileName)
+{
+    Base::FileInfo fi(FileName);
+    ReaderMapped reader(_rclMesh);
+
+    // the progress bar is only shown once the file turned out to be supported
+    std::unique_ptr<Base::SequencerLauncher> seq;
+    std::size_t steps = 0;
+    reader.SetProgress([&seq, &steps](float value) {
+        if (!seq) {
+            seq = std::make_unique<Base::SequencerLauncher>("Loading mesh...", 100);
+        }
+        for (auto step = std::size_t(value * 100.0F); steps < step; steps++) {
+            seq->next(true);
+        }
+        return true;
+    });
+
+    if (fi.hasExtension("stl")) {
+        return reader.LoadBinarySTL(FileName);
+    }
+    if (fi.hasExtension("ply")) {
+        return reader.LoadPLY(FileName);
+    }
+    if (fi.hasExtension("obj")) {
+        return reader.LoadOBJ(FileName);
+    }
+
+    return false;
+}
+
 bool MeshInput::LoadFormat(std::istream& input, MeshIO::Format fmt)
 {
     switch (fmt) {
@@ -121,6 +121,10 @@ public:
 
     /// Loads the file, decided by extension
     bool LoadAny(const char* FileName);
+    /** Loads a binary STL, binary PLY or OBJ file through a memory mapping with several
+     * threads. Returns false if the file cannot be handled this way, see ReaderMapped.
+     */
+    bool LoadMapped(const char* FileName);
     /// Loads from a stream and the given format
     bool LoadFormat(std::istream& input, MeshIO::Format fmt);
     /** Loads an STL file either in binary or ASCII format.
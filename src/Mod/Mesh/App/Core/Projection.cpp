@@ -28,6 +28,7 @@
 #include <map>
 #endif
 
+#include "BVH.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
@@ -140,12 +141,6 @@ bool MeshProjection::projectLineOnMesh(const MeshFacetGrid& grid,
                                        const Base::Vector3f& vd,
                                        std::vector<Base::Vector3f>& polyline)
 {
-    Base::Vector3f dir(v2 - v1);
-    Base::Vector3f base(v1), normal(vd % dir);
-    normal.Normalize();
-    dir.Normalize();
-
-
     std::vector<FacetIndex> facets;
 
     // special case: start and endpoint inside same facet
@@ -164,6 +159,50 @@ bool MeshProjection::projectLineOnMesh(const MeshFacetGrid& grid,
         }
     }
 
+    return projectLineOnFacets(facets, v1, f1, v2, f2, vd, polyline);
+}
+
+bool MeshProjection::projectLineOnMesh(const MeshFacetBVH& bvh,
+                                       const Base::Vector3f& v1,
+                                       FacetIndex f1,
+                                       const Base::Vector3f& v2,
+                                       FacetIndex f2,
+                                       const Base::Vector3f& vd,
+                                       std::vector<Base::Vector3f>& polyline)
+{
+    std::vector<FacetIndex> facets;
+
+    // special case: start and endpoint inside same facet
+    if (f1 == f2) {
+        polyline.push_back(v1);
+        polyline.push_back(v2);
+        return true;
+    }
+
+    // cut all facets between the two endpoints, the leaves of the hierarchy
+    // hold disjoint sets of facets
+    bvh.Collect(
+        [&](const Base::BoundBox3f& bbox) {
+            return bboxInsideRectangle(bbox, v1, v2, vd);
+        },
+        facets);
+
+    return projectLineOnFacets(facets, v1, f1, v2, f2, vd, polyline);
+}
+
+bool MeshProjection::projectLineOnFacets(std::vector<FacetIndex>& facets,
+                                         const Base::Vector3f& v1,
+                                         FacetIndex f1,
+                                         const Base::Vector3f& v2,
+                                         FacetIndex f2,
+                                         const Base::Vector3f& vd,
+                                         std::vector<Base::Vector3f>& polyline) const
+{
+    Base::Vector3f dir(v2 - v1);
+    Base::Vector3f base(v1), normal(vd % dir);
+    normal.Normalize();
+    dir.Normalize();
+
     std::sort(facets.begin(), facets.end());
     facets.erase(std::unique(facets.begin(), facets.end()), facets.end());
 
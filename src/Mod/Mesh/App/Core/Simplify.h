@@ -10,7 +10,9 @@
 // * Comment out printf statements
 // * Fix compiler warnings
 // * Remove macros loop,i,j,k
+// * Add locked vertices that are neither moved nor removed, keep the id of the vertices
 
+#include <limits>
 #include <vector>
 
 using vec3f = Base::Vector3f;
@@ -80,7 +82,7 @@ class Simplify
 {
 public:
     struct Triangle { int v[3];double err[4];int deleted,dirty;vec3f n; };
-    struct Vertex { vec3f p;int tstart,tcount;SymmetricMatrix q;int border;};
+    struct Vertex { vec3f p;int tstart,tcount;SymmetricMatrix q;int border;int locked=0;int id=-1;};
     struct Ref { int tid,tvertex; };
     std::vector<Triangle> triangles;
     std::vector<Vertex> vertices;
@@ -194,6 +196,10 @@ void Simplify::simplify_mesh(int target_count, double tolerance, double aggressi
                     if (v0.border != v1.border)
                         continue;
 
+                    // Locked vertices must be kept
+                    if (v0.locked || v1.locked)
+                        continue;
+
                     // Compute vertex to collapse to
                     vec3f p;
                     calculate_error(i0,i1,p);
@@ -474,6 +480,8 @@ void Simplify::compact_mesh()
         {
             vertices[i].tstart=dst;
             vertices[dst].p=vertices[i].p;
+            vertices[dst].locked=vertices[i].locked;
+            vertices[dst].id=vertices[i].id;
             dst++;
         }
     }
@@ -500,6 +508,13 @@ double Simplify::calculate_error(int id_v1, int id_v2, vec3f &p_result)
 {
     // compute interpolated vertex
 
+    // edges of locked vertices are never collapsed
+    if (vertices[id_v1].locked || vertices[id_v2].locked)
+    {
+        p_result=vertices[id_v1].p;
+        return std::numeric_limits<double>::max();
+    }
+
     SymmetricMatrix q = vertices[id_v1].q + vertices[id_v2].q;
     bool   border = vertices[id_v1].border & vertices[id_v2].border;
     double error=0;
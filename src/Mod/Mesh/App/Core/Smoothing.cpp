@@ -59,7 +59,7 @@ void PlaneFitSmoothing::Smooth(unsigned int iterations)
     MeshCore::MeshPointArray PointArray = kernel.GetPoints();
 
     MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel);
     MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
 
     for (unsigned int i = 0; i < iterations; i++) {
@@ -68,12 +68,12 @@ void PlaneFitSmoothing::Smooth(unsigned int iterations)
             MeshCore::PlaneFit pf;
             pf.AddPoint(*v_it);
             center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
+            MeshIndexRange cv = vv_it[v_it.Position()];
             if (cv.size() < 3) {
                 continue;
             }
 
-            std::set<PointIndex>::const_iterator cv_it;
+            MeshIndexRange::const_iterator cv_it;
             for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
                 pf.AddPoint(v_beg[*cv_it]);
                 center += v_beg[*cv_it];
@@ -115,7 +115,7 @@ void PlaneFitSmoothing::SmoothPoints(unsigned int iterations,
     MeshCore::MeshPointArray PointArray = kernel.GetPoints();
 
     MeshCore::MeshPointIterator v_it(kernel);
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel);
     MeshCore::MeshPointArray::_TConstIterator v_beg = kernel.GetPoints().begin();
 
     for (unsigned int i = 0; i < iterations; i++) {
@@ -125,12 +125,12 @@ void PlaneFitSmoothing::SmoothPoints(unsigned int iterations,
             MeshCore::PlaneFit pf;
             pf.AddPoint(*v_it);
             center = *v_it;
-            const std::set<PointIndex>& cv = vv_it[v_it.Position()];
+            MeshIndexRange cv = vv_it[v_it.Position()];
             if (cv.size() < 3) {
                 continue;
             }
 
-            std::set<PointIndex>::const_iterator cv_it;
+            MeshIndexRange::const_iterator cv_it;
             for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
                 pf.AddPoint(v_beg[*cv_it]);
                 center += v_beg[*cv_it];
@@ -169,8 +169,8 @@ LaplaceSmoothing::LaplaceSmoothing(MeshKernel& m)
     : AbstractSmoothing(m)
 {}
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it,
+void LaplaceSmoothing::Umbrella(const MeshCompactPointToPoints& vv_it,
+                                const MeshCompactPointToFacets& vf_it,
                                 double stepsize)
 {
     const MeshCore::MeshPointArray& points = kernel.GetPoints();
@@ -178,7 +178,7 @@ void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
 
     PointIndex pos = 0;
     for (v_it = points.begin(); v_it != v_end; ++v_it, ++pos) {
-        const std::set<PointIndex>& cv = vv_it[pos];
+        MeshIndexRange cv = vv_it[pos];
         if (cv.size() < 3) {
             continue;
         }
@@ -192,7 +192,7 @@ void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
         w = 1.0 / double(n_count);
 
         double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
+        MeshIndexRange::const_iterator cv_it;
         for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
             delx += w * static_cast<double>((v_beg[*cv_it]).x - v_it->x);
             dely += w * static_cast<double>((v_beg[*cv_it]).y - v_it->y);
@@ -206,8 +206,8 @@ void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
     }
 }
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it,
+void LaplaceSmoothing::Umbrella(const MeshCompactPointToPoints& vv_it,
+                                const MeshCompactPointToFacets& vf_it,
                                 double stepsize,
                                 const std::vector<PointIndex>& point_indices)
 {
@@ -215,7 +215,7 @@ void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
     MeshCore::MeshPointArray::_TConstIterator v_beg = points.begin();
 
     for (PointIndex it : point_indices) {
-        const std::set<PointIndex>& cv = vv_it[it];
+        MeshIndexRange cv = vv_it[it];
         if (cv.size() < 3) {
             continue;
         }
@@ -229,7 +229,7 @@ void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
         w = 1.0 / double(n_count);
 
         double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
+        MeshIndexRange::const_iterator cv_it;
         for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
             delx += w * static_cast<double>((v_beg[*cv_it]).x - (v_beg[it]).x);
             dely += w * static_cast<double>((v_beg[*cv_it]).y - (v_beg[it]).y);
@@ -245,8 +245,8 @@ void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
 
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
 
     for (unsigned int i = 0; i < iterations; i++) {
         Umbrella(vv_it, vf_it, lambda);
@@ -256,8 +256,8 @@ void LaplaceSmoothing::Smooth(unsigned int iterations)
 void LaplaceSmoothing::SmoothPoints(unsigned int iterations,
                                     const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
 
     for (unsigned int i = 0; i < iterations; i++) {
         Umbrella(vv_it, vf_it, lambda, point_indices);
@@ -270,8 +270,8 @@ TaubinSmoothing::TaubinSmoothing(MeshKernel& m)
 
 void TaubinSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations + 1) / 2;  // two steps per iteration
@@ -284,8 +284,8 @@ void TaubinSmoothing::Smooth(unsigned int iterations)
 void TaubinSmoothing::SmoothPoints(unsigned int iterations,
                                    const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactPointToPoints vv_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
 
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations + 1) / 2;  // two steps per iteration
@@ -329,8 +329,8 @@ void MedianFilterSmoothing::Smooth(unsigned int iterations)
 {
     std::vector<unsigned long> point_indices(kernel.CountPoints());
     std::generate(point_indices.begin(), point_indices.end(), Base::iotaGen<unsigned long>(0));
-    MeshCore::MeshRefFacetToFacets ff_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactFacetToFacets ff_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
 
     for (unsigned int i = 0; i < iterations; i++) {
         UpdatePoints(ff_it, vf_it, point_indices);
@@ -340,16 +340,16 @@ void MedianFilterSmoothing::Smooth(unsigned int iterations)
 void MedianFilterSmoothing::SmoothPoints(unsigned int iterations,
                                          const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefFacetToFacets ff_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
+    MeshCore::MeshCompactFacetToFacets ff_it(kernel);
+    MeshCore::MeshCompactPointToFacets vf_it(kernel);
 
     for (unsigned int i = 0; i < iterations; i++) {
         UpdatePoints(ff_it, vf_it, point_indices);
     }
 }
 
-void MedianFilterSmoothing::UpdatePoints(const MeshRefFacetToFacets& ff_it,
-                                         const MeshRefPointToFacets& vf_it,
+void MedianFilterSmoothing::UpdatePoints(const MeshCompactFacetToFacets& ff_it,
+                                         const MeshCompactPointToFacets& vf_it,
                                          const std::vector<PointIndex>& point_indices)
 {
     const MeshCore::MeshPointArray& points = kernel.GetPoints();
@@ -367,7 +367,7 @@ void MedianFilterSmoothing::UpdatePoints(const MeshRefFacetToFacets& ff_it,
     for (FacetIndex pos = 0; pos < facets.size(); pos++) {
         iter.Set(pos);
         Base::Vector3d refNormal = Base::toVector<double>(iter->GetNormal());
-        const std::set<FacetIndex>& cv = ff_it[pos];
+        MeshIndexRange cv = ff_it[pos];
         const MeshCore::MeshFacet& facet = facets[pos];
 
         std::vector<AngleNormal> anglesWithFaces;
@@ -396,7 +396,7 @@ void MedianFilterSmoothing::UpdatePoints(const MeshRefFacetToFacets& ff_it,
     // Step 2: move vertices
     for (auto pos : point_indices) {
         Base::Vector3d P = Base::toVector<double>(points[pos]);
-        const std::set<FacetIndex>& cv = vf_it[pos];
+        MeshIndexRange cv = vf_it[pos];
 
         double totalArea = 0.0;
         Base::Vector3d totalvT;
@@ -518,29 +518,46 @@ void MeshObject::save(std::ostream& out) const
 }
 
 void MeshObject::load(std::istream& in)
+{
+    loadAndCheck(in).print();
+}
+
+void MeshObject::LoadMessages::print() const
+{
+    if (!warning.empty()) {
+        Base::Console().warning("%s", warning.c_str());
+    }
+    if (!log.empty()) {
+        Base::Console().log("%s", log.c_str());
+    }
+}
+
+MeshObject::LoadMessages MeshObject::loadAndCheck(std::istream& in)
 {
     _kernel.Read(in);
     this->_segments.clear();
 
+    LoadMessages messages;
 #ifndef FC_DEBUG
     try {
         MeshCore::MeshEvalNeighbourhood nb(_kernel);
         if (!nb.Evaluate()) {
-            Base::Console().warning("Errors in neighbourhood of mesh found...");
+            messages.warning += "Errors in neighbourhood of mesh found...";
             _kernel.RebuildNeighbours();
-            Base::Console().warning("fixed\n");
+            messages.warning += "fixed\n";
         }
 
         MeshCore::MeshEvalTopology eval(_kernel);
         if (!eval.Evaluate()) {
-            Base::Console().warning("The mesh data structure has some defects\n");
+            messages.warning += "The mesh data structure has some defects\n";
         }
     }
     catch (const Base::MemoryException&) {
         // ignore memory exceptions and continue
-        Base::Console().log("Check for defects in mesh data structure failed\n");
+        messages.log += "Check for defects in mesh data structure failed\n";
     }
 #endif
+    return messages;
 }
 
 void MeshObject::writeInventor(std::ostream& str, float creaseangle) const
@@ -209,6 +209,15 @@ public:
     // Save and load in internal format
     void save(std::ostream&) const;
     void load(std::istream&);
+    /// Messages of loadAndCheck() for the warning and the log level
+    struct LoadMessages
+    {
+        std::string warning;
+        std::string log;
+        void print() const;
+    };
+    /// Same as load() but returns the found defects instead of printing them
+    LoadMessages loadAndCheck(std::istream&);
     void writeInventor(std::ostream& str, float creaseangle = 0.0F) const;
     //@}
 
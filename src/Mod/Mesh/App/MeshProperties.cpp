@@ -22,6 +22,9 @@
 
 #include "PreCompiled.h"
 
+#include <unordered_set>
+
+#include <Base/Console.h>
 #include <Base/Converter.h>
 #include <Base/Exception.h>
 #include <Base/Reader.h>
@@ -743,27 +746,42 @@ void PropertyMeshKernel::setValuePtr(MeshObject* mesh)
     // use the tmp. object to guarantee that the referenced mesh is not destroyed
     // before calling hasSetValue()
     Base::Reference<MeshObject> tmp(_meshObject);
-    aboutToSetValue();
+    aboutToChange(tmp == mesh ? PendingChange::Unknown : PendingChange::Detach);
+    discardDeferred();
     _meshObject = mesh;
     hasSetValue();
 }
 
 void PropertyMeshKernel::setValue(const MeshObject& mesh)
 {
-    aboutToSetValue();
-    *_meshObject = mesh;
-    hasSetValue();
+    // the record must not take over the mesh if it is assigned to itself
+    if (&mesh == static_cast<MeshObject*>(_meshObject)) {
+        aboutToSetValue();
+        hasSetValue();
+        return;
+    }
+    MeshObject copy(mesh);
+    replaceMesh(copy);
 }
 
 void PropertyMeshKernel::setValue(const MeshCore::MeshKernel& mesh)
 {
-    aboutToSetValue();
-    _meshObject->setKernel(mesh);
-    hasSetValue();
+    if (&mesh == &_meshObject->getKernel()) {
+        aboutToSetValue();
+        _meshObject->setKernel(mesh);
+        hasSetValue();
+        return;
+    }
+    // like setKernel() keep the transformation and drop the segments
+    MeshObject copy;
+    copy.setKernel(mesh);
+    copy.setTransform(_meshObject->getTransform());
+    replaceMesh(copy);
 }
 
 void PropertyMeshKernel::swapMesh(MeshObject& mesh)
 {
+    loadDeferred();
     aboutToSetValue();
     _meshObject->swap(mesh);
     hasSetValue();
@@ -771,6 +789,7 @@ void PropertyMeshKernel::swapMesh(MeshObject& mesh)
 
 void PropertyMeshKernel::swapMesh(MeshCore::MeshKernel& mesh)
 {
+    loadDeferred();
     aboutToSetValue();
     _meshObject->swap(mesh);
     hasSetValue();
@@ -778,34 +797,41 @@ void PropertyMeshKernel::swapMesh(MeshCore::MeshKernel& mesh)
 
 const MeshObject& PropertyMeshKernel::getValue() const
 {
+    loadDeferred();
     return *_meshObject;
 }
 
 const MeshObject* PropertyMeshKernel::getValuePtr() const
 {
+    loadDeferred();
     return static_cast<MeshObject*>(_meshObject);
 }
 
 const Data::ComplexGeoData* PropertyMeshKernel::getComplexData() const
 {
+    loadDeferred();
     return static_cast<MeshObject*>(_meshObject);
 }
 
 Base::BoundBox3d PropertyMeshKernel::getBoundingBox() const
 {
+    loadDeferred();
     return _meshObject->getBoundBox();
 }
 
 unsigned int PropertyMeshKernel::getMemSize() const
 {
+    loadDeferred();
     unsigned int size = 0;
     size += _meshObject->getMemSize();
+    size += recordedPoints.size() * sizeof(PointList::value_type);
 
     return size;
 }
 
 MeshObject* PropertyMeshKernel::startEditing()
 {
+    loadDeferred();
     aboutToSetValue();
     return static_cast<MeshObject*>(_meshObject);
 }
@@ -817,6 +843,7 @@ void PropertyMeshKernel::finishEditing()
 
 void PropertyMeshKernel::transformGeometry(const Base::Matrix4D& rclMat)
 {
+    loadDeferred();
     aboutToSetValue();
     _meshObject->transformGeometry(rclMat);
     hasSetValue();
@@ -825,7 +852,8 @@ void PropertyMeshKernel::transformGeometry(const Base::Matrix4D& rclMat)
 void PropertyMeshKernel::setPointIndices(
     const std::vector<std::pair<PointIndex, Base::Vector3f>>& inds)
 {
-    aboutToSetValue();
+    loadDeferred();
+    aboutToChange(PendingChange::Points, &inds);
     MeshCore::MeshKernel& kernel = _meshObject->getKernel();
     for (const auto& it : inds) {
         kernel.SetPoint(it.first, it.second);
@@ -845,6 +873,8 @@ Base::Matrix4D PropertyMeshKernel::getTransform() const
 
 PyObject* PropertyMeshKernel::getPyObject()
 {
+    // the Python object accesses the mesh directly
+    loadDeferred();
     if (!meshPyObject) {
         meshPyObject = new MeshPy(
             &*_meshObject);  // Lgtm[cpp/resource-not-released-in-destructor] ** Not destroyed in
@@ -882,6 +912,7 @@ void PropertyMeshKernel::setPyObject(PyObject* value)
 
 void PropertyMeshKernel::Save(Base::Writer& writer) const
 {
+    loadDeferred();
     if (writer.isForceXML()) {
         writer.Stream() << writer.ind() << "<Mesh>" << std::endl;
         MeshCore::MeshOutput saver(_meshObject->getKernel());
@@ -921,6 +952,7 @@ void PropertyMeshKernel::Restore(Base::XMLReader& reader)
 
 void PropertyMeshKernel::SaveDocFile(Base::Writer& writer) const
 {
+    loadDeferred();
     _meshObject->save(writer.Stream());
 }
 
@@ -931,19 +963,180 @@ void PropertyMeshKernel::RestoreDocFile(Base::Reader& reader)
     hasSetValue();
 }
 
+bool PropertyMeshKernel::canDecodeDocFile(const std::string& /*fileName*/) const
+{
+    return true;
+}
+
+std::function<void()> PropertyMeshKernel::decodeDocFile(Base::Reader& reader)
+{
+    // read into a detached mesh, its kernel is swapped in on the main thread
+    auto mesh = std::make_shared<MeshObject>();
+    MeshObject::LoadMessages messages = mesh->loadAndCheck(reader);
+    return [this, mesh, messages]() {
+        messages.print();
+        aboutToSetValue();
+        _meshObject->swap(mesh->getKernel());
+        hasSetValue();
+    };
+}
+
+bool PropertyMeshKernel::canDeferDocFile(const std::string& /*fileName*/) const
+{
+    return true;
+}
+
+void PropertyMeshKernel::restoreDeferred(Base::Reader& reader)
+{
+    _meshObject->load(reader);
+}
+
 App::Property* PropertyMeshKernel::Copy() const
 {
     // Note: Copy the content, do NOT reference the same mesh object
+    loadDeferred();
     PropertyMeshKernel* prop = new PropertyMeshKernel();
     *(prop->_meshObject) = *(this->_meshObject);
+    prop->pointRecord = pointRecord;
+    prop->recordedPointCount = recordedPointCount;
+    prop->recordedPoints = recordedPoints;
     return prop;
 }
 
 void PropertyMeshKernel::Paste(const App::Property& from)
 {
-    // Note: Copy the content, do NOT reference the same mesh object
-    aboutToSetValue();
     const PropertyMeshKernel& prop = dynamic_cast<const PropertyMeshKernel&>(from);
-    *(this->_meshObject) = *(prop._meshObject);
+    if (prop.pointRecord) {
+        // the record only fits the mesh it was taken from
+        loadDeferred();
+        if (_meshObject->getKernel().CountPoints() == prop.recordedPointCount) {
+            setPointIndices(prop.recordedPoints);
+            return;
+        }
+        // The mesh was changed outside of the transaction. Restore the points
+        // that still exist, the same as a full record restores the whole mesh.
+        Base::Console().warning("Undo record of moved points does not match the mesh\n");
+        MeshObject copy(*_meshObject);
+        MeshCore::MeshKernel& kernel = copy.getKernel();
+        for (const auto& it : prop.recordedPoints) {
+            if (it.first < kernel.CountPoints()) {
+                kernel.SetPoint(it.first, it.second);
+            }
+        }
+        replaceMesh(copy);
+        return;
+    }
+
+    // Note: Copy the content, do NOT reference the same mesh object
+    prop.loadDeferred();
+    MeshObject copy(*prop._meshObject);
+    replaceMesh(copy);
+}
+
+void PropertyMeshKernel::replaceMesh(MeshObject& mesh)
+{
+    aboutToChange(PendingChange::Replace);
+    discardDeferred();
+    _meshObject->swap(mesh);
+    // the old mesh goes to the undo record only now that the new one is in place
+    if (replaceRecord) {
+        replaceRecord->_meshObject->swap(mesh);
+        replaceRecord = nullptr;
+    }
     hasSetValue();
 }
+
+void PropertyMeshKernel::aboutToChange(PendingChange change, const PointList* points)
+{
+    pendingChange = change;
+    pendingPoints = points;
+    try {
+        aboutToSetValue();
+    }
+    catch (...) {
+        pendingChange = PendingChange::Unknown;
+        pendingPoints = nullptr;
+        if (replaceRecord) {
+            // the mesh is not replaced, so the record must hold a full copy
+            *(replaceRecord->_meshObject) = *(this->_meshObject);
+            replaceRecord = nullptr;
+        }
+        throw;
+    }
+    pendingChange = PendingChange::Unknown;
+    pendingPoints = nullptr;
+}
+
+App::Property* PropertyMeshKernel::copyForUndo() const
+{
+    switch (pendingChange) {
+        case PendingChange::Replace: {
+            // The mesh is about to be replaced, so instead of a copy the record
+            // receives the old mesh from replaceMesh() after the change.
+            loadDeferred();
+            replaceRecord = new PropertyMeshKernel();
+            return replaceRecord;
+        }
+        case PendingChange::Detach: {
+            // The mesh object is about to be dropped, so the record keeps it
+            // unless someone else shares it. setValuePtr() holds a second
+            // reference during the change.
+            loadDeferred();
+            if (_meshObject.getRefCount() > 2) {
+                return Copy();
+            }
+            PropertyMeshKernel* prop = new PropertyMeshKernel();
+            prop->_meshObject = _meshObject;
+            return prop;
+        }
+        case PendingChange::Points: {
+            PropertyMeshKernel* prop = new PropertyMeshKernel();
+            const MeshCore::MeshKernel& kernel = _meshObject->getKernel();
+            prop->pointRecord = true;
+            prop->recordedPointCount = kernel.CountPoints();
+            prop->recordedPoints.reserve(pendingPoints->size());
+            for (const auto& it : *pendingPoints) {
+                if (it.first < kernel.CountPoints()) {
+                    prop->recordedPoints.emplace_back(it.first, kernel.GetPoint(it.first));
+                }
+            }
+            return prop;
+        }
+        default:
+            return Copy();
+    }
+}
+
+void PropertyMeshKernel::updateUndo(App::Property& record) const
+{
+    auto& prop = dynamic_cast<PropertyMeshKernel&>(record);
+    if (!prop.pointRecord) {
+        return;
+    }
+
+    const MeshCore::MeshKernel& kernel = _meshObject->getKernel();
+    if (pendingChange == PendingChange::Points) {
+        // add the old positions of the points not moved before
+        std::unordered_set<PointIndex> recorded;
+        for (const auto& it : prop.recordedPoints) {
+            recorded.insert(it.first);
+        }
+        for (const auto& it : *pendingPoints) {
+            if (it.first < kernel.CountPoints() && recorded.insert(it.first).second) {
+                prop.recordedPoints.emplace_back(it.first, kernel.GetPoint(it.first));
+            }
+        }
+        return;
+    }
+
+    // Any other change may replace the mesh, so the record becomes a copy of
+    // the mesh from before the first change. Only points were moved since then.
+    *(prop._meshObject) = *(this->_meshObject);
+    MeshCore::MeshKernel& copy = prop._meshObject->getKernel();
+    for (const auto& it : prop.recordedPoints) {
+        copy.SetPoint(it.first, it.second);
+    }
+    prop.pointRecord = false;
+    prop.recordedPointCount = 0;
+    PointList().swap(prop.recordedPoints);
+}
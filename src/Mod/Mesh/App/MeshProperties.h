@@ -315,14 +315,55 @@ public:
 
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
+    bool canDecodeDocFile(const std::string& fileName) const override;
+    std::function<void()> decodeDocFile(Base::Reader& reader) override;
+    bool canDeferDocFile(const std::string& fileName) const override;
 
     App::Property* Copy() const override;
     void Paste(const App::Property& from) override;
+    /** Returns an undo record sized to the announced change
+     * If the whole mesh is about to be replaced the record receives the old
+     * mesh once the new one is in place instead of copying it. If only some
+     * points are about to be moved by setPointIndices() the record only keeps
+     * their positions.
+     */
+    App::Property* copyForUndo() const override;
+    /** Extends a record of moved points by a further change
+     * Further moved points are added to the record, any other change turns it
+     * into a full copy of the mesh from before the first change.
+     */
+    void updateUndo(App::Property& record) const override;
     //@}
 
+protected:
+    void restoreDeferred(Base::Reader& reader) override;
+
+private:
+    using PointList = std::vector<std::pair<PointIndex, Base::Vector3f>>;
+    /// The kind of change announced to copyForUndo()
+    enum class PendingChange
+    {
+        Unknown,
+        Replace,
+        Detach,
+        Points
+    };
+    void aboutToChange(PendingChange change, const PointList* points = nullptr);
+    /// Swaps \a mesh in as the new value, \a mesh receives the old value
+    void replaceMesh(MeshObject& mesh);
+
 private:
     Base::Reference<MeshObject> _meshObject;
     MeshPy* meshPyObject {nullptr};
+    PendingChange pendingChange {PendingChange::Unknown};
+    const PointList* pendingPoints {nullptr};
+    /// The record created for a replacement, it receives the old mesh in replaceMesh()
+    mutable PropertyMeshKernel* replaceRecord {nullptr};
+    /// Set if this is an undo record of moved points only
+    bool pointRecord {false};
+    /// The number of points of the mesh the point record was taken from
+    std::size_t recordedPointCount {0};
+    PointList recordedPoints;
 };
 
 }  // namespace Mesh
@@ -33,6 +33,7 @@
 #include <boost/algorithm/string.hpp>
 
 #include "Core/Degeneration.h"
+#include "Core/HealthCheck.h"
 #include "Core/Segmentation.h"
 #include "Core/Smoothing.h"
 #include "Core/Triangulation.h"
@@ -1333,6 +1334,66 @@ PyObject* MeshPy::getNonUniformOrientedFacets(PyObject* args) const
     return Py::new_reference_to(tuple);
 }
 
+PyObject* MeshPy::getHealthReport(PyObject* args) const
+{
+    float fEpsilon = 0.0F;
+    PyObject* selfIntersections = Py_True;
+    if (!PyArg_ParseTuple(args, "|fO!", &fEpsilon, &PyBool_Type, &selfIntersections)) {
+        return nullptr;
+    }
+
+    MeshCore::MeshHealthReport report;
+    try {
+        MeshCore::MeshHealthCheck check(getMeshObjectPtr()->getKernel(), fEpsilon);
+        check.SetCheckSelfIntersections(Base::asBoolean(selfIntersections));
+        report = check.Evaluate();
+    }
+    catch (const Base::Exception& e) {
+        e.setPyException();
+        return nullptr;
+    }
+
+    auto entry = [](const auto& indices, auto toPython) {
+        Py::Tuple tuple(indices.size());
+        for (std::size_t i = 0; i < indices.size(); i++) {
+            tuple.setItem(i, toPython(indices[i]));
+        }
+        Py::Dict dict;
+        dict.setItem("Count", Py::Long(indices.size()));
+        dict.setItem("Indices", tuple);
+        return dict;
+    };
+    auto index = [](unsigned long value) {
+        return Py::Long(value);
+    };
+    auto pair = [](const auto& value) {
+        Py::Tuple tuple(2);
+        tuple.setItem(0, Py::Long(value.first));
+        tuple.setItem(1, Py::Long(value.second));
+        return tuple;
+    };
+
+    Py::Dict dict;
+    dict.setItem("InvalidPoints", entry(report.invalidPoints, index));
+    dict.setItem("DuplicatedPoints", entry(report.duplicatedPoints, index));
+    dict.setItem("PointsOutOfRange", entry(report.pointsOutOfRange, index));
+    dict.setItem("FacetsOutOfRange", entry(report.facetsOutOfRange, index));
+    dict.setItem("CorruptedFacets", entry(report.corruptedFacets, index));
+    dict.setItem("DegeneratedFacets", entry(report.degeneratedFacets, index));
+    dict.setItem("DuplicatedFacets", entry(report.duplicatedFacets, index));
+    dict.setItem("NonManifoldEdges", entry(report.nonManifoldEdges, pair));
+    dict.setItem("NonManifoldPoints", entry(report.nonManifoldPoints, index));
+    dict.setItem("InvalidNeighbourhood", entry(report.invalidNeighbourhood, index));
+    dict.setItem("NonUniformOrientedFacets", entry(report.nonUniformOrientedFacets, index));
+    dict.setItem("SelfIntersections", entry(report.selfIntersections, pair));
+    dict.setItem("FoldsOnSurface", entry(report.foldsOnSurface, index));
+    dict.setItem("FoldsOnBoundary", entry(report.foldsOnBoundary, index));
+    dict.setItem("FoldOversOnSurface", entry(report.foldOversOnSurface, index));
+    dict.setItem("OpenEdges", Py::Long(report.openEdges));
+    dict.setItem("Valid", Py::Boolean(report.IsValid()));
+    return Py::new_reference_to(dict);
+}
+
 PyObject* MeshPy::harmonizeNormals(PyObject* args) const
 {
     if (!PyArg_ParseTuple(args, "")) {
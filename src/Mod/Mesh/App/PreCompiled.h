@@ -47,11 +47,13 @@
 
 // STL
 #include <algorithm>
+#include <array>
 #include <iomanip>
 #include <iostream>
 #include <list>
 #include <limits>
 #include <map>
+#include <numeric>
 #include <queue>
 #include <set>
 #include <sstream>
@@ -66,6 +66,7 @@ PropertyPartShape::~PropertyPartShape() = default;
 void PropertyPartShape::setValue(const TopoShape& sh)
 {
     aboutToSetValue();
+    discardDeferred();
     _Shape = sh;
     auto obj = freecad_cast<App::DocumentObject*>(getContainer());
     if(obj) {
@@ -87,6 +88,7 @@ void PropertyPartShape::setValue(const TopoShape& sh)
 void PropertyPartShape::setValue(const TopoDS_Shape& sh, bool resetElementMap)
 {
     aboutToSetValue();
+    discardDeferred();
     auto obj = dynamic_cast<App::DocumentObject*>(getContainer());
     if(obj)
         _Shape.Tag = obj->getID();
@@ -97,11 +99,13 @@ void PropertyPartShape::setValue(const TopoDS_Shape& sh, bool resetElementMap)
 
 const TopoDS_Shape& PropertyPartShape::getValue() const
 {
+    loadDeferred();
     return _Shape.getShape();
 }
 
 const TopoShape& PropertyPartShape::getShape() const
 {
+    loadDeferred();
     _Shape.initCache(-1);
     // March, 2024 Toponaming project:  There was originally an unused feature to disable
     // elementMapping that has not been kept:
@@ -118,12 +122,14 @@ const TopoShape& PropertyPartShape::getShape() const
 
 const Data::ComplexGeoData* PropertyPartShape::getComplexData() const
 {
+    loadDeferred();
     _Shape.initCache(-1);
     return &(this->_Shape);
 }
 
 Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 {
+    loadDeferred();
     Base::BoundBox3d box;
     if (_Shape.getShape().IsNull())
         return box;
@@ -150,16 +156,19 @@ Base::BoundBox3d PropertyPartShape::getBoundingBox() const
 
 void PropertyPartShape::setTransform(const Base::Matrix4D &rclTrf)
 {
+    loadDeferred();
     _Shape.setTransform(rclTrf);
 }
 
 Base::Matrix4D PropertyPartShape::getTransform() const
 {
+    loadDeferred();
     return _Shape.getTransform();
 }
 
 void PropertyPartShape::transformGeometry(const Base::Matrix4D &rclTrf)
 {
+    loadDeferred();
     aboutToSetValue();
     _Shape.transformGeometry(rclTrf);
     hasSetValue();
@@ -167,6 +176,7 @@ void PropertyPartShape::transformGeometry(const Base::Matrix4D &rclTrf)
 
 PyObject *PropertyPartShape::getPyObject()
 {
+    loadDeferred();
     Base::PyObjectBase* prop = static_cast<Base::PyObjectBase*>(_Shape.getPyObject());
     if (prop)
         prop->setConst();
@@ -203,6 +213,7 @@ void PropertyPartShape::setPyObject(PyObject *value)
 
 App::Property *PropertyPartShape::Copy() const
 {
+    loadDeferred();
     PropertyPartShape *prop = new PropertyPartShape();
 
     // March, 2024 Toponaming project:  There was originally a feature to enable making an element
@@ -221,6 +232,7 @@ void PropertyPartShape::Paste(const App::Property &from)
 {
     auto prop = freecad_cast<const PropertyPartShape*>(&from);
     if(prop) {
+        prop->loadDeferred();
         setValue(prop->_Shape);
         _Ver = prop->_Ver;
     }
@@ -228,6 +240,7 @@ void PropertyPartShape::Paste(const App::Property &from)
 
 unsigned int PropertyPartShape::getMemSize () const
 {
+    loadDeferred();
     return _Shape.getMemSize();
 }
 
@@ -247,6 +260,7 @@ void PropertyPartShape::getPaths(std::vector<App::ObjectIdentifier> &paths) cons
 
 void PropertyPartShape::beforeSave() const
 {
+    loadDeferred();
     _HasherIndex = 0;
     _SaveHasher = false;
     auto owner = freecad_cast<App::DocumentObject*>(getContainer());
@@ -260,6 +274,7 @@ void PropertyPartShape::beforeSave() const
 void PropertyPartShape::Save (Base::Writer &writer) const
 {
     //See SaveDocFile(), RestoreDocFile()
+    loadDeferred();
     writer.Stream() << writer.ind() << "<Part";
     auto owner = dynamic_cast<App::DocumentObject*>(getContainer());
     if(owner && !_Shape.isNull()
@@ -419,6 +434,9 @@ void PropertyPartShape::afterRestore()
         if (_Shape.Hasher)
             _Shape.Hasher->clear();
     }
+    // The element map has been restored even if the shape is deferred
+    if (isDeferred())
+        checkRestoreFailure(&_Shape);
     PropertyComplexGeoData::afterRestore();
 }
 
@@ -547,18 +565,29 @@ void PropertyPartShape::loadFromFile(Base::Reader &reader)
     setValue(shape);
 }
 
-void PropertyPartShape::loadFromStream(Base::Reader &reader)
+namespace {
+bool readBrepFromStream(Base::Reader &reader, TopoDS_Shape &shape)
 {
     try {
         reader.exceptions(std::istream::failbit | std::istream::badbit);
         BRep_Builder builder;
-        TopoDS_Shape shape;
         BRepTools::Read(shape, reader, builder);
-        setValue(shape);
+        return true;
     }
     catch (const std::exception&) {
-        if (!reader.eof())
-            Base::Console().warning("Failed to load BRep file %s\n", reader.getFileName().c_str());
+        return false;
+    }
+}
+}
+
+void PropertyPartShape::loadFromStream(Base::Reader &reader)
+{
+    TopoDS_Shape shape;
+    if (readBrepFromStream(reader, shape)) {
+        setValue(shape);
+    }
+    else if (!reader.eof()) {
+        Base::Console().warning("Failed to load BRep file %s\n", reader.getFileName().c_str());
     }
 }
 
@@ -566,6 +595,7 @@ void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
 {
     // If the shape is empty we simply store nothing. The file size will be 0 which
     // can be checked when reading in the data.
+    loadDeferred();
     if (_Shape.getShape().IsNull())
         return;
     TopoDS_Shape myShape = _Shape.getShape();
@@ -631,6 +661,87 @@ void PropertyPartShape::RestoreDocFile(Base::Reader &reader)
     _Ver = ver;
 }
 
+bool PropertyPartShape::canDecodeDocFile(const std::string &fileName) const
+{
+    // loadFromFile() goes through a temporary file, keep it on the main thread
+    if (Base::FileInfo(fileName).hasExtension("bin")) {
+        return true;
+    }
+    return App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("DirectAccess", true);
+}
+
+std::function<void()> PropertyPartShape::decodeDocFile(Base::Reader &reader)
+{
+    // Runs on a worker thread, so only parse the shape here and leave the
+    // element map, the hasher and the notification to the returned function
+    TopoShape shape;
+    bool loaded = true;
+    bool warn = false;
+    if (Base::FileInfo(reader.getFileName()).hasExtension("bin")) {
+        shape.importBinary(reader);
+    }
+    else {
+        TopoDS_Shape brep;
+        loaded = readBrepFromStream(reader, brep);
+        warn = !loaded && !reader.eof();
+        shape.setShape(brep);
+    }
+
+    return [this, shape, loaded, warn, fileName = reader.getFileName()]() mutable {
+        if (warn) {
+            Base::Console().warning("Failed to load BRep file %s\n", fileName.c_str());
+        }
+
+        // see RestoreDocFile()
+        auto elementMap = _Shape.resetElementMap();
+        auto hasher = _Shape.Hasher;
+        std::string ver = _Ver;
+        if (!loaded) {
+            shape = getValue();
+        }
+        shape.Hasher = hasher;
+        shape.resetElementMap(elementMap);
+        setValue(shape);
+        _Ver = ver;
+    };
+}
+
+bool PropertyPartShape::canDeferDocFile(const std::string &fileName) const
+{
+    // restoreDeferred() reads the same formats as decodeDocFile()
+    return canDecodeDocFile(fileName);
+}
+
+void PropertyPartShape::restoreDeferred(Base::Reader &reader)
+{
+    TopoShape shape;
+    if (Base::FileInfo(reader.getFileName()).hasExtension("bin")) {
+        shape.importBinary(reader);
+    }
+    else {
+        TopoDS_Shape brep;
+        if (!readBrepFromStream(reader, brep) && !reader.eof()) {
+            Base::Console().warning("Failed to load BRep file %s\n", reader.getFileName().c_str());
+            return;
+        }
+        shape.setShape(brep);
+    }
+
+    // Keep the element map and the hasher restored with the document, see
+    // RestoreDocFile(). The value is logically unchanged, so set it without
+    // notification.
+    auto elementMap = _Shape.resetElementMap();
+    shape.Hasher = _Shape.Hasher;
+    shape.Tag = _Shape.Tag;
+    shape.resetElementMap(elementMap);
+    if (!shape.Tag) {
+        if (auto owner = freecad_cast<App::DocumentObject*>(getContainer()))
+            shape.Tag = owner->getID();
+    }
+    _Shape = shape;
+}
+
 // -------------------------------------------------------------------------
 
 ShapeHistory::ShapeHistory(BRepBuilderAPI_MakeShape& mkShape, TopAbs_ShapeEnum type,
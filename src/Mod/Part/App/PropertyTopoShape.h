@@ -90,6 +90,9 @@ public:
 
     void SaveDocFile (Base::Writer &writer) const override;
     void RestoreDocFile(Base::Reader &reader) override;
+    bool canDecodeDocFile(const std::string &fileName) const override;
+    std::function<void()> decodeDocFile(Base::Reader &reader) override;
+    bool canDeferDocFile(const std::string &fileName) const override;
 
     App::Property *Copy() const override;
     void Paste(const App::Property &from) override;
@@ -106,6 +109,9 @@ public:
 
     friend class Feature;
 
+protected:
+    void restoreDeferred(Base::Reader &reader) override;
+
 private:
     void saveToFile(Base::Writer &writer) const;
     void loadFromFile(Base::Reader &reader);
@@ -26,9 +26,11 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <memory>
 #endif
 
 #include <Base/Matrix.h>
+#include <Base/Tools.h>
 #include <Base/Writer.h>
 
 #include "PointsPy.h"
@@ -45,18 +47,25 @@ PropertyPointKernel::PropertyPointKernel()
 
 void PropertyPointKernel::setValue(const PointKernel& m)
 {
-    aboutToSetValue();
-    *_cPoints = m;
-    hasSetValue();
+    // the record must not take over the points if they are assigned to themselves
+    if (&m == &*_cPoints) {
+        aboutToSetValue();
+        hasSetValue();
+        return;
+    }
+    PointKernel copy(m);
+    replacePoints(copy);
 }
 
 const PointKernel& PropertyPointKernel::getValue() const
 {
+    loadDeferred();
     return *_cPoints;
 }
 
 const Data::ComplexGeoData* PropertyPointKernel::getComplexData() const
 {
+    loadDeferred();
     return _cPoints;
 }
 
@@ -72,11 +81,13 @@ Base::Matrix4D PropertyPointKernel::getTransform() const
 
 Base::BoundBox3d PropertyPointKernel::getBoundingBox() const
 {
+    loadDeferred();
     return _cPoints->getBoundBox();
 }
 
 PyObject* PropertyPointKernel::getPyObject()
 {
+    loadDeferred();
     PointsPy* points = new PointsPy(&*_cPoints);
     points->setConst();  // set immutable
     return points;
@@ -97,6 +108,7 @@ void PropertyPointKernel::setPyObject(PyObject* value)
 
 void PropertyPointKernel::Save(Base::Writer& writer) const
 {
+    loadDeferred();
     _cPoints->Save(writer);
 }
 
@@ -133,8 +145,36 @@ void PropertyPointKernel::RestoreDocFile(Base::Reader& reader)
     hasSetValue();
 }
 
+bool PropertyPointKernel::canDecodeDocFile(const std::string& /*fileName*/) const
+{
+    return true;
+}
+
+std::function<void()> PropertyPointKernel::decodeDocFile(Base::Reader& reader)
+{
+    // read into a detached kernel, its points are swapped in on the main thread
+    auto kernel = std::make_shared<PointKernel>();
+    kernel->RestoreDocFile(reader);
+    return [this, kernel]() {
+        aboutToSetValue();
+        _cPoints->swap(kernel->getBasicPoints());
+        hasSetValue();
+    };
+}
+
+bool PropertyPointKernel::canDeferDocFile(const std::string& /*fileName*/) const
+{
+    return true;
+}
+
+void PropertyPointKernel::restoreDeferred(Base::Reader& reader)
+{
+    _cPoints->RestoreDocFile(reader);
+}
+
 App::Property* PropertyPointKernel::Copy() const
 {
+    loadDeferred();
     PropertyPointKernel* prop = new PropertyPointKernel();
     (*prop->_cPoints) = (*this->_cPoints);
     return prop;
@@ -142,19 +182,70 @@ App::Property* PropertyPointKernel::Copy() const
 
 void PropertyPointKernel::Paste(const App::Property& from)
 {
-    aboutToSetValue();
     const PropertyPointKernel& prop = dynamic_cast<const PropertyPointKernel&>(from);
-    *(this->_cPoints) = *(prop._cPoints);
+    prop.loadDeferred();
+    PointKernel copy(*prop._cPoints);
+    replacePoints(copy);
+}
+
+namespace
+{
+void swapPoints(PointKernel& kernel1, PointKernel& kernel2)
+{
+    kernel1.swap(kernel2.getBasicPoints());
+    Base::Matrix4D mat = kernel1.getTransform();
+    kernel1.setTransform(kernel2.getTransform());
+    kernel2.setTransform(mat);
+}
+}  // namespace
+
+void PropertyPointKernel::replacePoints(PointKernel& points)
+{
+    {
+        Base::StateLocker lock(replacing);
+        try {
+            aboutToSetValue();
+        }
+        catch (...) {
+            if (replaceRecord) {
+                // the points are not replaced, so the record must hold a full copy
+                *(replaceRecord->_cPoints) = *(this->_cPoints);
+                replaceRecord = nullptr;
+            }
+            throw;
+        }
+    }
+    discardDeferred();
+    swapPoints(*_cPoints, points);
+    // the old points go to the undo record only now that the new ones are in place
+    if (replaceRecord) {
+        swapPoints(*replaceRecord->_cPoints, points);
+        replaceRecord = nullptr;
+    }
     hasSetValue();
 }
 
+App::Property* PropertyPointKernel::copyForUndo() const
+{
+    if (!replacing) {
+        return Copy();
+    }
+    // The points are about to be replaced, so instead of a copy the record
+    // receives the old points from replacePoints() after the change.
+    loadDeferred();
+    replaceRecord = new PropertyPointKernel();
+    return replaceRecord;
+}
+
 unsigned int PropertyPointKernel::getMemSize() const
 {
+    loadDeferred();
     return sizeof(Base::Vector3f) * this->_cPoints->size();
 }
 
 PointKernel* PropertyPointKernel::startEditing()
 {
+    loadDeferred();
     aboutToSetValue();
     return static_cast<PointKernel*>(_cPoints);
 }
@@ -166,6 +257,7 @@ void PropertyPointKernel::finishEditing()
 
 void PropertyPointKernel::removeIndices(const std::vector<unsigned long>& uIndices)
 {
+    loadDeferred();
     // We need a sorted array
     std::vector<unsigned long> uSortedInds = uIndices;
     std::sort(uSortedInds.begin(), uSortedInds.end());
@@ -198,6 +290,7 @@ void PropertyPointKernel::removeIndices(const std::vector<unsigned long>& uIndic
 
 void PropertyPointKernel::transformGeometry(const Base::Matrix4D& rclMat)
 {
+    loadDeferred();
     aboutToSetValue();
     _cPoints->transformGeometry(rclMat);
     hasSetValue();
@@ -67,6 +67,8 @@ public:
     App::Property* Copy() const override;
     /// paste the value from the property (mainly for Undo/Redo and transactions)
     void Paste(const App::Property& from) override;
+    /// the record receives the old points after a replacement instead of a copy
+    App::Property* copyForUndo() const override;
     unsigned int getMemSize() const override;
     //@}
 
@@ -76,6 +78,9 @@ public:
     void Restore(Base::XMLReader& reader) override;
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
+    bool canDecodeDocFile(const std::string& fileName) const override;
+    std::function<void()> decodeDocFile(Base::Reader& reader) override;
+    bool canDeferDocFile(const std::string& fileName) const override;
     //@}
 
     /** @name Modification */
@@ -87,8 +92,19 @@ public:
     void removeIndices(const std::vector<unsigned long>&);
     //@}
 
+protected:
+    void restoreDeferred(Base::Reader& reader) override;
+
+private:
+    /// Swaps \a points in as the new value, \a points receives the old value
+    void replacePoints(PointKernel& points);
+
 private:
     Base::Reference<PointKernel> _cPoints;
+    /// true while announcing that all points are about to be replaced
+    bool replacing {false};
+    /// The record created for a replacement, it receives the old points in replacePoints()
+    mutable PropertyPointKernel* replaceRecord {nullptr};
 };
 
 }  // namespace Points
@@ -112,15 +112,6 @@ Cell::Cell(const CellAddress& _address, PropertySheet* _owner)
     , owner(_owner)
     , used(0)
     , alignment(ALIGNMENT_HIMPLIED | ALIGNMENT_LEFT | ALIGNMENT_VIMPLIED | ALIGNMENT_VCENTER)
-    , style()
-    , foregroundColor(0, 0, 0, 1)
-    , backgroundColor(1, 1, 1, 1)
-    , displayUnit()
-    , alias()
-    , computedUnit()
-    , rowSpan(1)
-    , colSpan(1)
-    , anchor()
 {
     assert(address.isValid());
 }
@@ -131,16 +122,14 @@ Cell::Cell(PropertySheet* _owner, const Cell& other)
     , used(other.used)
     , expression(other.expression ? other.expression->copy() : nullptr)
     , alignment(other.alignment)
-    , style(other.style)
-    , foregroundColor(other.foregroundColor)
-    , backgroundColor(other.backgroundColor)
-    , displayUnit(other.displayUnit)
-    , computedUnit(other.computedUnit)
-    , rowSpan(other.rowSpan)
-    , colSpan(other.colSpan)
+    , attributes(other.attributes ? std::make_unique<Attributes>(*other.attributes) : nullptr)
 {
     setUsed(MARK_SET, false);
-    setAlias(other.alias);
+    if (attributes) {
+        // Let setAlias() register the alias with the new owner
+        attributes->alias.clear();
+    }
+    setAlias(other.getAttributes().alias);
     setDirty();
 }
 
@@ -152,13 +141,14 @@ Cell& Cell::operator=(const Cell& rhs)
 
     setExpression(App::ExpressionPtr(rhs.expression ? rhs.expression->copy() : nullptr));
     setAlignment(rhs.alignment);
-    setStyle(rhs.style);
-    setBackground(rhs.backgroundColor);
-    setForeground(rhs.foregroundColor);
-    setDisplayUnit(rhs.displayUnit.stringRep);
-    setComputedUnit(rhs.computedUnit);
-    setAlias(rhs.alias);
-    setSpans(rhs.rowSpan, rhs.colSpan);
+    const Attributes& other = rhs.getAttributes();
+    setStyle(other.style);
+    setBackground(other.backgroundColor);
+    setForeground(other.foregroundColor);
+    setDisplayUnit(other.displayUnit.stringRep);
+    setComputedUnit(other.computedUnit);
+    setAlias(other.alias);
+    setSpans(other.rowSpan, other.colSpan);
 
     setUsed(MARK_SET, false);
     setDirty();
@@ -174,6 +164,30 @@ Cell& Cell::operator=(const Cell& rhs)
 
 Cell::~Cell() = default;
 
+/**
+ * Get the attributes of the cell, or the defaults if none has been set.
+ *
+ */
+
+const Cell::Attributes& Cell::getAttributes() const
+{
+    static const Attributes defaults;
+    return attributes ? *attributes : defaults;
+}
+
+/**
+ * Get the attributes of the cell for modification, allocating them on first use.
+ *
+ */
+
+Cell::Attributes& Cell::editAttributes()
+{
+    if (!attributes) {
+        attributes = std::make_unique<Attributes>();
+    }
+    return *attributes;
+}
+
 /**
  * Set the expression tree to \a expr.
  *
@@ -436,11 +450,11 @@ bool Cell::getAlignment(int& _alignment) const
 
 void Cell::setStyle(const std::set<std::string>& _style)
 {
-    if (_style != style) {
+    if (_style != getAttributes().style) {
         PropertySheet::AtomicPropertyChange signaller(*owner);
 
-        style = _style;
-        setUsed(STYLE_SET, !style.empty());
+        editAttributes().style = _style;
+        setUsed(STYLE_SET, !_style.empty());
         setDirty();
 
         signaller.tryInvoke();
@@ -454,7 +468,7 @@ void Cell::setStyle(const std::set<std::string>& _style)
 
 bool Cell::getStyle(std::set<std::string>& _style) const
 {
-    _style = style;
+    _style = getAttributes().style;
     return isUsed(STYLE_SET);
 }
 
@@ -465,11 +479,11 @@ bool Cell::getStyle(std::set<std::string>& _style) const
 
 void Cell::setForeground(const Base::Color& color)
 {
-    if (color != foregroundColor) {
+    if (color != getAttributes().foregroundColor) {
         PropertySheet::AtomicPropertyChange signaller(*owner);
 
-        foregroundColor = color;
-        setUsed(FOREGROUND_COLOR_SET, foregroundColor != Base::Color(0, 0, 0, 1));
+        editAttributes().foregroundColor = color;
+        setUsed(FOREGROUND_COLOR_SET, color != Base::Color(0, 0, 0, 1));
         setDirty();
 
         signaller.tryInvoke();
@@ -483,7 +497,7 @@ void Cell::setForeground(const Base::Color& color)
 
 bool Cell::getForeground(Base::Color& color) const
 {
-    color = foregroundColor;
+    color = getAttributes().foregroundColor;
     return isUsed(FOREGROUND_COLOR_SET);
 }
 
@@ -494,11 +508,11 @@ bool Cell::getForeground(Base::Color& color) const
 
 void Cell::setBackground(const Base::Color& color)
 {
-    if (color != backgroundColor) {
+    if (color != getAttributes().backgroundColor) {
         PropertySheet::AtomicPropertyChange signaller(*owner);
 
-        backgroundColor = color;
-        setUsed(BACKGROUND_COLOR_SET, backgroundColor != Base::Color(1, 1, 1, 0));
+        editAttributes().backgroundColor = color;
+        setUsed(BACKGROUND_COLOR_SET, color != Base::Color(1, 1, 1, 0));
         setDirty();
 
         signaller.tryInvoke();
@@ -514,7 +528,7 @@ void Cell::setBackground(const Base::Color& color)
 
 bool Cell::getBackground(Base::Color& color) const
 {
-    color = backgroundColor;
+    color = getAttributes().backgroundColor;
     return isUsed(BACKGROUND_COLOR_SET);
 }
 
@@ -536,11 +550,11 @@ void Cell::setDisplayUnit(const std::string& unit)
         newDisplayUnit = DisplayUnit(unit, e->getUnit(), e->getScaler());
     }
 
-    if (newDisplayUnit != displayUnit) {
+    if (newDisplayUnit != getAttributes().displayUnit) {
         PropertySheet::AtomicPropertyChange signaller(*owner);
 
-        displayUnit = std::move(newDisplayUnit);
-        setUsed(DISPLAY_UNIT_SET, !displayUnit.isEmpty());
+        setUsed(DISPLAY_UNIT_SET, !newDisplayUnit.isEmpty());
+        editAttributes().displayUnit = std::move(newDisplayUnit);
         setDirty();
 
         signaller.tryInvoke();
@@ -556,12 +570,13 @@ void Cell::setDisplayUnit(const std::string& unit)
 
 bool Cell::getDisplayUnit(DisplayUnit& unit) const
 {
-    unit = displayUnit;
+    unit = getAttributes().displayUnit;
     return isUsed(DISPLAY_UNIT_SET);
 }
 
 void Cell::setAlias(const std::string& n)
 {
+    const std::string& alias = getAttributes().alias;
     if (alias != n) {
         PropertySheet::AtomicPropertyChange signaller(*owner);
 
@@ -582,9 +597,9 @@ void Cell::setAlias(const std::string& n)
             docObj->removeDynamicProperty(alias.c_str());
         }
 
-        alias = n;
+        editAttributes().alias = n;
 
-        setUsed(ALIAS_SET, !alias.empty());
+        setUsed(ALIAS_SET, !n.empty());
         setDirty();
 
         signaller.tryInvoke();
@@ -593,7 +608,7 @@ void Cell::setAlias(const std::string& n)
 
 bool Cell::getAlias(std::string& n) const
 {
-    n = alias;
+    n = getAttributes().alias;
     return isUsed(ALIAS_SET);
 }
 
@@ -606,8 +621,10 @@ void Cell::setComputedUnit(const Base::Unit& unit)
 {
     PropertySheet::AtomicPropertyChange signaller(*owner);
 
-    computedUnit = unit;
-    setUsed(COMPUTED_UNIT_SET, !computedUnit.isEmpty());
+    if (attributes || !unit.isEmpty()) {
+        editAttributes().computedUnit = unit;
+    }
+    setUsed(COMPUTED_UNIT_SET, !unit.isEmpty());
     setDirty();
 
     signaller.tryInvoke();
@@ -622,7 +639,7 @@ void Cell::setComputedUnit(const Base::Unit& unit)
 
 bool Cell::getComputedUnit(Base::Unit& unit) const
 {
-    unit = computedUnit;
+    unit = getAttributes().computedUnit;
     return isUsed(COMPUTED_UNIT_SET);
 }
 
@@ -634,12 +651,14 @@ bool Cell::getComputedUnit(Base::Unit& unit) const
 
 void Cell::setSpans(int rows, int columns)
 {
-    if (rows != rowSpan || columns != colSpan) {
+    const Attributes& current = getAttributes();
+    if (rows != current.rowSpan || columns != current.colSpan) {
         PropertySheet::AtomicPropertyChange signaller(*owner);
 
-        rowSpan = (rows == -1 ? 1 : rows);
-        colSpan = (columns == -1 ? 1 : columns);
-        setUsed(SPANS_SET, (rowSpan != 1 || colSpan != 1));
+        Attributes& attrs = editAttributes();
+        attrs.rowSpan = (rows == -1 ? 1 : rows);
+        attrs.colSpan = (columns == -1 ? 1 : columns);
+        setUsed(SPANS_SET, (attrs.rowSpan != 1 || attrs.colSpan != 1));
         setDirty();
         signaller.tryInvoke();
     }
@@ -652,8 +671,8 @@ void Cell::setSpans(int rows, int columns)
 
 bool Cell::getSpans(int& rows, int& columns) const
 {
-    rows = rowSpan;
-    columns = colSpan;
+    rows = getAttributes().rowSpan;
+    columns = getAttributes().colSpan;
     return isUsed(SPANS_SET);
 }
 
@@ -662,7 +681,7 @@ void Cell::setException(const std::string& e, bool silent)
     if (!silent && !e.empty() && owner && owner->sheet()) {
         FC_ERR(owner->sheet()->getFullName() << '.' << address.toString() << ": " << e);
     }
-    exceptionStr = e;
+    editAttributes().exceptionStr = e;
     setUsed(EXCEPTION_SET);
 }
 
@@ -671,7 +690,7 @@ void Cell::setParseException(const std::string& e)
     if (!e.empty() && owner && owner->sheet()) {
         FC_ERR(owner->sheet()->getFullName() << '.' << address.toString() << ": " << e);
     }
-    exceptionStr = e;
+    editAttributes().exceptionStr = e;
     setUsed(PARSE_EXCEPTION_SET);
 }
 
@@ -680,7 +699,7 @@ void Cell::setResolveException(const std::string& e)
     if (!e.empty() && owner && owner->sheet()) {
         FC_LOG(owner->sheet()->getFullName() << '.' << address.toString() << ": " << e);
     }
-    exceptionStr = e;
+    editAttributes().exceptionStr = e;
     setUsed(RESOLVE_EXCEPTION_SET);
 }
 
@@ -691,7 +710,9 @@ void Cell::clearResolveException()
 
 void Cell::clearException()
 {
-    exceptionStr.clear();
+    if (attributes) {
+        attributes->exceptionStr.clear();
+    }
     setUsed(EXCEPTION_SET, false);
     setUsed(RESOLVE_EXCEPTION_SET, false);
     setUsed(PARSE_EXCEPTION_SET, false);
@@ -844,28 +865,29 @@ void Cell::save(std::ostream& os, const char* indent, bool noContent) const
     }
 
     if (isUsed(STYLE_SET)) {
-        os << "style=\"" << encodeStyle(style) << "\" ";
+        os << "style=\"" << encodeStyle(getAttributes().style) << "\" ";
     }
 
     if (isUsed(FOREGROUND_COLOR_SET)) {
-        os << "foregroundColor=\"" << encodeColor(foregroundColor) << "\" ";
+        os << "foregroundColor=\"" << encodeColor(getAttributes().foregroundColor) << "\" ";
     }
 
     if (isUsed(BACKGROUND_COLOR_SET)) {
-        os << "backgroundColor=\"" << encodeColor(backgroundColor) << "\" ";
+        os << "backgroundColor=\"" << encodeColor(getAttributes().backgroundColor) << "\" ";
     }
 
     if (isUsed(DISPLAY_UNIT_SET)) {
-        os << "displayUnit=\"" << App::Property::encodeAttribute(displayUnit.stringRep) << "\" ";
+        os << "displayUnit=\""
+           << App::Property::encodeAttribute(getAttributes().displayUnit.stringRep) << "\" ";
     }
 
     if (isUsed(ALIAS_SET)) {
-        os << "alias=\"" << App::Property::encodeAttribute(alias) << "\" ";
+        os << "alias=\"" << App::Property::encodeAttribute(getAttributes().alias) << "\" ";
     }
 
     if (isUsed(SPANS_SET)) {
-        os << "rowSpan=\"" << rowSpan << "\" ";
-        os << "colSpan=\"" << colSpan << "\" ";
+        os << "rowSpan=\"" << getAttributes().rowSpan << "\" ";
+        os << "colSpan=\"" << getAttributes().colSpan << "\" ";
     }
 
     os << "/>";
@@ -1113,7 +1135,7 @@ std::string Cell::getFormattedQuantity()
             if (computedUnit.isEmpty() || computedUnit == du.unit) {
                 QString number =
                     QLocale().toString(rawVal / duScale, 'f', Base::UnitsApi::getDecimals());
-                qFormatted = number + QString::fromStdString(" " + displayUnit.stringRep);
+                qFormatted = number + QString::fromStdString(" " + du.stringRep);
             }
         }
     }
@@ -1126,7 +1148,7 @@ std::string Cell::getFormattedQuantity()
         if (hasDisplayUnit) {
             QString number =
                 QLocale().toString(rawVal / duScale, 'f', Base::UnitsApi::getDecimals());
-            qFormatted = number + QString::fromStdString(" " + displayUnit.stringRep);
+            qFormatted = number + QString::fromStdString(" " + du.stringRep);
         }
     }
     else if (prop->isDerivedFrom<App::PropertyInteger>()) {
@@ -1139,7 +1161,7 @@ std::string Cell::getFormattedQuantity()
         if (hasDisplayUnit) {
             QString number =
                 QLocale().toString(rawVal / duScale, 'f', Base::UnitsApi::getDecimals());
-            qFormatted = number + QString::fromStdString(" " + displayUnit.stringRep);
+            qFormatted = number + QString::fromStdString(" " + du.stringRep);
         }
     }
     return qFormatted.toStdString();
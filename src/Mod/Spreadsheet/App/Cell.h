@@ -23,6 +23,7 @@
 #ifndef CELL_H
 #define CELL_H
 
+#include <memory>
 #include <set>
 #include <string>
 
@@ -104,7 +105,7 @@ public:
 
     const std::string& getException() const
     {
-        return exceptionStr;
+        return getAttributes().exceptionStr;
     }
 
     bool hasException() const
@@ -177,6 +178,24 @@ private:
 
     void unfreeze();
 
+    /* Attributes that most cells keep at their defaults */
+    struct Attributes
+    {
+        std::set<std::string> style;
+        Base::Color foregroundColor {0, 0, 0, 1};
+        Base::Color backgroundColor {1, 1, 1, 1};
+        DisplayUnit displayUnit;
+        std::string alias;
+        Base::Unit computedUnit;
+        int rowSpan {1};
+        int colSpan {1};
+        std::string exceptionStr;
+    };
+
+    const Attributes& getAttributes() const;
+
+    Attributes& editAttributes();
+
     /* Used */
     static const int EXPRESSION_SET;
     static const int ALIGNMENT_SET;
@@ -198,16 +217,8 @@ private:
     int used;
     mutable App::ExpressionPtr expression;
     int alignment;
-    std::set<std::string> style;
-    Base::Color foregroundColor;
-    Base::Color backgroundColor;
-    DisplayUnit displayUnit;
-    std::string alias;
-    Base::Unit computedUnit;
-    int rowSpan;
-    int colSpan;
-    std::string exceptionStr;
-    App::CellAddress anchor;
+    /* Allocated when the first attribute is set, keeps plain cells small */
+    std::unique_ptr<Attributes> attributes;
     friend class PropertySheet;
 };
 
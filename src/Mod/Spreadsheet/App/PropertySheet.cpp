@@ -23,6 +23,10 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
 
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/algorithm/copy.hpp>
@@ -73,6 +77,9 @@ void PropertySheet::clear()
     cellToPropertyNameMap.clear();
     documentObjectToCellMap.clear();
     cellToDocumentObjectMap.clear();
+    cellDependants.clear();
+    cellPrecedents.clear();
+    cellLevelsValid = false;
     aliasProp.clear();
     revAliasProp.clear();
 
@@ -289,6 +296,8 @@ PropertySheet::PropertySheet(const PropertySheet& other)
     , cellToPropertyNameMap(other.cellToPropertyNameMap)
     , documentObjectToCellMap(other.documentObjectToCellMap)
     , cellToDocumentObjectMap(other.cellToDocumentObjectMap)
+    , cellDependants(other.cellDependants)
+    , cellPrecedents(other.cellPrecedents)
     , aliasProp(other.aliasProp)
     , revAliasProp(other.revAliasProp)
     , updateCount(other.updateCount)
@@ -703,6 +712,37 @@ void PropertySheet::setContent(CellAddress address, const char* value)
     cell->setContent(value);
 }
 
+void PropertySheet::importContent(CellAddress address, const char* value)
+{
+    if (*value == '=' || *value == '\'' || data.count(address) || mergedCells.count(address)) {
+        setContent(address, value);
+        return;
+    }
+
+    // Same classification as Cell::setContent(), which handles everything
+    // that is neither a plain number nor a plain text
+    App::ExpressionPtr expr;
+    char* end;
+    errno = 0;
+    const double number = strtod(value, &end);
+    if (end == value) {
+        expr = std::make_unique<App::StringExpression>(owner, value);
+    }
+    else if (errno == 0 && strspn(end, " \t\n\r") == strlen(end)) {
+        expr = std::make_unique<App::NumberExpression>(owner, Base::Quantity(number));
+    }
+    else {
+        setContent(address, value);
+        return;
+    }
+
+    // A constant has no dependencies, so there is no need to update them
+    Cell* cell = createCell(address);
+    cell->expression = std::move(expr);
+    cell->setUsed(Cell::EXPRESSION_SET);
+    setDirty(address);
+}
+
 void PropertySheet::setAlignment(CellAddress address, int _alignment)
 {
     Cell* cell = nonNullCellAt(address);
@@ -1386,6 +1426,14 @@ void PropertySheet::addDependencies(CellAddress key)
                 propertyNameToCellMap[propName].insert(key);
                 cellToPropertyNameMap[key].insert(propName);
 
+                // Reference to a cell of this sheet?
+                if (docObj == owner && !name.empty()) {
+                    CellAddress from = App::stringToAddress(name.c_str(), true);
+                    if (from.isValid()) {
+                        addCellDependency(from, key);
+                    }
+                }
+
                 // Also an alias?
                 if (!name.empty() && docObj->isDerivedFrom<Sheet>()) {
                     auto other = static_cast<Sheet*>(docObj);
@@ -1398,6 +1446,10 @@ void PropertySheet::addDependencies(CellAddress key)
                         // Insert into maps
                         propertyNameToCellMap[propName].insert(key);
                         cellToPropertyNameMap[key].insert(std::move(propName));
+
+                        if (docObj == owner) {
+                            addCellDependency(j->second, key);
+                        }
                     }
                 }
             }
@@ -1462,6 +1514,88 @@ void PropertySheet::removeDependencies(CellAddress key)
         cellToDocumentObjectMap.erase(i2);
         ++updateCount;
     }
+
+    /* Remove from cell <-> cell maps */
+
+    auto i3 = cellPrecedents.find(key);
+
+    if (i3 != cellPrecedents.end()) {
+        for (const auto& from : i3->second) {
+            auto k = cellDependants.find(from);
+
+            if (k != cellDependants.end()) {
+                k->second.erase(key);
+
+                if (k->second.empty()) {
+                    cellDependants.erase(k);
+                }
+            }
+        }
+
+        cellPrecedents.erase(i3);
+        cellLevelsValid = false;
+    }
+}
+
+/**
+ * Record that the cell at \a to depends on the cell at \a from of the same sheet.
+ */
+
+void PropertySheet::addCellDependency(CellAddress from, CellAddress to)
+{
+    if (cellDependants[from].insert(to).second) {
+        cellPrecedents[to].insert(from);
+        cellLevelsValid = false;
+    }
+}
+
+/**
+ * Assign an evaluation level to the cells of the dependency graph.
+ *
+ * A cell gets a level one higher than the highest level of the cells it
+ * depends on, so cells of equal level do not depend on each other. Cells on a
+ * cycle, and the cells depending on them, never become ready and get level -1.
+ */
+
+void PropertySheet::updateCellLevels() const
+{
+    if (cellLevelsValid) {
+        return;
+    }
+    cellLevels.clear();
+
+    std::map<CellAddress, std::size_t> pending;
+    std::deque<CellAddress> ready;
+    for (const auto& v : cellDependants) {
+        if (!cellPrecedents.count(v.first)) {
+            cellLevels[v.first] = 0;
+            ready.push_back(v.first);
+        }
+    }
+    for (const auto& v : cellPrecedents) {
+        pending[v.first] = v.second.size();
+        cellLevels[v.first] = -1;
+    }
+
+    while (!ready.empty()) {
+        CellAddress from = ready.front();
+        ready.pop_front();
+        int level = cellLevels[from] + 1;
+
+        auto it = cellDependants.find(from);
+        if (it == cellDependants.end()) {
+            continue;
+        }
+        for (const auto& to : it->second) {
+            auto& count = pending[to];
+            if (--count == 0) {
+                // All precedents are done, the last one has the highest level
+                cellLevels[to] = level;
+                ready.push_back(to);
+            }
+        }
+    }
+    cellLevelsValid = true;
 }
 
 /**
@@ -1645,6 +1779,79 @@ const std::set<std::string>& PropertySheet::getDeps(CellAddress pos) const
     }
 }
 
+const std::set<CellAddress>& PropertySheet::getDependants(CellAddress pos) const
+{
+    static std::set<CellAddress> empty;
+    auto i = cellDependants.find(pos);
+
+    if (i != cellDependants.end()) {
+        return i->second;
+    }
+    else {
+        return empty;
+    }
+}
+
+bool PropertySheet::getEvaluationOrder(const std::set<CellAddress>& dirtyCells,
+                                       std::vector<CellAddress>& order) const
+{
+    updateCellLevels();
+
+    // Collect the dirty cells and everything depending on them
+    std::set<CellAddress> visited(dirtyCells.begin(), dirtyCells.end());
+    std::deque<CellAddress> workQueue(dirtyCells.begin(), dirtyCells.end());
+    std::vector<std::pair<int, CellAddress>> sorted;
+    sorted.reserve(dirtyCells.size());
+
+    while (!workQueue.empty()) {
+        CellAddress pos = workQueue.front();
+        workQueue.pop_front();
+
+        int level = 0;
+        auto it = cellLevels.find(pos);
+        if (it != cellLevels.end()) {
+            if (it->second < 0) {
+                return false;
+            }
+            level = it->second;
+        }
+        sorted.emplace_back(level, pos);
+
+        for (const auto& dep : getDependants(pos)) {
+            if (visited.insert(dep).second) {
+                workQueue.push_back(dep);
+            }
+        }
+    }
+
+    std::sort(sorted.begin(), sorted.end());
+    order.clear();
+    order.reserve(sorted.size());
+    for (const auto& v : sorted) {
+        order.push_back(v.second);
+    }
+    return true;
+}
+
+int PropertySheet::getEvaluationLevel(CellAddress pos) const
+{
+    updateCellLevels();
+    auto it = cellLevels.find(pos);
+    return it != cellLevels.end() ? it->second : 0;
+}
+
+bool PropertySheet::isSelfContained(CellAddress pos) const
+{
+    auto it = cellToDocumentObjectMap.find(pos);
+    if (it == cellToDocumentObjectMap.end()) {
+        return true;
+    }
+    std::string fullName = owner->getFullName();
+    return std::all_of(it->second.begin(), it->second.end(), [&](const std::string& name) {
+        return name == fullName;
+    });
+}
+
 void PropertySheet::recomputeDependencies(CellAddress key)
 {
     AtomicPropertyChange signaller(*this);
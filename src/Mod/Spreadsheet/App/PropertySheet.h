@@ -24,6 +24,7 @@
 #define PROPERTYSHEET_H
 
 #include <map>
+#include <vector>
 
 #include <App/DocumentObject.h>
 #include <App/PropertyLinks.h>
@@ -94,6 +95,15 @@ public:
 
     void setContent(App::CellAddress address, const char* value);
 
+    /*! Set the content of the empty cell at \a address from imported text.
+     *
+     * Plain numbers and texts are stored directly, anything else goes through
+     * Cell::setContent(). Used to fill cells in bulk, e.g. by
+     * Sheet::importFromFile(), the caller is expected to hold an
+     * AtomicPropertyChange.
+     */
+    void importContent(App::CellAddress address, const char* value);
+
     void setAlignment(App::CellAddress address, int _alignment);
 
     void setStyle(App::CellAddress address, const std::set<std::string>& _style);
@@ -202,6 +212,26 @@ public:
 
     void recomputeDependencies(App::CellAddress key);
 
+    /*! Cells of this sheet that directly depend on the cell at \a pos */
+    const std::set<App::CellAddress>& getDependants(App::CellAddress pos) const;
+
+    /*! Compute the cells to recompute when \a dirtyCells change.
+     *
+     * The result contains \a dirtyCells and all cells of this sheet that
+     * depend on them, directly or indirectly, ordered so that every cell comes
+     * after the cells it depends on. Returns false if any of these cells is
+     * part of, or depends on, a dependency cycle. The order is then incomplete.
+     */
+    bool getEvaluationOrder(const std::set<App::CellAddress>& dirtyCells,
+                            std::vector<App::CellAddress>& order) const;
+
+    /*! Evaluation level of the cell at \a pos, cells of the same level do not
+      depend on each other. Returns -1 for cells on or after a cycle. */
+    int getEvaluationLevel(App::CellAddress pos) const;
+
+    /*! Check whether the cell at \a pos only refers to cells of this sheet */
+    bool isSelfContained(App::CellAddress pos) const;
+
     PyObject* getPyObject() override;
     void setPyObject(PyObject*) override;
 
@@ -322,6 +352,25 @@ private:
     /*! DocumentObject this cell depends on */
     std::map<App::CellAddress, std::set<std::string>> cellToDocumentObjectMap;
 
+    /*! Cell dependencies within this sheet, i.e when the cell given in key
+      changes, the set of addresses needs to be recomputed.
+      */
+    std::map<App::CellAddress, std::set<App::CellAddress>> cellDependants;
+
+    /*! Cells of this sheet the cell given in key depends on */
+    std::map<App::CellAddress, std::set<App::CellAddress>> cellPrecedents;
+
+    /*! Evaluation level of the cells in cellDependants and cellPrecedents.
+      Cells without precedents have level 0, cells on or after a cycle -1.
+      Rebuilt on demand after the dependencies changed.
+      */
+    mutable std::map<App::CellAddress, int> cellLevels;
+    mutable bool cellLevelsValid = false;
+
+    void addCellDependency(App::CellAddress from, App::CellAddress to);
+
+    void updateCellLevels() const;
+
     /*! Mapping of cell position to alias property */
     std::map<App::CellAddress, std::string> aliasProp;
 
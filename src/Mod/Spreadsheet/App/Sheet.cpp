@@ -23,9 +23,11 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+#include <algorithm>
 #include <boost/tokenizer.hpp>
 #include <boost/regex.hpp>
 #include <deque>
+#include <future>
 #include <memory>
 #include <sstream>
 #include <tuple>
@@ -33,10 +35,12 @@
 #include <map>
 #include <string>
 #include <set>
+#include <thread>
 #include <vector>
 #endif
 
 #include <App/Application.h>
+#include <App/ChangeBatch.h>
 #include <App/Document.h>
 #include <App/DynamicProperty.h>
 #include <App/ExpressionParser.h>
@@ -72,6 +76,9 @@ using Traits = boost::graph_traits<DependencyList>;
 using Vertex = Traits::vertex_descriptor;
 using Edge = Traits::edge_descriptor;
 
+// Levels with fewer natively evaluated cells are not worth spreading over threads
+static constexpr std::size_t MinConcurrentCells = 64;
+
 /**
  * Construct a new Sheet object.
  */
@@ -251,7 +258,7 @@ bool Sheet::importFromFile(const std::string& filename,
                      i != tok.end();
                      ++i) {
                     if (!i->empty()) {
-                        setCell(CellAddress(row, col), (*i).c_str());
+                        cells.importContent(CellAddress(row, col), (*i).c_str());
                     }
                     col++;
                 }
@@ -768,7 +775,7 @@ struct CurrentAddressLock
  *
  */
 
-void Sheet::updateProperty(CellAddress key)
+void Sheet::updateProperty(CellAddress key, std::unique_ptr<Expression> value)
 {
     Cell* cell = getCell(key);
 
@@ -776,7 +783,10 @@ void Sheet::updateProperty(CellAddress key)
         std::unique_ptr<Expression> output;
         const Expression* input = cell->getExpression();
 
-        if (input) {
+        if (input && value) {
+            output = std::move(value);
+        }
+        else if (input) {
             CurrentAddressLock lock(currentRow, currentCol, key);
             output.reset(input->eval());
         }
@@ -917,7 +927,7 @@ void Sheet::recomputeCells(Range range)
  * @param p Address of cell.
  */
 
-void Sheet::recomputeCell(CellAddress p)
+void Sheet::recomputeCell(CellAddress p, std::unique_ptr<Expression> value)
 {
     Cell* cell = cells.getValue(p);
 
@@ -928,7 +938,7 @@ void Sheet::recomputeCell(CellAddress p)
             cell->setContent(content.c_str());
         }
 
-        updateProperty(p);
+        updateProperty(p, std::move(value));
 
         if (!cell || !cell->hasException()) {
             cells.clearDirty(p);
@@ -956,6 +966,73 @@ void Sheet::recomputeCell(CellAddress p)
     }
 }
 
+/**
+ * @brief Recompute the cells in \a order, which must be sorted by evaluation level.
+ *
+ * Cells of the same level do not depend on each other. Cells that only do
+ * arithmetic on other cells of this sheet are evaluated without Python, on
+ * several threads for large levels. Their values are then assigned on the
+ * calling thread, before the remaining cells of the level are recomputed.
+ *
+ * @param order Addresses of the cells to recompute.
+ */
+
+void Sheet::recomputeInOrder(const std::vector<CellAddress>& order)
+{
+    const unsigned threads = std::thread::hardware_concurrency();
+    std::size_t begin = 0;
+    while (begin < order.size()) {
+        int level = cells.getEvaluationLevel(order[begin]);
+        std::size_t end = begin + 1;
+        while (end < order.size() && cells.getEvaluationLevel(order[end]) == level) {
+            ++end;
+        }
+
+        std::vector<std::pair<CellAddress, const Expression*>> native;
+        std::vector<CellAddress> serial;
+        for (std::size_t i = begin; i < end; ++i) {
+            const Cell* cell = cells.getValue(order[i]);
+            const Expression* expr =
+                cell && !cell->hasException() ? cell->getExpression() : nullptr;
+            if (expr && cells.isSelfContained(order[i]) && expr->isNative()) {
+                native.emplace_back(order[i], expr);
+            }
+            else {
+                serial.push_back(order[i]);
+            }
+        }
+
+        std::vector<std::unique_ptr<Expression>> values(native.size());
+        if (threads > 1 && native.size() >= MinConcurrentCells) {
+            std::size_t chunk = (native.size() + threads - 1) / threads;
+            std::vector<std::future<void>> tasks;
+            for (std::size_t first = 0; first < native.size(); first += chunk) {
+                std::size_t last = std::min(first + chunk, native.size());
+                tasks.push_back(std::async(std::launch::async, [&native, &values, first, last]() {
+                    for (std::size_t i = first; i < last; ++i) {
+                        values[i].reset(native[i].second->evalNative());
+                    }
+                }));
+            }
+            for (auto& task : tasks) {
+                task.get();
+            }
+        }
+
+        // Cells without a value, e.g. on a unit mismatch, are evaluated again
+        // by recomputeCell() to report the error
+        for (std::size_t i = 0; i < native.size(); ++i) {
+            FC_TRACE(native[i].first.toString());
+            recomputeCell(native[i].first, std::move(values[i]));
+        }
+        for (const auto& addr : serial) {
+            FC_TRACE(addr.toString());
+            recomputeCell(addr);
+        }
+        begin = end;
+    }
+}
+
 PropertySheet::BindingType Sheet::getCellBinding(Range& range,
                                                  ExpressionPtr* pStart,
                                                  ExpressionPtr* pEnd,
@@ -1063,122 +1140,133 @@ DocumentObjectExecReturn* Sheet::execute()
         dirtyCells.insert(cellError);
     }
 
-    DependencyList graph;
-    std::map<CellAddress, Vertex> VertexList;
-    std::map<Vertex, CellAddress> VertexIndexList;
-    std::deque<CellAddress> workQueue(dirtyCells.begin(), dirtyCells.end());
-    while (!workQueue.empty()) {
-        CellAddress currPos = workQueue.front();
-        workQueue.pop_front();
-
-        // Insert into map of CellPos -> Index, if it doesn't exist already
-        auto res = VertexList.emplace(currPos, Vertex());
-        if (res.second) {
-            res.first->second = add_vertex(graph);
-            VertexIndexList[res.first->second] = currPos;
-        }
+    std::vector<CellAddress> order;
+    if (cells.getEvaluationOrder(dirtyCells, order)) {
+        // Recompute cells, signaling each changed cell property once
+        FC_LOG("recomputing " << getFullName());
+        App::ChangeBatch batch;
+        recomputeInOrder(order);
+    }
+    else {
+        // A dependency cycle is involved, build the graph of the affected
+        // cells to find and report it
+        DependencyList graph;
+        std::map<CellAddress, Vertex> VertexList;
+        std::map<Vertex, CellAddress> VertexIndexList;
+        std::deque<CellAddress> workQueue(dirtyCells.begin(), dirtyCells.end());
+        while (!workQueue.empty()) {
+            CellAddress currPos = workQueue.front();
+            workQueue.pop_front();
+
+            // Insert into map of CellPos -> Index, if it doesn't exist already
+            auto res = VertexList.emplace(currPos, Vertex());
+            if (res.second) {
+                res.first->second = add_vertex(graph);
+                VertexIndexList[res.first->second] = currPos;
+            }
 
-        // Process cells that depend on the current cell
-        for (auto& dep : providesTo(currPos)) {
-            auto resDep = VertexList.emplace(dep, Vertex());
-            if (resDep.second) {
-                resDep.first->second = add_vertex(graph);
-                VertexIndexList[resDep.first->second] = dep;
-                if (dirtyCells.insert(dep).second) {
-                    workQueue.push_back(dep);
+            // Process cells that depend on the current cell
+            for (auto& dep : providesTo(currPos)) {
+                auto resDep = VertexList.emplace(dep, Vertex());
+                if (resDep.second) {
+                    resDep.first->second = add_vertex(graph);
+                    VertexIndexList[resDep.first->second] = dep;
+                    if (dirtyCells.insert(dep).second) {
+                        workQueue.push_back(dep);
+                    }
                 }
+                // Add edge to graph to signal dependency
+                add_edge(res.first->second, resDep.first->second, graph);
             }
-            // Add edge to graph to signal dependency
-            add_edge(res.first->second, resDep.first->second, graph);
-        }
-    }
-    // Compute cells
-    std::list<Vertex> make_order;
-    // Sort graph topologically to find evaluation order
-    try {
-        boost::topological_sort(graph, std::front_inserter(make_order));
-        // Recompute cells
-        FC_LOG("recomputing " << getFullName());
-        for (auto& pos : make_order) {
-            const auto& addr = VertexIndexList[pos];
-            FC_TRACE(addr.toString());
-            recomputeCell(addr);
         }
-    }
-    catch (std::exception&) {
-        for (auto& v : VertexList) {
-            Cell* cell = cells.getValue(v.first);
-            // Mark as erroneous
-            if (cell) {
-                cellErrors.insert(v.first);
-                cell->setException("Pending computation due to cyclic dependency", true);
-                cellUpdated(v.first);
+        // Compute cells
+        std::list<Vertex> make_order;
+        // Sort graph topologically to find evaluation order
+        try {
+            boost::topological_sort(graph, std::front_inserter(make_order));
+            // Recompute cells
+            FC_LOG("recomputing " << getFullName());
+            for (auto& pos : make_order) {
+                const auto& addr = VertexIndexList[pos];
+                FC_TRACE(addr.toString());
+                recomputeCell(addr);
             }
         }
+        catch (std::exception&) {
+            for (auto& v : VertexList) {
+                Cell* cell = cells.getValue(v.first);
+                // Mark as erroneous
+                if (cell) {
+                    cellErrors.insert(v.first);
+                    cell->setException("Pending computation due to cyclic dependency", true);
+                    cellUpdated(v.first);
+                }
+            }
 
-        // Try to be more user friendly by finding individual loops
-        while (!dirtyCells.empty()) {
+            // Try to be more user friendly by finding individual loops
+            while (!dirtyCells.empty()) {
 
-            std::deque<CellAddress> workQueue;
-            DependencyList graph;
-            std::map<CellAddress, Vertex> VertexList;
-            std::map<Vertex, CellAddress> VertexIndexList;
+                std::deque<CellAddress> workQueue;
+                DependencyList graph;
+                std::map<CellAddress, Vertex> VertexList;
+                std::map<Vertex, CellAddress> VertexIndexList;
 
-            CellAddress currentAddr = *dirtyCells.begin();
-            workQueue.push_back(currentAddr);
-            dirtyCells.erase(dirtyCells.begin());
+                CellAddress currentAddr = *dirtyCells.begin();
+                workQueue.push_back(currentAddr);
+                dirtyCells.erase(dirtyCells.begin());
 
-            while (!workQueue.empty()) {
-                CellAddress currPos = workQueue.front();
-                workQueue.pop_front();
+                while (!workQueue.empty()) {
+                    CellAddress currPos = workQueue.front();
+                    workQueue.pop_front();
 
-                // Insert into map of CellPos -> Index, if it doesn't exist already
-                auto res = VertexList.emplace(currPos, Vertex());
-                if (res.second) {
-                    res.first->second = add_vertex(graph);
-                    VertexIndexList[res.first->second] = currPos;
-                }
+                    // Insert into map of CellPos -> Index, if it doesn't exist already
+                    auto res = VertexList.emplace(currPos, Vertex());
+                    if (res.second) {
+                        res.first->second = add_vertex(graph);
+                        VertexIndexList[res.first->second] = currPos;
+                    }
 
-                // Process cells that depend on the current cell
-                for (auto& dep : providesTo(currPos)) {
-                    auto resDep = VertexList.emplace(dep, Vertex());
-                    if (resDep.second) {
-                        resDep.first->second = add_vertex(graph);
-                        VertexIndexList[resDep.first->second] = dep;
-                        workQueue.push_back(dep);
-                        dirtyCells.erase(dep);
+                    // Process cells that depend on the current cell
+                    for (auto& dep : providesTo(currPos)) {
+                        auto resDep = VertexList.emplace(dep, Vertex());
+                        if (resDep.second) {
+                            resDep.first->second = add_vertex(graph);
+                            VertexIndexList[resDep.first->second] = dep;
+                            workQueue.push_back(dep);
+                            dirtyCells.erase(dep);
+                        }
+                        // Add edge to graph to signal dependency
+                        add_edge(res.first->second, resDep.first->second, graph);
                     }
-                    // Add edge to graph to signal dependency
-                    add_edge(res.first->second, resDep.first->second, graph);
                 }
-            }
 
-            std::list<Vertex> make_order;
-            try {
-                boost::topological_sort(graph, std::front_inserter(make_order));
-            }
-            catch (std::exception&) {  // TODO: evaluate using a more specific exception (not_a_dag)
-                // Cycle detected; flag all with errors
-                Base::Console().error("Cyclic dependency detected in spreadsheet : %s\n",
-                                      getNameInDocument());
-                std::ostringstream ss;
-                ss << "Cyclic dependency";
-                int count = 0;
-                for (auto& v : VertexList) {
-                    if (count++ % 20 == 0) {
-                        ss << std::endl;
-                    }
-                    else {
-                        ss << ", ";
-                    }
-                    ss << v.first.toString();
+                std::list<Vertex> make_order;
+                try {
+                    boost::topological_sort(graph, std::front_inserter(make_order));
                 }
-                std::string msg = ss.str();
-                for (auto& v : VertexList) {
-                    Cell* cell = cells.getValue(v.first);
-                    if (cell) {
-                        cell->setException(msg.c_str(), true);
-                        cellUpdated(v.first);
+                catch (std::exception&) {  // TODO: evaluate using a more specific exception (not_a_dag)
+                    // Cycle detected; flag all with errors
+                    Base::Console().error("Cyclic dependency detected in spreadsheet : %s\n",
+                                          getNameInDocument());
+                    std::ostringstream ss;
+                    ss << "Cyclic dependency";
+                    int count = 0;
+                    for (auto& v : VertexList) {
+                        if (count++ % 20 == 0) {
+                            ss << std::endl;
+                        }
+                        else {
+                            ss << ", ";
+                        }
+                        ss << v.first.toString();
+                    }
+                    std::string msg = ss.str();
+                    for (auto& v : VertexList) {
+                        Cell* cell = cells.getValue(v.first);
+                        if (cell) {
+                            cell->setException(msg.c_str(), true);
+                            cellUpdated(v.first);
+                        }
                     }
                 }
             }
@@ -1649,7 +1737,7 @@ void Sheet::providesTo(CellAddress address, std::set<std::string>& result) const
 
 std::set<CellAddress> Sheet::providesTo(CellAddress address) const
 {
-    return cells.getDeps(getFullName() + "." + address.toString());
+    return cells.getDependants(address);
 }
 
 void Sheet::onDocumentRestored()
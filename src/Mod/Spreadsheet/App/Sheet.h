@@ -29,6 +29,7 @@
 #endif
 
 #include <map>
+#include <memory>
 #include <tuple>
 #include <set>
 #include <string>
@@ -250,13 +251,15 @@ protected:
 
     void onDocumentRestored() override;
 
-    void recomputeCell(App::CellAddress p);
+    void recomputeCell(App::CellAddress p, std::unique_ptr<App::Expression> value = nullptr);
+
+    void recomputeInOrder(const std::vector<App::CellAddress>& order);
 
     App::Property* getProperty(App::CellAddress key) const;
 
     App::Property* getProperty(const char* addr) const;
 
-    void updateProperty(App::CellAddress key);
+    void updateProperty(App::CellAddress key, std::unique_ptr<App::Expression> value = nullptr);
 
     App::Property* setStringProperty(App::CellAddress key, const std::string& value);
 
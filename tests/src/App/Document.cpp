@@ -3,8 +3,12 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <thread>
+
 #include "App/Application.h"
+#include "App/ChangeBatch.h"
 #include "App/Document.h"
+#include "App/FeatureTest.h"
 #include "App/StringHasher.h"
 #include "Base/Writer.h"
 #include <src/App/InitApplication.h>
@@ -94,4 +98,315 @@ TEST_F(DocumentTest, getStringHasherGivesExpectedHasher)
     EXPECT_EQ(hasher, foundHasher);
 }
 
+TEST_F(DocumentTest, parallelRecomputeFollowsDependencies)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    bool parallel = hGrp->GetBool("ParallelRecompute", false);
+    hGrp->SetBool("ParallelRecompute", true);
+    auto base = doc()->addObject<App::FeatureTest>("Base");
+    auto left = doc()->addObject<App::FeatureTest>("Left");
+    auto right = doc()->addObject<App::FeatureTest>("Right");
+    auto top = doc()->addObject<App::FeatureTest>("Top");
+    left->Source1.setValue(base);
+    right->Source1.setValue(base);
+    top->Source1.setValue(left);
+    top->Source2.setValue(right);
+    bool hasError = false;
+
+    // Act
+    int first = doc()->recompute({}, false, &hasError);
+    base->touch();
+    int second = doc()->recompute({}, false, &hasError);
+    hGrp->SetBool("ParallelRecompute", parallel);
+
+    // Assert
+    EXPECT_FALSE(hasError);
+    EXPECT_EQ(first, 4);
+    EXPECT_EQ(second, 4);
+    for (auto obj : {base, left, right, top}) {
+        EXPECT_EQ(obj->ExecCount.getValue(), 2);
+        EXPECT_FALSE(obj->isTouched());
+    }
+}
+
+TEST_F(DocumentTest, parallelRecomputeExecutesConcurrently)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    bool parallel = hGrp->GetBool("ParallelRecompute", false);
+    long threads = hGrp->GetInt("RecomputeThreads", 0);
+    hGrp->SetBool("ParallelRecompute", true);
+    hGrp->SetInt("RecomputeThreads", 2);
+    auto base = doc()->addObject<App::FeatureTestConcurrent>("Base");
+    auto left = doc()->addObject<App::FeatureTestConcurrent>("Left");
+    auto right = doc()->addObject<App::FeatureTestConcurrent>("Right");
+    auto top = doc()->addObject<App::FeatureTestConcurrent>("Top");
+    left->Sources.setValues({base});
+    right->Sources.setValues({base});
+    top->Sources.setValues({left, right});
+    // left and right only finish early if they run at the same time
+    left->WaitFor.setValue(2);
+    right->WaitFor.setValue(2);
+    App::FeatureTestConcurrent::resetRunning();
+    bool hasError = false;
+
+    // Act
+    int count = doc()->recompute({}, false, &hasError);
+    hGrp->SetBool("ParallelRecompute", parallel);
+    hGrp->SetInt("RecomputeThreads", threads);
+
+    // Assert
+    EXPECT_FALSE(hasError);
+    EXPECT_EQ(count, 4);
+    EXPECT_EQ(App::FeatureTestConcurrent::getMaxRunning(), 2);
+    EXPECT_EQ(base->Result.getValue(), 1);
+    EXPECT_EQ(left->Result.getValue(), 2);
+    EXPECT_EQ(right->Result.getValue(), 2);
+    EXPECT_EQ(top->Result.getValue(), 5);
+    for (auto obj : {base, left, right, top}) {
+        EXPECT_FALSE(obj->isTouched());
+    }
+}
+
+TEST_F(DocumentTest, parallelRecomputeNotifiesInDependencyOrder)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    bool parallel = hGrp->GetBool("ParallelRecompute", false);
+    long threads = hGrp->GetInt("RecomputeThreads", 0);
+    hGrp->SetBool("ParallelRecompute", true);
+    hGrp->SetInt("RecomputeThreads", 2);
+    auto base = doc()->addObject<App::FeatureTestConcurrent>("Base");
+    auto left = doc()->addObject<App::FeatureTestConcurrent>("Left");
+    auto right = doc()->addObject<App::FeatureTestConcurrent>("Right");
+    auto top = doc()->addObject<App::FeatureTestConcurrent>("Top");
+    left->Sources.setValues({base});
+    right->Sources.setValues({base});
+    top->Sources.setValues({left, right});
+    std::vector<std::string> changed;
+    std::vector<std::string> recomputed;
+    bool otherThread = false;
+    auto mainThread = std::this_thread::get_id();
+    auto conn = doc()->signalChangedObject.connect(
+        [&](const App::DocumentObject& obj, const App::Property& prop) {
+            otherThread = otherThread || std::this_thread::get_id() != mainThread;
+            if (std::string(prop.getName()) == "Result") {
+                changed.emplace_back(obj.getNameInDocument());
+            }
+        });
+    auto connRecomputed =
+        doc()->signalRecomputedObject.connect([&](const App::DocumentObject& obj) {
+            otherThread = otherThread || std::this_thread::get_id() != mainThread;
+            recomputed.emplace_back(obj.getNameInDocument());
+        });
+
+    // Act
+    doc()->recompute();
+    conn.disconnect();
+    connRecomputed.disconnect();
+    hGrp->SetBool("ParallelRecompute", parallel);
+    hGrp->SetInt("RecomputeThreads", threads);
+
+    // Assert
+    EXPECT_FALSE(otherThread);
+    for (auto names : {changed, recomputed}) {
+        ASSERT_EQ(names.size(), 4);
+        EXPECT_EQ(names.front(), "Base");
+        EXPECT_EQ(names.back(), "Top");
+    }
+}
+
+TEST_F(DocumentTest, parallelRecomputeAbortKeepsFinishedChanges)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    bool parallel = hGrp->GetBool("ParallelRecompute", false);
+    long threads = hGrp->GetInt("RecomputeThreads", 0);
+    hGrp->SetBool("ParallelRecompute", true);
+    hGrp->SetInt("RecomputeThreads", 2);
+    auto left = doc()->addObject<App::FeatureTestConcurrent>("Left");
+    auto right = doc()->addObject<App::FeatureTestConcurrent>("Right");
+    auto top = doc()->addObject<App::FeatureTestConcurrent>("Top");
+    top->Sources.setValues({left, right});
+    // right is still executing when the abort of left is handled
+    left->WaitFor.setValue(2);
+    left->Abort.setValue(true);
+    right->WaitFor.setValue(2);
+    right->Delay.setValue(200);
+    bool rightChanged = false;
+    auto conn = doc()->signalChangedObject.connect(
+        [&](const App::DocumentObject& obj, const App::Property& prop) {
+            if (&obj == right && &prop == &right->Result) {
+                rightChanged = true;
+            }
+        });
+    bool hasError = false;
+
+    // Act
+    doc()->recompute({}, false, &hasError);
+    conn.disconnect();
+    hGrp->SetBool("ParallelRecompute", parallel);
+    hGrp->SetInt("RecomputeThreads", threads);
+
+    // Assert
+    EXPECT_TRUE(hasError);
+    EXPECT_EQ(right->Result.getValue(), 1);
+    EXPECT_TRUE(rightChanged);
+    EXPECT_EQ(top->Result.getValue(), 0);
+    EXPECT_TRUE(top->isTouched());
+}
+
+TEST_F(DocumentTest, dependencyListFollowsReorderedLinks)
+{
+    // Arrange
+    auto first = doc()->addObject<App::FeatureTest>("First");
+    auto second = doc()->addObject<App::FeatureTest>("Second");
+    auto third = doc()->addObject<App::FeatureTest>("Third");
+    second->Source1.setValue(first);
+
+    // Act
+    first->Source1.setValue(third);
+    auto sorted = App::Document::getDependencyList({second}, App::Document::DepSort);
+
+    // Assert
+    ASSERT_EQ(sorted.size(), 3);
+    EXPECT_EQ(sorted[0], third);
+    EXPECT_EQ(sorted[1], first);
+    EXPECT_EQ(sorted[2], second);
+    EXPECT_FALSE(third->testIfLinkDAGCompatible(second));
+    EXPECT_TRUE(second->testIfLinkDAGCompatible(third));
+    EXPECT_TRUE(second->isInInListRecursive(second));
+    EXPECT_TRUE(third->isInInListRecursive(second));
+    EXPECT_FALSE(second->isInInListRecursive(third));
+}
+
+TEST_F(DocumentTest, undoBudgetEvictsOldestTransactions)
+{
+    // Arrange
+    doc()->setUndoMode(1);
+    auto feature = doc()->addObject<App::FeatureTest>("Feature");
+    const std::string large(10000, 'x');
+    for (int i = 0; i < 5; ++i) {
+        doc()->openTransaction("Change");
+        feature->String.setValue(large + std::to_string(i));
+        doc()->commitTransaction();
+    }
+    auto bytes = doc()->getUndoBytes();
+
+    // Act
+    doc()->setUndoBudget(25000);
+
+    // Assert
+    EXPECT_GT(bytes, 40000);
+    EXPECT_LE(doc()->getUndoBytes(), 25000);
+    EXPECT_EQ(doc()->getUndoMemSize(), doc()->getUndoBytes());
+    EXPECT_GE(doc()->getAvailableUndos(), 1);
+    EXPECT_LT(doc()->getAvailableUndos(), 5);
+    doc()->undo();
+    EXPECT_EQ(feature->String.getStrValue(), large + "3");
+}
+
+TEST_F(DocumentTest, changeBatchCoalescesNotifications)
+{
+    // Arrange
+    auto feature = doc()->addObject<App::FeatureTest>("Feature");
+    std::vector<std::string> changed;
+    int immediate = 0;
+    auto conn = doc()->signalChangedObject.connect(
+        [&](const App::DocumentObject& obj, const App::Property& prop) {
+            if (&obj == feature) {
+                changed.emplace_back(prop.getName());
+            }
+        });
+    auto connImmediate = doc()->signalChangedObjectImmediate.connect(
+        [&](const App::DocumentObject& obj, const App::Property&) {
+            if (&obj == feature) {
+                ++immediate;
+            }
+        });
+
+    // Act
+    {
+        App::ChangeBatch batch;
+        {
+            App::ChangeBatch nested;
+            for (int i = 0; i < 100; ++i) {
+                feature->Integer.setValue(i);
+                feature->Float.setValue(i);
+            }
+        }
+        EXPECT_TRUE(App::ChangeBatch::isActive());
+        EXPECT_TRUE(changed.empty());
+        feature->Integer.setValue(100);
+    }
+    bool active = App::ChangeBatch::isActive();
+    feature->String.setValue("after");
+    conn.disconnect();
+    connImmediate.disconnect();
+
+    // Assert
+    EXPECT_FALSE(active);
+    EXPECT_EQ(immediate, 202);
+    EXPECT_EQ(feature->Integer.getValue(), 100);
+    ASSERT_EQ(changed.size(), 3);
+    EXPECT_EQ(changed[0], "Integer");
+    EXPECT_EQ(changed[1], "Float");
+    EXPECT_EQ(changed[2], "String");
+}
+
+TEST_F(DocumentTest, changeBatchSkipsRemovedObjects)
+{
+    // Arrange
+    auto feature = doc()->addObject<App::FeatureTest>("Feature");
+    auto name = std::string(feature->getNameInDocument());
+    int count = 0;
+    auto conn = doc()->signalChangedObject.connect(
+        [&](const App::DocumentObject&, const App::Property&) {
+            ++count;
+        });
+
+    // Act
+    {
+        App::ChangeBatch batch;
+        feature->Integer.setValue(1);
+        doc()->removeObject(name.c_str());
+    }
+    conn.disconnect();
+
+    // Assert
+    EXPECT_EQ(count, 0);
+}
+
+TEST_F(DocumentTest, memoryReportBreaksDownObjects)
+{
+    // Arrange
+    auto small = doc()->addObject<App::FeatureTest>("Small");
+    auto large = doc()->addObject<App::FeatureTest>("Large");
+    large->String.setValue(std::string(100000, 'x'));
+
+    // Act
+    auto report = doc()->getMemoryReport();
+    auto json = report.toJson();
+
+    // Assert
+    ASSERT_EQ(report.objects.size(), 2);
+    auto smallUsage = report.findObject(small->getNameInDocument());
+    auto largeUsage = report.findObject(large->getNameInDocument());
+    ASSERT_NE(smallUsage, nullptr);
+    ASSERT_NE(largeUsage, nullptr);
+    EXPECT_EQ(largeUsage->type, "App::FeatureTest");
+    EXPECT_GE(largeUsage->properties, smallUsage->properties + 100000);
+    EXPECT_GE(report.propertyTypes["App::PropertyString"].bytes, 100000);
+    EXPECT_EQ(report.total(),
+              report.propertiesTotal() + report.elementMapsTotal() + report.viewProvidersTotal()
+                  + report.stringHashers + report.undo);
+    EXPECT_NE(json.find("\"Large\""), std::string::npos);
+    EXPECT_LT(json.find("\"Large\""), json.find("\"Small\""));
+}
+
 // NOLINTEND(readability-magic-numbers)
@@ -2,8 +2,13 @@
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <map>
+#include <sstream>
+
 #include <App/Application.h>
 #include <App/ElementMap.h>
+#include <App/MappedNameIndex.h>
 #include <src/App/InitApplication.h>
 
 // NOLINTBEGIN(readability-magic-numbers)
@@ -553,4 +558,143 @@ TEST_F(ElementMapTest, addAndGetChildElementsTest)
             return e.indexedName.toString() == "Pong2";
         }));
 }
+
+TEST_F(ElementMapTest, saveBinaryRestoresSameNames)
+{
+    // Arrange
+    LessComplexPart cube(1L, "Box", _hasher);
+    Data::MappedName postfixed(Data::IndexedName("Edge", 1));
+    postfixed += ";:H1,E";
+    cube.elementMapPtr->setElementName(Data::IndexedName("Edge", 1), postfixed, cube.Tag);
+    cube.elementMapPtr->setElementName(Data::IndexedName("Edge", 2),
+                                       Data::MappedName("SomeEdge;XYZ"),
+                                       cube.Tag);
+    Data::ElementMap::MappedChildElements child = {Data::IndexedName("Face", 1),
+                                                   6,
+                                                   10,
+                                                   2L,
+                                                   LessComplexPart(2L, "Child", _hasher).elementMapPtr,
+                                                   QByteArray(";:H2,F"),
+                                                   _sid};
+    cube.elementMapPtr->addChildElements(cube.Tag, {child});
+    std::stringstream text;
+    std::stringstream binary;
+    cube.elementMapPtr->save(text);
+    cube.elementMapPtr->saveBinary(binary);
+
+    // Act
+    auto fromText = std::make_shared<Data::ElementMap>()->restore(_hasher, text);
+    auto fromBinary = std::make_shared<Data::ElementMap>()->restoreBinary(_hasher, binary);
+    auto expected = fromText->getAll();
+    auto result = fromBinary->getAll();
+
+    // Assert
+    EXPECT_EQ(fromBinary->size(), cube.elementMapPtr->size());
+    ASSERT_EQ(result.size(), expected.size());
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        EXPECT_EQ(result[i].name, expected[i].name);
+        EXPECT_EQ(result[i].index, expected[i].index);
+    }
+    EXPECT_EQ(fromBinary->find(postfixed), Data::IndexedName("Edge", 1));
+    EXPECT_TRUE(fromBinary->find(Data::IndexedName("Face", 12)));
+    EXPECT_EQ(fromBinary->find(Data::IndexedName("Face", 12)),
+              cube.elementMapPtr->find(Data::IndexedName("Face", 12)));
+}
+
+TEST_F(ElementMapTest, mappedNameIndexMatchesMap)
+{
+    // Arrange
+    Data::MappedNameIndex index;
+    std::map<Data::MappedName, Data::IndexedName, std::less<>> reference;
+
+    // Act
+    for (int i = 1; i <= 1000; ++i) {
+        Data::MappedName name(Data::IndexedName("Edge", i));
+        name += ";:H" + std::to_string(i % 7);  // split between data and postfix
+        index.insert(name, Data::IndexedName("Edge", i));
+        reference.emplace(name, Data::IndexedName("Edge", i));
+    }
+    for (int i = 1; i <= 1000; i += 3) {
+        Data::MappedName name(Data::IndexedName("Edge", i));
+        name += ";:H" + std::to_string(i % 7);
+        index.erase(name);
+        reference.erase(name);
+    }
+    auto sorted = index.sorted();
+
+    // Assert
+    ASSERT_EQ(index.size(), reference.size());
+    ASSERT_EQ(sorted.size(), reference.size());
+    auto entry = sorted.begin();
+    for (const auto& [name, idx] : reference) {
+        EXPECT_EQ((*entry)->name, name);
+        ++entry;
+        const auto* found = index.find(name);
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(found->index, idx);
+    }
+    EXPECT_EQ(index.find(Data::MappedName("Edge1;:H1")), nullptr);
+    EXPECT_FALSE(index.insert(sorted.front()->name, Data::IndexedName("Face", 1)).second);
+}
+
+TEST_F(ElementMapTest, mappedNameIndexBenchmark)
+{
+    // Arrange
+    using Clock = std::chrono::steady_clock;
+    const int count = 100000;
+    std::vector<Data::MappedName> names;
+    names.reserve(count);
+    for (int i = 1; i <= count; ++i) {
+        Data::MappedName name(Data::IndexedName("Face", i));
+        name += ";:H1b,F;:M;FUS;:H" + std::to_string(i % 97);
+        names.push_back(name);
+    }
+    auto elapsed = [](Clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    };
+
+    // Act
+    auto start = Clock::now();
+    std::map<Data::MappedName, Data::IndexedName, std::less<>> tree;
+    for (int i = 0; i < count; ++i) {
+        tree.emplace(names[i], Data::IndexedName("Face", i + 1));
+    }
+    long treeFound = 0;
+    for (const auto& name : names) {
+        treeFound += tree.find(name)->second.getIndex();
+    }
+    auto treeTime = elapsed(start);
+
+    start = Clock::now();
+    Data::MappedNameIndex flat;
+    for (int i = 0; i < count; ++i) {
+        flat.insert(names[i], Data::IndexedName("Face", i + 1));
+    }
+    long flatFound = 0;
+    for (const auto& name : names) {
+        flatFound += flat.find(name)->index.getIndex();
+    }
+    auto flatTime = elapsed(start);
+
+    start = Clock::now();
+    Data::ElementMap elementMap;
+    for (int i = 0; i < count; ++i) {
+        elementMap.setElementName(Data::IndexedName("Face", i + 1), names[i], 1L);
+    }
+    long mapFound = 0;
+    for (const auto& name : names) {
+        mapFound += elementMap.find(name).getIndex();
+    }
+    auto elementMapTime = elapsed(start);
+
+    RecordProperty("StdMapMicroseconds", std::to_string(treeTime));
+    RecordProperty("FlatIndexMicroseconds", std::to_string(flatTime));
+    RecordProperty("ElementMapMicroseconds", std::to_string(elementMapTime));
+
+    // Assert
+    EXPECT_EQ(flat.size(), tree.size());
+    EXPECT_EQ(flatFound, treeFound);
+    EXPECT_EQ(mapFound, treeFound);
+}
+
 // NOLINTEND(readability-magic-numbers)
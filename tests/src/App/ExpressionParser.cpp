@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include "Base/Interpreter.h"
 #include "Base/Quantity.h"
 
 #include "App/Application.h"
@@ -7,6 +8,8 @@
 #include "App/DocumentObject.h"
 #include "App/Expression.h"
 #include "App/ExpressionParser.h"
+#include "App/PropertyStandard.h"
+#include "App/PropertyUnits.h"
 
 #include "src/App/InitApplication.h"
 
@@ -117,4 +120,58 @@ TEST_F(ExpressionParserTest, isTokenAConstant)
     }
 }
 
+TEST_F(ExpressionParserTest, nativeEvaluationMatchesPython)
+{
+    // Arrange
+    auto count = static_cast<App::PropertyInteger*>(this_obj()->addDynamicProperty("App::PropertyInteger", "Count"));
+    auto ratio = static_cast<App::PropertyFloat*>(this_obj()->addDynamicProperty("App::PropertyFloat", "Ratio"));
+    auto width = static_cast<App::PropertyLength*>(this_obj()->addDynamicProperty("App::PropertyLength", "Width"));
+    count->setValue(7);
+    ratio->setValue(0.25);
+    width->setValue(12.5);
+
+    std::array<const char*, 22> expressions {
+        "1 + 2", "7 / 2", "-7 % 3", "7.5 % -2", "2 ^ 10", "2 ^ -1", "-(3)",
+        "1 mm + 2 mm", "2 mm * 3", "10 mm / 4 mm", "(2 mm) ^ 2",
+        "1 < 2 ? 10 : 20", "1 mm > 2 mm ? 1 : 0", "True", "1 == 1.0",
+        "sin(30 deg)", "sqrt(16 mm^2)", "abs(-3 mm)", "hypot(3 mm; 4 mm)",
+        "Count * 2", "Ratio + Count", "Width * Count + 1 mm",
+    };
+
+    for (const auto* text : expressions) {
+        std::unique_ptr<App::Expression> expression(App::ExpressionParser::parse(this_obj(), text));
+
+        // Act
+        App::any native;
+        bool compiled = expression->getNativeValue(native);
+        App::any python;
+        {
+            Base::PyGILStateLocker lock;
+            python = App::pyObjectToAny(expression->getPyValue());
+        }
+
+        // Assert
+        EXPECT_TRUE(compiled) << text;
+        EXPECT_EQ(native.type(), python.type()) << text;
+        EXPECT_TRUE(App::isAnyEqual(native, python)) << text;
+    }
+}
+
+TEST_F(ExpressionParserTest, nativeEvaluationFallsBackToPython)
+{
+    // Arrange
+    std::unique_ptr<App::Expression> mismatch(App::ExpressionParser::parse(this_obj(), "1 mm + 1 s"));
+    std::unique_ptr<App::Expression> text(App::ExpressionParser::parse(this_obj(), "str(1 mm)"));
+    std::unique_ptr<App::Expression> division(App::ExpressionParser::parse(this_obj(), "1 / 0"));
+    App::any value;
+
+    // Act & Assert
+    EXPECT_FALSE(mismatch->getNativeValue(value));
+    EXPECT_THROW(mismatch->getValueAsAny(), Base::Exception);
+    EXPECT_FALSE(text->getNativeValue(value));
+    EXPECT_EQ(text->getValueAsAny().type(), typeid(std::string));
+    EXPECT_FALSE(division->getNativeValue(value));
+    EXPECT_ANY_THROW(division->getValueAsAny());
+}
+
 // clang-format on
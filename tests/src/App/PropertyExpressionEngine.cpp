@@ -8,6 +8,7 @@
 #include "App/Expression.h"
 #include "App/ObjectIdentifier.h"
 #include "App/PropertyExpressionEngine.h"
+#include "App/PropertyUnits.h"
 
 #include "src/App/InitApplication.h"
 
@@ -90,4 +91,40 @@ TEST_F(PropertyExpressionEngineTest, executeCrossPropertyReference)
     ;
 }
 
+TEST_F(PropertyExpressionEngineTest, executeSkipsUnchangedBindings)
+{
+    // Arrange
+    auto input = static_cast<App::PropertyLength*>(this_obj()->addDynamicProperty("App::PropertyLength", "Input"));
+    input->setValue(10.0);
+    auto target_path = App::ObjectIdentifier::parse(this_obj(), target_name());
+    std::shared_ptr<App::Expression> target_rule(App::Expression::parse(this_obj(), "Input * 2"));
+    this_obj()->setExpression(target_path, target_rule);
+    auto& engine = this_obj()->ExpressionEngine;
+    auto target = static_cast<App::PropertyLength*>(target_prop());
+
+    // Act & Assert
+    engine.execute();
+    EXPECT_EQ(engine.getEvaluatedCount(), 1U);
+    EXPECT_EQ(engine.getSkippedCount(), 0U);
+    EXPECT_DOUBLE_EQ(target->getValue(), 20.0);
+
+    engine.execute();
+    EXPECT_EQ(engine.getEvaluatedCount(), 1U) << "unchanged input must not be evaluated again";
+    EXPECT_EQ(engine.getSkippedCount(), 1U);
+
+    input->setValue(15.0);
+    engine.execute();
+    EXPECT_EQ(engine.getEvaluatedCount(), 2U);
+    EXPECT_DOUBLE_EQ(target->getValue(), 30.0);
+
+    target->setValue(1.0);
+    engine.execute();
+    EXPECT_EQ(engine.getEvaluatedCount(), 3U) << "changed target must be restored";
+    EXPECT_DOUBLE_EQ(target->getValue(), 30.0);
+
+    engine.resetEvaluationCounters();
+    EXPECT_EQ(engine.getEvaluatedCount(), 0U);
+    EXPECT_EQ(engine.getSkippedCount(), 0U);
+}
+
 // clang-format on
@@ -9,6 +9,9 @@
 
 #include <QCryptographicHash>
 #include <array>
+#include <atomic>
+#include <set>
+#include <thread>
 
 class StringIDTest: public ::testing::Test
 {
@@ -1586,3 +1589,86 @@ TEST_F(StringHasherTest, compact)  // NOLINT
     // Assert
     EXPECT_EQ(0, Hasher()->count());
 }
+
+TEST_F(StringHasherTest, getIDFromMultipleThreads)  // NOLINT
+{
+    // Arrange
+    const int numThreads {8};
+    const int numNames {500};
+    std::vector<std::vector<App::StringIDRef>> results(numThreads);
+    auto hashNames = [this, &results](int thread) {
+        auto& ids = results[thread];
+        ids.resize(2 * numNames);
+        QVector<App::StringIDRef> sids;
+        for (int i = 0; i < numNames; ++i) {
+            // Walk the names in a different order in every thread
+            int name = (i * (2 * thread + 1) + thread * 7) % numNames;
+            auto postfix = ";:H" + std::to_string(name % 17) + ":3,F";
+            auto face = "Face" + std::to_string(name);
+            ids[name] = Hasher()->getID(givenMappedName(face.c_str(), postfix.c_str()), sids);
+            auto edge = "Edge" + std::to_string(name);
+            ids[numNames + name] = Hasher()->getID(edge.c_str());
+        }
+    };
+
+    // Act
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < numThreads; ++thread) {
+        threads.emplace_back(hashNames, thread);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Assert
+    std::set<long> values;
+    for (const auto& ids : results) {
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            ASSERT_TRUE(ids[i]);
+            EXPECT_EQ(ids[i], results[0][i]);
+        }
+    }
+    for (const auto& id : results[0]) {
+        values.insert(id.value());
+    }
+    // The faces only differ by index within the 17 different postfixes, the hasher additionally
+    // stores the "Face" prefix and the postfixes themselves
+    EXPECT_EQ(values.size(), numNames + 17);
+    EXPECT_EQ(Hasher()->size(), numNames + 17 + 1 + 17);
+    EXPECT_EQ(results[0][3].value(), results[0][20].value());
+    EXPECT_NE(results[0][3], results[0][20]);
+}
+
+TEST_F(StringHasherTest, compactWhileHashing)  // NOLINT
+{
+    // Arrange
+    const int numThreads {4};
+    const int numRounds {200};
+    std::atomic<int> running {numThreads};
+    auto hashNames = [this, &running](int thread) {
+        QVector<App::StringIDRef> sids;
+        for (int round = 0; round < numRounds; ++round) {
+            auto name = "Vertex" + std::to_string(round % 50);
+            auto postfix = ";:H" + std::to_string(thread) + ":2,V";
+            auto id = Hasher()->getID(givenMappedName(name.c_str(), postfix.c_str()), sids);
+            EXPECT_TRUE(id);
+        }
+        --running;
+    };
+
+    // Act
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < numThreads; ++thread) {
+        threads.emplace_back(hashNames, thread);
+    }
+    while (running > 0) {
+        Hasher()->compact();
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    Hasher()->compact();
+
+    // Assert
+    EXPECT_EQ(0, Hasher()->size());
+}
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include "Base/BinaryXML.h"
+#include "Base/Exception.h"
+#include "Base/Reader.h"
+#include <sstream>
+#include <string>
+#include <xercesc/util/PlatformUtils.hpp>
+
+class BinaryXMLTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        XERCES_CPP_NAMESPACE::XMLPlatformUtils::Initialize();
+    }
+
+    static std::string encode(const std::string& xml)
+    {
+        std::ostringstream out;
+        Base::encodeBinaryXML(xml, out);
+        return out.str();
+    }
+
+    static constexpr const char* document = R"(<?xml version='1.0' encoding='utf-8'?>
+<!-- comment -->
+<Document SchemaVersion="4">
+    <Properties Count="2">
+        <Property name="Label" type="App::PropertyString">
+            <String value="a &lt;b&gt; &amp; &quot;c&quot;&#10;d"/>
+        </Property>
+        <Property name="Text" type="App::PropertyString">
+            <Data>Some text &amp; more</Data>
+        </Property>
+    </Properties>
+</Document>
+)";
+};
+
+TEST_F(BinaryXMLTest, decodeRoundTrips)
+{
+    // Arrange
+    auto binary = encode(document);
+
+    // Act
+    std::ostringstream xml;
+    Base::decodeBinaryXML(binary, xml);
+
+    // Assert
+    EXPECT_LT(binary.size(), std::string(document).size());
+    EXPECT_NE(xml.str().find(R"(value="a &lt;b&gt; &amp; &quot;c&quot;&#10;d")"), std::string::npos);
+    EXPECT_EQ(encode(xml.str()), binary);
+}
+
+TEST_F(BinaryXMLTest, readerReadsBinaryDocument)
+{
+    // Arrange
+    std::istringstream stream(encode(document));
+    Base::XMLReader reader("Document.xml", stream);
+
+    // Act & Assert
+    ASSERT_TRUE(reader.isValid());
+    EXPECT_TRUE(reader.isStartOfDocument());
+    reader.readElement("Document");
+    EXPECT_EQ(reader.getAttribute<long>("SchemaVersion"), 4);
+    reader.readElement("Properties");
+    EXPECT_EQ(reader.getAttribute<long>("Count"), 2);
+    reader.readElement("Property");
+    EXPECT_STREQ(reader.getAttribute<const char*>("name"), "Label");
+    reader.readElement("String");
+    EXPECT_EQ(reader.getAttributeCount(), 1);
+    EXPECT_STREQ(reader.getAttribute<const char*>("value"), "a <b> & \"c\"\nd");
+    EXPECT_FALSE(reader.hasAttribute("name"));
+    reader.readEndElement("Property");
+    reader.readElement("Property");
+    reader.readElement("Data");
+    std::string text;
+    std::getline(reader.beginCharStream(), text);
+    reader.endCharStream();
+    EXPECT_EQ(text, "Some text & more");
+    reader.readEndElement("Property");
+    reader.readEndElement("Properties");
+    reader.readEndElement("Document");
+    EXPECT_TRUE(reader.isEndOfDocument());
+}
+
+TEST_F(BinaryXMLTest, malformedXmlThrows)
+{
+    // Arrange
+    std::ostringstream out;
+
+    // Act & Assert
+    EXPECT_THROW(Base::encodeBinaryXML("<a><b></a>", out), Base::XMLParseException);  // NOLINT
+    EXPECT_THROW(Base::encodeBinaryXML("<a x='1></a>", out), Base::XMLParseException);  // NOLINT
+    EXPECT_THROW(Base::encodeBinaryXML("<a>&unknown;</a>", out), Base::XMLParseException);  // NOLINT
+}
+
+TEST_F(BinaryXMLTest, truncatedDataThrows)
+{
+    // Arrange
+    auto binary = encode(document);
+    binary.resize(binary.size() / 2);
+    std::ostringstream xml;
+
+    // Act & Assert
+    EXPECT_THROW(Base::decodeBinaryXML(binary, xml), Base::XMLParseException);  // NOLINT
+}
@@ -462,4 +462,50 @@ TEST_F(ParameterTest, TestLockFile)
     lockFile2.unlock();
 }
 
+TEST_F(ParameterTest, TestCachedValues)
+{
+    auto cfg = getCreateConfig();
+    auto grp = cfg->GetGroup("TopLevelGroup");
+    EXPECT_EQ(grp->GetInt("Parameter", 5), 5);
+    grp->SetInt("Parameter", 3);
+    EXPECT_EQ(grp->GetInt("Parameter", 5), 3);
+    EXPECT_EQ(grp->GetInt("Parameter", 5), 3);
+    grp->SetInt("Parameter", 4);
+    EXPECT_EQ(grp->GetInt("Parameter", 5), 4);
+    grp->RemoveInt("Parameter");
+    EXPECT_EQ(grp->GetInt("Parameter", 5), 5);
+
+    grp->SetASCII("Text", "Hello");
+    EXPECT_EQ(grp->GetASCII("Text"), "Hello");
+    grp->Clear(false);
+    EXPECT_EQ(grp->GetASCII("Text", "Empty"), "Empty");
+
+    grp->SetFloat("Float", 1.5);
+    EXPECT_EQ(grp->GetFloat("Float"), 1.5);
+    cfg->RemoveGrp("TopLevelGroup");
+    EXPECT_EQ(grp->GetFloat("Float", 2.5), 2.5);
+}
+
+TEST_F(ParameterTest, TestParameterValue)
+{
+    auto cfg = getCreateConfig();
+    auto grp = cfg->GetGroup("TopLevelGroup");
+    ParameterValue<bool> flag(grp, "Flag", true);
+    ParameterValue<std::string> text(grp, "Text", "Preset");
+
+    EXPECT_TRUE(flag.get());
+    EXPECT_EQ(text.get(), "Preset");
+
+    grp->SetBool("Flag", false);
+    EXPECT_FALSE(flag.get());
+    flag.set(true);
+    EXPECT_TRUE(grp->GetBool("Flag", false));
+    EXPECT_TRUE(flag);
+
+    text.set("Value");
+    EXPECT_EQ(text.get(), "Value");
+    grp->RemoveASCII("Text");
+    EXPECT_EQ(text.get(), "Preset");
+}
+
 // NOLINTEND(cppcoreguidelines-*,readability-*)
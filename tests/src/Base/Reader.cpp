@@ -7,13 +7,16 @@
 #endif
 
 #include "Base/Exception.h"
+#include "Base/Persistence.h"
 #include "Base/Reader.h"
+#include "Base/Writer.h"
 #include <array>
 #include <filesystem>
 #include <fstream>
 #include <random>
 #include <string>
 #include <xercesc/util/PlatformUtils.hpp>
+#include <zipios++/zipinputstream.h>
 #include <QString>
 
 namespace fs = std::filesystem;
@@ -459,3 +462,168 @@ TEST_F(ReaderTest, validDefaults)
     EXPECT_THROW({ xml.Reader()->getAttribute<TimesIGoToBed>("missing"); }, Base::XMLBaseException);
     EXPECT_EQ(value20, TimesIGoToBed::Late);
 }
+
+namespace
+{
+
+class ReaderTestFile: public Base::Persistence
+{
+public:
+    ReaderTestFile(std::string content, bool decodable, std::vector<std::string>& log)
+        : content(std::move(content))
+        , decodable(decodable)
+        , log(log)
+    {}
+    unsigned int getMemSize() const override
+    {
+        return 0;
+    }
+    void Save(Base::Writer& /*writer*/) const override
+    {}
+    void Restore(Base::XMLReader& /*reader*/) override
+    {}
+    void SaveDocFile(Base::Writer& writer) const override
+    {
+        writer.Stream() << content;
+    }
+    void RestoreDocFile(Base::Reader& reader) override
+    {
+        restored.assign(std::istreambuf_iterator<char>(reader), std::istreambuf_iterator<char>());
+        log.push_back(restored);
+    }
+    bool canDecodeDocFile(const std::string& /*fileName*/) const override
+    {
+        return decodable;
+    }
+    std::function<void()> decodeDocFile(Base::Reader& reader) override
+    {
+        std::string data {std::istreambuf_iterator<char>(reader), std::istreambuf_iterator<char>()};
+        return [this, data]() {
+            restored = data;
+            log.push_back(restored);
+        };
+    }
+
+    std::string content;
+    std::string restored;
+
+private:
+    bool decodable;
+    std::vector<std::string>& log;
+};
+
+}  // namespace
+
+TEST_F(ReaderTest, readFilesConcurrentlyKeepsOrder)
+{
+    // Arrange
+    std::vector<std::string> log;
+    std::vector<std::unique_ptr<ReaderTestFile>> files;
+    for (int i = 0; i < 10; ++i) {
+        files.push_back(std::make_unique<ReaderTestFile>(std::string(i * 1000, char('a' + i)),
+                                                         i != 4,
+                                                         log));
+    }
+    std::stringstream zip;
+    {
+        Base::ZipWriter writer(zip);
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << "<?xml version='1.0' encoding='utf-8'?>\n<Document/>\n";
+        for (int i = 0; i < 10; ++i) {
+            writer.addFile(("File" + std::to_string(i) + ".txt").c_str(), files[i].get());
+        }
+        writer.writeFiles();
+    }
+    std::vector<std::unique_ptr<ReaderTestFile>> restored;
+    for (int i = 0; i < 10; ++i) {
+        restored.push_back(std::make_unique<ReaderTestFile>("", i != 4, log));
+    }
+
+    // Act
+    zip.seekg(0);
+    zipios::ZipInputStream zipstream(zip);
+    Base::XMLReader reader("Document.xml", zipstream);
+    for (int i = 0; i < 10; ++i) {
+        reader.addFile(("File" + std::to_string(i) + ".txt").c_str(), restored[i].get());
+    }
+    reader.setFileThreadCount(4);
+    reader.readFiles(zipstream);
+
+    // Assert
+    ASSERT_EQ(log.size(), 10U);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(restored[i]->restored, files[i]->content);
+        EXPECT_EQ(log[i], files[i]->content);
+    }
+}
+
+namespace
+{
+
+class ReaderTestDeferredFile: public ReaderTestFile
+{
+public:
+    using ReaderTestFile::ReaderTestFile;
+
+    bool canDeferDocFile(const std::string& /*fileName*/) const override
+    {
+        return true;
+    }
+    void deferDocFile(std::shared_ptr<Base::DeferredFile> file) override
+    {
+        deferred = std::move(file);
+    }
+
+    std::shared_ptr<Base::DeferredFile> deferred;
+};
+
+}  // namespace
+
+TEST_F(ReaderTest, readFilesDefersAcceptedFiles)
+{
+    // Arrange
+    std::vector<std::string> log;
+    ReaderTestFile first("first", false, log);
+    ReaderTestFile second(std::string(5000, 'x'), false, log);
+    ReaderTestFile third("third", false, log);
+    fs::path path =
+        fs::temp_directory_path() / ("unit_test_Reader-" + random_string(4) + ".FCStd");
+    {
+        std::ofstream file(path.string(), std::ios::out | std::ios::binary);
+        Base::ZipWriter writer(file);
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << "<?xml version='1.0' encoding='utf-8'?>\n<Document/>\n";
+        writer.addFile("File0.txt", &first);
+        writer.addFile("File1.txt", &second);
+        writer.addFile("File2.txt", &third);
+        writer.writeFiles();
+    }
+    ReaderTestFile restoredFirst("", false, log);
+    ReaderTestDeferredFile restoredSecond("", false, log);
+    ReaderTestFile restoredThird("", false, log);
+
+    // Act
+    {
+        std::ifstream file(path.string(), std::ios::in | std::ios::binary);
+        zipios::ZipInputStream zipstream(file);
+        Base::XMLReader reader(path.string().c_str(), zipstream);
+        reader.addFile("File0.txt", &restoredFirst);
+        reader.addFile("File1.txt", &restoredSecond);
+        reader.addFile("File2.txt", &restoredThird);
+        reader.setDeferFiles(true);
+        reader.readFiles(zipstream);
+    }
+    std::vector<std::string> logBeforeLoad = log;
+    ASSERT_TRUE(restoredSecond.deferred);
+    restoredSecond.deferred->read([&restoredSecond](Base::Reader& reader) {
+        restoredSecond.RestoreDocFile(reader);
+    });
+    fs::remove(path);
+
+    // Assert
+    ASSERT_EQ(logBeforeLoad.size(), 2U);
+    EXPECT_EQ(logBeforeLoad[0], "first");
+    EXPECT_EQ(logBeforeLoad[1], "third");
+    EXPECT_EQ(restoredSecond.deferred->getFileName(), "File1.txt");
+    EXPECT_EQ(restoredSecond.restored, second.content);
+}
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <Base/TraceRecorder.h>
+
+class TraceRecorderTest: public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        Base::TraceRecorder::instance().stop();
+        Base::TraceRecorder::instance().clear();
+    }
+};
+
+TEST_F(TraceRecorderTest, idleRecorderIgnoresScopes)
+{
+    auto& recorder = Base::TraceRecorder::instance();
+    bool called = false;
+    {
+        Base::TraceScope scope("test", [&called]() {
+            called = true;
+            return std::string("name");
+        });
+    }
+    EXPECT_FALSE(called);
+    EXPECT_EQ(recorder.size(), 0U);
+}
+
+TEST_F(TraceRecorderTest, nestedScopesAreRecorded)
+{
+    auto& recorder = Base::TraceRecorder::instance();
+    recorder.start();
+    {
+        Base::TraceScope outer("execute", "Outer");
+        {
+            Base::TraceScope inner("onChanged", "Inner");
+            inner.setDetail("value");
+        }
+        recorder.addInstant("touch", "Touched");
+    }
+    recorder.stop();
+
+    auto events = recorder.getEvents();
+    ASSERT_EQ(events.size(), 3U);
+    EXPECT_EQ(events[0].name, "Inner");
+    EXPECT_EQ(events[0].detail, "value");
+    EXPECT_EQ(events[1].name, "Touched");
+    EXPECT_LT(events[1].duration, 0);
+    EXPECT_EQ(events[2].name, "Outer");
+    EXPECT_LE(events[2].start, events[0].start);
+    EXPECT_GE(events[2].start + events[2].duration, events[0].start + events[0].duration);
+}
+
+TEST_F(TraceRecorderTest, writeChromeTraceEscapesNames)
+{
+    auto& recorder = Base::TraceRecorder::instance();
+    recorder.start();
+    recorder.addEvent("execute", "Doc#\"Box\"", 5, 10, "line1\nline2");
+    recorder.stop();
+
+    std::ostringstream str;
+    recorder.writeChromeTrace(str);
+    std::string json = str.str();
+    EXPECT_NE(json.find("\"traceEvents\":["), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"Doc#\\\"Box\\\"\""), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"X\",\"dur\":10,\"ts\":5"), std::string::npos);
+    EXPECT_NE(json.find("\"detail\":\"line1\\nline2\""), std::string::npos);
+}
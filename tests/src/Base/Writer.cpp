@@ -2,7 +2,12 @@
 
 #include <gtest/gtest.h>
 
+#include <sstream>
+#include <zipios++/zipinputstream.h>
+
+#include "Base/BinaryXML.h"
 #include "Base/Exception.h"
+#include "Base/Persistence.h"
 #include "Base/Writer.h"
 
 // Writer is designed to be a base class, so for testing we actually instantiate a StringWriter,
@@ -129,3 +134,107 @@ TEST_F(WriterTest, charStreamBase64Encoded)
     // Conversion done using https://www.base64encode.org for testing purposes
     EXPECT_EQ(std::string("RnJlZUNBRCByb2NrcyEg8J+qqPCfqqjwn6qo\n"), _writer.getString());
 }
+
+namespace
+{
+
+class ZipWriterTestObject: public Base::Persistence
+{
+public:
+    explicit ZipWriterTestObject(std::string content)
+        : content(std::move(content))
+    {}
+    unsigned int getMemSize() const override
+    {
+        return static_cast<unsigned int>(content.size());
+    }
+    void Save(Base::Writer& /*writer*/) const override
+    {}
+    void Restore(Base::XMLReader& /*reader*/) override
+    {}
+    void SaveDocFile(Base::Writer& writer) const override
+    {
+        writer.Stream() << content;
+    }
+
+private:
+    std::string content;
+};
+
+std::string makeZipTestContent(int index)
+{
+    std::ostringstream str;
+    for (int i = 0; i < index * 10000; ++i) {
+        str << i * index << ' ';
+    }
+    return str.str();
+}
+
+}  // namespace
+
+TEST(ZipWriter, concurrentEntriesKeepOrderAndContent)
+{
+    // Arrange
+    std::vector<ZipWriterTestObject> objects;
+    for (int i = 0; i < 12; ++i) {
+        objects.emplace_back(makeZipTestContent(i));
+    }
+    std::stringstream zip;
+
+    // Act
+    {
+        Base::ZipWriter writer(zip);
+        writer.setThreadCount(4);
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << "<Document/>";
+        for (int i = 0; i < 12; ++i) {
+            writer.addFile(("File" + std::to_string(i) + ".txt").c_str(), &objects[i]);
+        }
+        writer.writeFiles();
+        EXPECT_FALSE(writer.hasErrors());
+    }
+
+    // Assert
+    zip.seekg(0);
+    zipios::ZipInputStream reader(zip);
+    std::string xml;
+    std::getline(reader, xml);
+    EXPECT_EQ(xml, "<Document/>");
+    for (int i = 0; i < 12; ++i) {
+        auto entry = reader.getNextEntry();
+        ASSERT_TRUE(entry && entry->isValid());
+        EXPECT_EQ(entry->getName(), "File" + std::to_string(i) + ".txt");
+        std::string content((std::istreambuf_iterator<char>(reader)),
+                            std::istreambuf_iterator<char>());
+        EXPECT_EQ(content, makeZipTestContent(i));
+    }
+}
+
+TEST(ZipWriter, binaryXMLKeepsPlainEntry)
+{
+    // Arrange
+    std::stringstream zip;
+
+    // Act
+    {
+        Base::ZipWriter writer(zip);
+        writer.putNextEntry("Document.xml");
+        writer.beginBinaryXML("Document.fcbin");
+        writer.Stream() << "<Document/>";
+        writer.endBinaryXML();
+        writer.writeFiles();
+        EXPECT_FALSE(writer.hasErrors());
+    }
+
+    // Assert
+    zip.seekg(0);
+    zipios::ZipInputStream reader(zip);
+    std::string xml((std::istreambuf_iterator<char>(reader)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(xml, "<Document/>");
+    auto entry = reader.getNextEntry();
+    ASSERT_TRUE(entry && entry->isValid());
+    EXPECT_EQ(entry->getName(), "Document.fcbin");
+    std::string binary((std::istreambuf_iterator<char>(reader)), std::istreambuf_iterator<char>());
+    std::istringstream str(binary);
+    EXPECT_TRUE(Base::isBinaryXML(str));
+}
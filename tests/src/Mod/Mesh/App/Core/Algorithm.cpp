@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <src/Mod/Mesh/App/MeshTestHelpers.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MeshAdjacencyTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // A wavy grid that is large enough to be built by several threads
+        const int size = 100;
+        std::vector<MeshCore::MeshGeomFacet> facets;
+        auto point = [](int i, int j) {
+            return Base::Vector3f(float(i), float(j), float((i * j) % 7));
+        };
+        MeshTestHelpers::addGrid(facets, size, point);
+        kernel = facets;
+    }
+
+    template<class Set>
+    static std::vector<MeshCore::ElementIndex> toVector(const Set& set)
+    {
+        return {set.begin(), set.end()};
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(MeshAdjacencyTest, PointToFacetsMatchesSets)
+{
+    MeshCore::MeshRefPointToFacets sets(kernel);
+    MeshCore::MeshCompactPointToFacets compact(kernel);
+
+    ASSERT_EQ(compact.size(), kernel.CountPoints());
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        EXPECT_EQ(toVector(compact[i]), toVector(sets[i]));
+        EXPECT_EQ(compact.NeighbourPoints(i), sets.NeighbourPoints(i));
+    }
+    EXPECT_EQ(compact.NeighbourPoints({0, 1}, 3), sets.NeighbourPoints({0, 1}, 3));
+    EXPECT_EQ(compact.GetIndices(1, 102), sets.GetIndices(1, 102));
+    EXPECT_EQ(compact.GetIndices(1, 101, 102), sets.GetIndices(1, 101, 102));
+}
+
+TEST_F(MeshAdjacencyTest, FacetToFacetsMatchesSets)
+{
+    MeshCore::MeshRefFacetToFacets sets(kernel);
+    MeshCore::MeshCompactFacetToFacets compact(kernel);
+
+    ASSERT_EQ(compact.size(), kernel.CountFacets());
+    for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+        EXPECT_EQ(toVector(compact[i]), toVector(sets[i]));
+    }
+    EXPECT_EQ(compact.GetIndices(0, 3), sets.GetIndices(0, 3));
+}
+
+TEST_F(MeshAdjacencyTest, PointToPointsMatchesSets)
+{
+    MeshCore::MeshRefPointToPoints sets(kernel);
+    MeshCore::MeshCompactPointToPoints compact(kernel);
+
+    ASSERT_EQ(compact.size(), kernel.CountPoints());
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        EXPECT_EQ(toVector(compact[i]), toVector(sets[i]));
+        EXPECT_FLOAT_EQ(compact.GetAverageEdgeLength(i), sets.GetAverageEdgeLength(i));
+    }
+}
+
+TEST_F(MeshAdjacencyTest, IndexRangeLookup)
+{
+    MeshCore::MeshCompactPointToPoints compact(kernel);
+    MeshCore::MeshIndexRange range = compact[500];
+
+    ASSERT_GE(range.size(), 2);
+    EXPECT_TRUE(std::is_sorted(range.begin(), range.end()));
+    EXPECT_EQ(range.count(range[1]), 1);
+    EXPECT_EQ(range.find(range[1]), range.begin() + 1);
+    EXPECT_EQ(range.count(500), 0);
+    EXPECT_EQ(range.find(500), range.end());
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
+#include <Mod/Mesh/App/Core/Grid.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <src/Mod/Mesh/App/MeshTestHelpers.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MeshBVHTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // A few huge facets next to a finely tessellated wavy strip
+        std::vector<MeshCore::MeshGeomFacet> facets;
+        facets.emplace_back(Base::Vector3f(-100, -100, -5),
+                            Base::Vector3f(100, -100, -5),
+                            Base::Vector3f(-100, 100, -5));
+        facets.emplace_back(Base::Vector3f(-100, 100, -5),
+                            Base::Vector3f(100, -100, -5),
+                            Base::Vector3f(100, 100, -5));
+        const int size = 80;
+        const float step = 0.05F;
+        auto point = [step](int i, int j) {
+            return Base::Vector3f(float(i) * step,
+                                  float(j) * step,
+                                  0.1F * std::sin(float(i + j) * step));
+        };
+        MeshTestHelpers::addGrid(facets, size, point);
+        kernel = facets;
+    }
+
+    std::vector<Base::Vector3f> randomPoints(std::size_t count, float min, float max)
+    {
+        std::uniform_real_distribution<float> dist(min, max);
+        std::vector<Base::Vector3f> points;
+        points.reserve(count);
+        for (std::size_t i = 0; i < count; i++) {
+            points.emplace_back(dist(rng), dist(rng), dist(rng));
+        }
+        return points;
+    }
+
+    MeshCore::MeshKernel kernel;
+    std::mt19937 rng {42};
+};
+
+TEST_F(MeshBVHTest, NearestFacetOnRayMatchesBruteForce)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+    MeshCore::MeshAlgorithm algo(kernel);
+    auto bases = randomPoints(200, -1.0F, 5.0F);
+    auto dirs = randomPoints(200, -1.0F, 1.0F);
+
+    int hits = 0;
+    for (std::size_t i = 0; i < bases.size(); i++) {
+        Base::Vector3f res1, res2;
+        MeshCore::FacetIndex facet1 {}, facet2 {};
+        bool found1 = algo.NearestFacetOnRay(bases[i], dirs[i], res1, facet1);
+        bool found2 = algo.NearestFacetOnRay(bases[i], dirs[i], bvh, res2, facet2);
+        ASSERT_EQ(found1, found2);
+        if (found1) {
+            hits++;
+            EXPECT_NEAR(Base::Distance(bases[i], res1), Base::Distance(bases[i], res2), 1e-4F);
+        }
+    }
+    EXPECT_GT(hits, 0);
+}
+
+TEST_F(MeshBVHTest, NearestFacetsOnRaysMatchesSingleQueries)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+    auto bases = randomPoints(500, -1.0F, 5.0F);
+    auto dirs = randomPoints(500, -1.0F, 1.0F);
+    std::vector<MeshCore::MeshFacetBVH::Ray> rays;
+    for (std::size_t i = 0; i < bases.size(); i++) {
+        rays.emplace_back(bases[i], dirs[i]);
+    }
+
+    auto hits = bvh.NearestFacetsOnRays(rays);
+    ASSERT_EQ(hits.size(), rays.size());
+    for (std::size_t i = 0; i < rays.size(); i++) {
+        Base::Vector3f res;
+        MeshCore::FacetIndex facet = MeshCore::FACET_INDEX_MAX;
+        bvh.NearestFacetOnRay(rays[i].first, rays[i].second, res, facet);
+        EXPECT_EQ(hits[i].facet, facet);
+    }
+}
+
+TEST_F(MeshBVHTest, NearestFacetMatchesGrid)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+    MeshCore::MeshFacetGrid grid(kernel);
+    for (const auto& point : randomPoints(200, -2.0F, 6.0F)) {
+        MeshCore::FacetIndex facet1 = grid.SearchNearestFromPoint(point);
+        MeshCore::FacetIndex facet2 = bvh.NearestFacet(point);
+        ASSERT_NE(facet2, MeshCore::FACET_INDEX_MAX);
+        EXPECT_NEAR(kernel.GetFacet(facet1).DistanceToPoint(point),
+                    kernel.GetFacet(facet2).DistanceToPoint(point),
+                    1e-5F);
+    }
+}
+
+TEST_F(MeshBVHTest, NearestFacetRespectsMaxDistance)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+    Base::Vector3f point(-50, -50, 10);
+    EXPECT_EQ(bvh.NearestFacet(point, 10.0F), MeshCore::FACET_INDEX_MAX);
+    EXPECT_EQ(bvh.NearestFacet(point, 20.0F), 0);
+}
+
+TEST_F(MeshBVHTest, NearestFacetsAreSorted)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+    for (const auto& point : randomPoints(50, 0.0F, 4.0F)) {
+        auto nearest = bvh.NearestFacets(point, 10);
+        ASSERT_EQ(nearest.size(), 10);
+        EXPECT_EQ(nearest.front().first, bvh.NearestFacet(point));
+
+        // no other facet is nearer than the farthest one found
+        float maxDist = nearest.back().second;
+        std::size_t nearer = 0;
+        for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+            if (kernel.GetFacet(i).DistanceToPoint(point) < maxDist) {
+                nearer++;
+            }
+        }
+        EXPECT_LT(nearer, 10);
+        for (std::size_t i = 1; i < nearest.size(); i++) {
+            EXPECT_LE(nearest[i - 1].second, nearest[i].second);
+        }
+    }
+}
+
+TEST_F(MeshBVHTest, InsideMatchesBruteForce)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+    Base::BoundBox3f box(1.0F, 1.0F, -1.0F, 2.0F, 1.5F, 1.0F);
+    std::vector<MeshCore::FacetIndex> facets;
+    bvh.Inside(box, facets);
+    std::sort(facets.begin(), facets.end());
+
+    std::vector<MeshCore::FacetIndex> expected;
+    for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+        if (kernel.GetFacet(i).GetBoundBox() && box) {
+            expected.push_back(i);
+        }
+    }
+    EXPECT_EQ(facets, expected);
+}
+
+TEST_F(MeshBVHTest, EmptyMesh)
+{
+    MeshCore::MeshKernel empty;
+    MeshCore::MeshFacetBVH bvh(empty);
+    Base::Vector3f res;
+    MeshCore::FacetIndex facet {};
+    EXPECT_EQ(bvh.CountNodes(), 0);
+    EXPECT_FALSE(bvh.NearestFacetOnRay(Base::Vector3f(), Base::Vector3f(0, 0, 1), res, facet));
+    EXPECT_EQ(bvh.NearestFacet(Base::Vector3f()), MeshCore::FACET_INDEX_MAX);
+    EXPECT_TRUE(bvh.NearestFacets(Base::Vector3f(), 3).empty());
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
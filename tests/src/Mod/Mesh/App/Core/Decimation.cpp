@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Decimation.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <src/Mod/Mesh/App/MeshTestHelpers.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MeshDecimationTest: public ::testing::Test
+{
+protected:
+    static bool isClosedManifold(const MeshCore::MeshKernel& kernel)
+    {
+        MeshCore::MeshEvalSolid solid(kernel);
+        MeshCore::MeshEvalTopology topology(kernel);
+        return solid.Evaluate() && topology.Evaluate();
+    }
+};
+
+TEST_F(MeshDecimationTest, TargetSizeOfSmallMesh)
+{
+    MeshCore::MeshKernel kernel;
+    MeshTestHelpers::makeTorus(kernel, 60, 30);
+    ASSERT_EQ(kernel.CountFacets(), 3600);
+
+    MeshCore::MeshSimplify simplify(kernel);
+    simplify.simplify(1000);
+    EXPECT_LE(kernel.CountFacets(), 1000);
+    EXPECT_GT(kernel.CountFacets(), 900);
+    EXPECT_TRUE(isClosedManifold(kernel));
+}
+
+TEST_F(MeshDecimationTest, TargetSizeWithClusters)
+{
+    MeshCore::MeshKernel kernel;
+    MeshTestHelpers::makeTorus(kernel, 200, 100);
+    ASSERT_EQ(kernel.CountFacets(), 40000);
+    float area = kernel.GetSurface();
+
+    MeshCore::MeshSimplify simplify(kernel);
+    simplify.setMaxClusterSize(2000);
+    simplify.simplify(4000);
+    EXPECT_LE(kernel.CountFacets(), 4400);
+    EXPECT_GT(kernel.CountFacets(), 3600);
+    EXPECT_TRUE(isClosedManifold(kernel));
+    EXPECT_NEAR(kernel.GetSurface(), area, 0.02F * area);
+}
+
+TEST_F(MeshDecimationTest, ClustersKeepBorder)
+{
+    MeshCore::MeshKernel kernel;
+    MeshTestHelpers::makePlane(kernel, 100);
+    ASSERT_EQ(kernel.CountFacets(), 20000);
+    Base::BoundBox3f box = kernel.GetBoundBox();
+
+    MeshCore::MeshSimplify simplify(kernel);
+    simplify.setMaxClusterSize(1000);
+    simplify.simplify(0.001F, 0.9F);
+    EXPECT_LE(kernel.CountFacets(), 2200);
+    EXPECT_GT(kernel.CountFacets(), 1800);
+    EXPECT_NEAR(kernel.GetSurface(), 10000.0F, 100.0F);
+    EXPECT_EQ(kernel.GetBoundBox().MinX, box.MinX);
+    EXPECT_EQ(kernel.GetBoundBox().MaxX, box.MaxX);
+    EXPECT_EQ(kernel.GetBoundBox().MinY, box.MinY);
+    EXPECT_EQ(kernel.GetBoundBox().MaxY, box.MaxY);
+
+    MeshCore::MeshEvalTopology topology(kernel);
+    EXPECT_TRUE(topology.Evaluate());
+}
+
+TEST_F(MeshDecimationTest, ToleranceLimitsReduction)
+{
+    MeshCore::MeshKernel kernel;
+    MeshTestHelpers::makeTorus(kernel, 200, 100);
+
+    MeshCore::MeshSimplify simplify(kernel);
+    simplify.setMaxClusterSize(2000);
+    simplify.simplify(1e-5F, 0.9F);
+    EXPECT_LT(kernel.CountFacets(), 40000);
+    EXPECT_GT(kernel.CountFacets(), 8000);
+    EXPECT_TRUE(isClosedManifold(kernel));
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <Mod/Mesh/App/Core/Degeneration.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/HealthCheck.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <src/Mod/Mesh/App/MeshTestHelpers.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MeshHealthCheckTest: public ::testing::Test
+{
+protected:
+    template<class T>
+    static std::vector<T> sorted(std::vector<T> indices)
+    {
+        std::sort(indices.begin(), indices.end());
+        return indices;
+    }
+};
+
+TEST_F(MeshHealthCheckTest, CleanMeshIsValid)
+{
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    MeshTestHelpers::makeTorus(points, facets, 60, 30);
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+
+    MeshCore::MeshHealthCheck check(kernel);
+    MeshCore::MeshHealthReport report = check.Evaluate();
+    EXPECT_TRUE(report.IsValid());
+    EXPECT_EQ(report.openEdges, 0);
+}
+
+TEST_F(MeshHealthCheckTest, DefectsMatchEvaluators)
+{
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    MeshTestHelpers::makeTorus(points, facets, 60, 30);
+
+    // a flipped facet
+    std::swap(facets[100]._aulPoints[0], facets[100]._aulPoints[1]);
+    // a duplicated facet, which also creates three non-manifold edges
+    facets.push_back(facets[200]);
+    // a duplicated point used by a dangling facet
+    auto count = MeshCore::PointIndex(points.size());
+    points.push_back(points[10]);
+    points.push_back(Base::Vector3f(0.0F, 0.0F, 20.0F));
+    facets.push_back(MeshCore::MeshFacet(count, count + 1, 20));
+    // a triangle piercing the torus from outside
+    Base::Vector3f center = points[500];
+    points.push_back(center + Base::Vector3f(-1.0F, -1.0F, -1.0F));
+    points.push_back(center + Base::Vector3f(1.0F, 1.0F, -1.0F));
+    points.push_back(center + Base::Vector3f(0.0F, 0.0F, 1.0F));
+    auto piercing = MeshCore::FacetIndex(facets.size());
+    facets.push_back(MeshCore::MeshFacet(count + 2, count + 3, count + 4));
+
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+    MeshCore::MeshHealthReport report = MeshCore::MeshHealthCheck(kernel).Evaluate();
+    EXPECT_FALSE(report.IsValid());
+
+    MeshCore::MeshEvalDuplicatePoints duplicatePoints(kernel);
+    duplicatePoints.Evaluate();
+    // the health check keeps the point with the lower index
+    EXPECT_EQ(duplicatePoints.GetIndices().size(), 1);
+    EXPECT_EQ(report.duplicatedPoints, std::vector<MeshCore::PointIndex> {count});
+
+    MeshCore::MeshEvalDuplicateFacets duplicateFacets(kernel);
+    duplicateFacets.Evaluate();
+    EXPECT_EQ(report.duplicatedFacets, sorted(duplicateFacets.GetIndices()));
+    EXPECT_EQ(report.duplicatedFacets.size(), 1);
+
+    MeshCore::MeshEvalTopology topology(kernel);
+    topology.Evaluate();
+    EXPECT_EQ(report.nonManifoldEdges.size(), topology.GetIndices().size());
+    EXPECT_EQ(report.nonManifoldEdges.size(), 3);
+
+    MeshCore::MeshEvalPointManifolds pointManifolds(kernel);
+    pointManifolds.Evaluate();
+    EXPECT_EQ(report.nonManifoldPoints.size(), pointManifolds.CountManifolds());
+
+    MeshCore::MeshEvalNeighbourhood neighbourhood(kernel);
+    EXPECT_EQ(report.invalidNeighbourhood, neighbourhood.GetIndices());
+
+    MeshCore::MeshEvalOrientation orientation(kernel);
+    EXPECT_EQ(report.nonUniformOrientedFacets, orientation.GetIndices());
+    EXPECT_FALSE(report.nonUniformOrientedFacets.empty());
+
+    MeshCore::MeshEvalFoldsOnSurface foldsOnSurface(kernel);
+    foldsOnSurface.Evaluate();
+    EXPECT_EQ(report.foldsOnSurface, foldsOnSurface.GetIndices());
+
+    MeshCore::MeshEvalFoldsOnBoundary foldsOnBoundary(kernel);
+    foldsOnBoundary.Evaluate();
+    EXPECT_EQ(report.foldsOnBoundary, foldsOnBoundary.GetIndices());
+
+    MeshCore::MeshEvalFoldOversOnSurface foldOvers(kernel);
+    foldOvers.Evaluate();
+    EXPECT_EQ(report.foldOversOnSurface, foldOvers.GetIndices());
+
+    MeshCore::MeshEvalSolid solid(kernel);
+    EXPECT_EQ(solid.Evaluate(), report.openEdges == 0);
+    EXPECT_EQ(report.openEdges, 6);
+
+    // the evaluator reports some pairs twice and in any order
+    MeshCore::MeshEvalSelfIntersection selfIntersection(kernel);
+    std::vector<std::pair<MeshCore::FacetIndex, MeshCore::FacetIndex>> intersections;
+    selfIntersection.GetIntersections(intersections);
+    for (auto& pair : intersections) {
+        if (pair.first > pair.second) {
+            std::swap(pair.first, pair.second);
+        }
+    }
+    intersections = sorted(intersections);
+    intersections.erase(std::unique(intersections.begin(), intersections.end()),
+                        intersections.end());
+    EXPECT_TRUE(std::includes(report.selfIntersections.begin(),
+                              report.selfIntersections.end(),
+                              intersections.begin(),
+                              intersections.end()));
+    EXPECT_TRUE(std::any_of(report.selfIntersections.begin(),
+                            report.selfIntersections.end(),
+                            [piercing](const auto& pair) {
+                                return pair.second == piercing;
+                            }));
+}
+
+TEST_F(MeshHealthCheckTest, DegeneratedFacets)
+{
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    MeshTestHelpers::makeTorus(points, facets, 60, 30);
+    // move a point onto the opposite edge of the facet (9, 39, 40)
+    points[40] = (points[9] + points[39]) * 0.5F;
+    facets.push_back(MeshCore::MeshFacet(1, 2, 2));
+
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+    MeshCore::MeshHealthReport report = MeshCore::MeshHealthCheck(kernel).Evaluate();
+
+    MeshCore::MeshEvalDegeneratedFacets degenerated(kernel, 0.0F);
+    EXPECT_EQ(report.degeneratedFacets, degenerated.GetIndices());
+    EXPECT_FALSE(report.degeneratedFacets.empty());
+
+    MeshCore::MeshEvalCorruptedFacets corrupted(kernel);
+    EXPECT_EQ(report.corruptedFacets, corrupted.GetIndices());
+    EXPECT_EQ(report.corruptedFacets.size(), 1);
+}
+
+TEST_F(MeshHealthCheckTest, IndicesOutOfRange)
+{
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    MeshTestHelpers::makeTorus(points, facets, 20, 10);
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+
+    points = kernel.GetPoints();
+    facets = kernel.GetFacets();
+    facets[5]._aulPoints[2] = MeshCore::PointIndex(points.size());
+    facets[7]._aulNeighbours[1] = MeshCore::FacetIndex(facets.size() + 3);
+    kernel.Adopt(points, facets, false);
+
+    MeshCore::MeshHealthReport report = MeshCore::MeshHealthCheck(kernel).Evaluate();
+    EXPECT_EQ(report.pointsOutOfRange, std::vector<MeshCore::FacetIndex> {5});
+    EXPECT_EQ(report.facetsOutOfRange, std::vector<MeshCore::FacetIndex> {7});
+    EXPECT_TRUE(report.invalidNeighbourhood.empty());
+    EXPECT_TRUE(report.selfIntersections.empty());
+}
+
+TEST_F(MeshHealthCheckTest, SkipSelfIntersections)
+{
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    MeshTestHelpers::makeTorus(points, facets, 60, 30);
+    // a second torus linked with the first one like a chain, shifted to avoid shared points
+    MeshCore::MeshPointArray points2;
+    MeshCore::MeshFacetArray facets2;
+    MeshTestHelpers::makeTorus(points2, facets2, 60, 30);
+    auto offset = MeshCore::PointIndex(points.size());
+    for (const auto& pt : points2) {
+        points.push_back(Base::Vector3f(pt.x + 20.0F, pt.z + 0.25F, pt.y));
+    }
+    for (auto facet : facets2) {
+        for (auto& index : facet._aulPoints) {
+            index += offset;
+        }
+        facets.push_back(facet);
+    }
+
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+    MeshCore::MeshHealthCheck check(kernel);
+    EXPECT_FALSE(check.Evaluate().selfIntersections.empty());
+
+    check.SetCheckSelfIntersections(false);
+    MeshCore::MeshHealthReport report = check.Evaluate();
+    EXPECT_TRUE(report.selfIntersections.empty());
+    EXPECT_TRUE(report.IsValid());
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
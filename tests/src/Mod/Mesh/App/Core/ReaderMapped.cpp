@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <fstream>
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+#include <Mod/Mesh/App/Core/IO/ReaderMapped.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <src/Mod/Mesh/App/MeshTestHelpers.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class ReaderMappedTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // A wavy grid with enough facets to be split into several chunks
+        const int size = 300;
+        std::vector<MeshCore::MeshGeomFacet> facets;
+        auto point = [](int i, int j) {
+            return Base::Vector3f(float(i) * 0.5F, float(j) * 0.25F, std::sin(float(i + j)));
+        };
+        MeshTestHelpers::addGrid(facets, size, point);
+        kernel = facets;
+    }
+
+    void TearDown() override
+    {
+        fileInfo.deleteFile();
+    }
+
+    void save(const char* ext, MeshCore::MeshIO::Format format)
+    {
+        fileInfo.setFile(Base::FileInfo::getTempFileName() + ext);
+        Base::ofstream str(fileInfo, std::ios::out | std::ios::binary);
+        MeshCore::MeshOutput output(kernel);
+        ASSERT_TRUE(output.SaveFormat(str, format));
+    }
+
+    void saveText(const char* ext, const std::string& text)
+    {
+        fileInfo.setFile(Base::FileInfo::getTempFileName() + ext);
+        Base::ofstream str(fileInfo, std::ios::out | std::ios::binary);
+        str << text;
+    }
+
+    // compares facet by facet as the point order may differ
+    static void expectSameFacets(const MeshCore::MeshKernel& mesh1,
+                                 const MeshCore::MeshKernel& mesh2)
+    {
+        ASSERT_EQ(mesh1.CountFacets(), mesh2.CountFacets());
+        EXPECT_EQ(mesh1.CountPoints(), mesh2.CountPoints());
+        for (MeshCore::FacetIndex i = 0; i < mesh1.CountFacets(); i++) {
+            MeshCore::MeshGeomFacet facet1 = mesh1.GetFacet(i);
+            MeshCore::MeshGeomFacet facet2 = mesh2.GetFacet(i);
+            for (int j = 0; j < 3; j++) {
+                EXPECT_EQ(facet1._aclPoints[j], facet2._aclPoints[j]);
+            }
+        }
+    }
+
+    MeshCore::MeshKernel kernel;
+    Base::FileInfo fileInfo;
+};
+
+TEST_F(ReaderMappedTest, BinarySTL)
+{
+    save(".stl", MeshCore::MeshIO::BSTL);
+
+    MeshCore::MeshKernel mesh;
+    MeshCore::ReaderMapped reader(mesh);
+    float last = -1.0F;
+    reader.SetProgress([&last](float value) {
+        EXPECT_GE(value, last);
+        last = value;
+        return true;
+    });
+    ASSERT_TRUE(reader.LoadBinarySTL(fileInfo.filePath()));
+    EXPECT_EQ(last, 1.0F);
+    expectSameFacets(mesh, kernel);
+    EXPECT_EQ(mesh.CountEdges(), kernel.CountEdges());
+}
+
+TEST_F(ReaderMappedTest, AsciiSTLIsRejected)
+{
+    save(".stl", MeshCore::MeshIO::ASTL);
+
+    MeshCore::MeshKernel mesh;
+    MeshCore::ReaderMapped reader(mesh);
+    EXPECT_FALSE(reader.LoadBinarySTL(fileInfo.filePath()));
+}
+
+TEST_F(ReaderMappedTest, CancelSTL)
+{
+    save(".stl", MeshCore::MeshIO::BSTL);
+
+    MeshCore::MeshKernel mesh;
+    MeshCore::ReaderMapped reader(mesh);
+    reader.SetProgress([](float value) {
+        return value < 0.5F;
+    });
+    EXPECT_THROW(reader.LoadBinarySTL(fileInfo.filePath()), Base::AbortException);
+}
+
+TEST_F(ReaderMappedTest, BinaryPLY)
+{
+    save(".ply", MeshCore::MeshIO::PLY);
+
+    MeshCore::MeshKernel mesh;
+    MeshCore::ReaderMapped reader(mesh);
+    ASSERT_TRUE(reader.LoadPLY(fileInfo.filePath()));
+    expectSameFacets(mesh, kernel);
+}
+
+TEST_F(ReaderMappedTest, AsciiPLYIsRejected)
+{
+    save(".ply", MeshCore::MeshIO::APLY);
+
+    MeshCore::MeshKernel mesh;
+    MeshCore::ReaderMapped reader(mesh);
+    EXPECT_FALSE(reader.LoadPLY(fileInfo.filePath()));
+}
+
+TEST_F(ReaderMappedTest, OBJ)
+{
+    save(".obj", MeshCore::MeshIO::OBJ);
+
+    MeshCore::MeshKernel mesh1;
+    MeshCore::ReaderMapped reader(mesh1);
+    ASSERT_TRUE(reader.LoadOBJ(fileInfo.filePath()));
+
+    MeshCore::MeshKernel mesh2;
+    MeshCore::MeshInput input(mesh2);
+    Base::ifstream str(fileInfo, std::ios::in | std::ios::binary);
+    ASSERT_TRUE(input.LoadOBJ(str));
+
+    expectSameFacets(mesh1, mesh2);
+    EXPECT_EQ(mesh1.GetFacets()[0]._ulProp, mesh2.GetFacets()[0]._ulProp);
+}
+
+TEST_F(ReaderMappedTest, OBJWithQuadsAndRelativeIndices)
+{
+    saveText(".obj",
+             "# quad\r\n"
+             "v 0 0 0\r\n"
+             "v 1 0 0\r\n"
+             "v 1 1 0\r\n"
+             "v 0 1 0\r\n"
+             "f 1/1 2/2 3/3 4/4\r\n"
+             "v 0 0 1\r\n"
+             "f -1 -5 -4\n"
+             "f 1 2 9");
+
+    MeshCore::MeshKernel mesh;
+    MeshCore::ReaderMapped reader(mesh);
+    ASSERT_TRUE(reader.LoadOBJ(fileInfo.filePath()));
+    EXPECT_EQ(mesh.CountPoints(), 5);
+    EXPECT_EQ(mesh.CountFacets(), 3);
+    EXPECT_EQ(mesh.GetFacet(2)._aclPoints[0], Base::Vector3f(0, 0, 1));
+}
+
+TEST_F(ReaderMappedTest, OBJWithGroupsIsRejected)
+{
+    saveText(".obj", "v 0 0 0\nv 1 0 0\nv 1 1 0\ng group\nf 1 2 3\n");
+
+    MeshCore::MeshKernel mesh;
+    MeshCore::ReaderMapped reader(mesh);
+    EXPECT_FALSE(reader.LoadOBJ(fileInfo.filePath()));
+}
+
+TEST_F(ReaderMappedTest, EmptyFile)
+{
+    saveText(".stl", "");
+
+    MeshCore::MeshKernel mesh;
+    MeshCore::ReaderMapped reader(mesh);
+    EXPECT_FALSE(reader.LoadBinarySTL(fileInfo.filePath()));
+}
+
+TEST_F(ReaderMappedTest, BinarySTLWithoutFacets)
+{
+    // header and a facet count of zero
+    saveText(".stl", std::string(84, '\0'));
+
+    MeshCore::MeshKernel mesh;
+    MeshCore::ReaderMapped reader(mesh);
+    ASSERT_TRUE(reader.LoadBinarySTL(fileInfo.filePath()));
+    EXPECT_EQ(mesh.CountPoints(), 0);
+    EXPECT_EQ(mesh.CountFacets(), 0);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
 #include <src/App/InitApplication.h>
+#include <App/Application.h>
+#include <App/Document.h>
 #include <Mod/Mesh/App/MeshFeature.h>
 
 class MeshFeatureTest: public ::testing::Test
@@ -37,4 +39,203 @@ TEST_F(MeshFeatureTest, getComplexElementTypes)
     EXPECT_STREQ(types[0], "Mesh");
     EXPECT_STREQ(types[1], "Segment");
 }
+
+TEST_F(MeshFeatureTest, undoPointMoveRestoresPoint)
+{
+    std::string docName = App::GetApplication().getUniqueDocumentName("test");
+    App::Document* doc = App::GetApplication().newDocument(docName.c_str(), "testUser");
+    doc->setUndoMode(1);
+    auto feature = doc->addObject<Mesh::Feature>();
+    feature->Mesh.setValuePtr(Mesh::MeshObject::createCube(1.0F, 1.0F, 1.0F));
+    Base::Vector3f original = feature->Mesh.getValue().getKernel().GetPoint(0);
+    Base::Vector3f moved(5.0F, 5.0F, 5.0F);
+
+    doc->openTransaction("Move point");
+    feature->Mesh.setPointIndices({{0, moved}});
+    doc->commitTransaction();
+
+    doc->undo();
+    EXPECT_EQ(feature->Mesh.getValue().getKernel().GetPoint(0), original);
+    EXPECT_EQ(feature->Mesh.getValue().countFacets(), 12U);
+
+    doc->redo();
+    EXPECT_EQ(feature->Mesh.getValue().getKernel().GetPoint(0), moved);
+
+    App::GetApplication().closeDocument(docName.c_str());
+}
+
+TEST_F(MeshFeatureTest, undoReplacedMeshRestoresIt)
+{
+    std::string docName = App::GetApplication().getUniqueDocumentName("test");
+    App::Document* doc = App::GetApplication().newDocument(docName.c_str(), "testUser");
+    doc->setUndoMode(1);
+    auto feature = doc->addObject<Mesh::Feature>();
+    feature->Mesh.setValuePtr(Mesh::MeshObject::createCube(1.0F, 1.0F, 1.0F));
+
+    doc->openTransaction("Replace mesh");
+    Mesh::MeshObject empty;
+    feature->Mesh.setValue(empty);
+    doc->commitTransaction();
+    EXPECT_EQ(feature->Mesh.getValue().countFacets(), 0U);
+
+    doc->undo();
+    EXPECT_EQ(feature->Mesh.getValue().countFacets(), 12U);
+
+    doc->redo();
+    EXPECT_EQ(feature->Mesh.getValue().countFacets(), 0U);
+
+    App::GetApplication().closeDocument(docName.c_str());
+}
+
+TEST_F(MeshFeatureTest, undoPointMovesAndReplaceInOneTransaction)
+{
+    std::string docName = App::GetApplication().getUniqueDocumentName("test");
+    App::Document* doc = App::GetApplication().newDocument(docName.c_str(), "testUser");
+    doc->setUndoMode(1);
+    auto feature = doc->addObject<Mesh::Feature>();
+    feature->Mesh.setValuePtr(Mesh::MeshObject::createCube(1.0F, 1.0F, 1.0F));
+    Base::Vector3f original0 = feature->Mesh.getValue().getKernel().GetPoint(0);
+    Base::Vector3f original7 = feature->Mesh.getValue().getKernel().GetPoint(7);
+
+    doc->openTransaction("Move points and replace mesh");
+    feature->Mesh.setPointIndices({{0, Base::Vector3f(5.0F, 5.0F, 5.0F)}});
+    feature->Mesh.setPointIndices({{7, Base::Vector3f(6.0F, 6.0F, 6.0F)}});
+    Mesh::MeshObject empty;
+    feature->Mesh.setValue(empty);
+    doc->commitTransaction();
+    EXPECT_EQ(feature->Mesh.getValue().countPoints(), 0U);
+
+    doc->undo();
+    EXPECT_EQ(feature->Mesh.getValue().countPoints(), 8U);
+    EXPECT_EQ(feature->Mesh.getValue().countFacets(), 12U);
+    EXPECT_EQ(feature->Mesh.getValue().getKernel().GetPoint(0), original0);
+    EXPECT_EQ(feature->Mesh.getValue().getKernel().GetPoint(7), original7);
+
+    doc->redo();
+    EXPECT_EQ(feature->Mesh.getValue().countPoints(), 0U);
+
+    App::GetApplication().closeDocument(docName.c_str());
+}
+
+TEST_F(MeshFeatureTest, undoSeveralPointMovesRestoresAll)
+{
+    std::string docName = App::GetApplication().getUniqueDocumentName("test");
+    App::Document* doc = App::GetApplication().newDocument(docName.c_str(), "testUser");
+    doc->setUndoMode(1);
+    auto feature = doc->addObject<Mesh::Feature>();
+    feature->Mesh.setValuePtr(Mesh::MeshObject::createCube(1.0F, 1.0F, 1.0F));
+    Base::Vector3f original0 = feature->Mesh.getValue().getKernel().GetPoint(0);
+    Base::Vector3f original1 = feature->Mesh.getValue().getKernel().GetPoint(1);
+
+    doc->openTransaction("Move points");
+    feature->Mesh.setPointIndices({{0, Base::Vector3f(5.0F, 5.0F, 5.0F)}});
+    feature->Mesh.setPointIndices({{0, Base::Vector3f(6.0F, 6.0F, 6.0F)},
+                                   {1, Base::Vector3f(7.0F, 7.0F, 7.0F)}});
+    doc->commitTransaction();
+
+    doc->undo();
+    EXPECT_EQ(feature->Mesh.getValue().getKernel().GetPoint(0), original0);
+    EXPECT_EQ(feature->Mesh.getValue().getKernel().GetPoint(1), original1);
+
+    App::GetApplication().closeDocument(docName.c_str());
+}
+
+TEST_F(MeshFeatureTest, selfAssignmentKeepsMesh)
+{
+    std::string docName = App::GetApplication().getUniqueDocumentName("test");
+    App::Document* doc = App::GetApplication().newDocument(docName.c_str(), "testUser");
+    doc->setUndoMode(1);
+    auto feature = doc->addObject<Mesh::Feature>();
+    feature->Mesh.setValuePtr(Mesh::MeshObject::createCube(1.0F, 1.0F, 1.0F));
+
+    doc->openTransaction("Assign mesh");
+    feature->Mesh.setValue(feature->Mesh.getValue());
+    EXPECT_EQ(feature->Mesh.getValue().countFacets(), 12U);
+    doc->commitTransaction();
+
+    doc->openTransaction("Assign kernel");
+    feature->Mesh.setValue(feature->Mesh.getValue().getKernel());
+    EXPECT_EQ(feature->Mesh.getValue().countFacets(), 12U);
+    doc->commitTransaction();
+
+    doc->undo();
+    EXPECT_EQ(feature->Mesh.getValue().countFacets(), 12U);
+    doc->undo();
+    EXPECT_EQ(feature->Mesh.getValue().countFacets(), 12U);
+
+    App::GetApplication().closeDocument(docName.c_str());
+}
+
+TEST_F(MeshFeatureTest, setValuePtrKeepsSharedMesh)
+{
+    std::string docName = App::GetApplication().getUniqueDocumentName("test");
+    App::Document* doc = App::GetApplication().newDocument(docName.c_str(), "testUser");
+    doc->setUndoMode(1);
+    auto feature = doc->addObject<Mesh::Feature>();
+    Base::Reference<Mesh::MeshObject> shared(Mesh::MeshObject::createCube(1.0F, 1.0F, 1.0F));
+    feature->Mesh.setValuePtr(shared);
+
+    doc->openTransaction("Replace mesh");
+    feature->Mesh.setValuePtr(new Mesh::MeshObject());
+    doc->commitTransaction();
+    EXPECT_EQ(shared->countFacets(), 12U);
+
+    doc->undo();
+    EXPECT_EQ(feature->Mesh.getValue().countFacets(), 12U);
+
+    App::GetApplication().closeDocument(docName.c_str());
+}
+
+TEST_F(MeshFeatureTest, replaceKeepsMeshDuringBeforeChange)
+{
+    std::string docName = App::GetApplication().getUniqueDocumentName("test");
+    App::Document* doc = App::GetApplication().newDocument(docName.c_str(), "testUser");
+    doc->setUndoMode(1);
+    auto feature = doc->addObject<Mesh::Feature>();
+    feature->Mesh.setValuePtr(Mesh::MeshObject::createCube(1.0F, 1.0F, 1.0F));
+    std::vector<unsigned long> seen;
+    auto conn = doc->signalBeforeChangeObject.connect(
+        [&](const App::DocumentObject&, const App::Property& prop) {
+            if (&prop == &feature->Mesh) {
+                seen.push_back(feature->Mesh.getValue().countFacets());
+            }
+        });
+
+    doc->openTransaction("Replace mesh");
+    Mesh::MeshObject empty;
+    feature->Mesh.setValue(empty);
+    doc->commitTransaction();
+    conn.disconnect();
+
+    ASSERT_EQ(seen.size(), 1);
+    EXPECT_EQ(seen[0], 12U);
+    doc->undo();
+    EXPECT_EQ(feature->Mesh.getValue().countFacets(), 12U);
+
+    App::GetApplication().closeDocument(docName.c_str());
+}
+
+TEST_F(MeshFeatureTest, undoPointMoveAfterUnrecordedChange)
+{
+    std::string docName = App::GetApplication().getUniqueDocumentName("test");
+    App::Document* doc = App::GetApplication().newDocument(docName.c_str(), "testUser");
+    doc->setUndoMode(1);
+    auto feature = doc->addObject<Mesh::Feature>();
+    feature->Mesh.setValuePtr(Mesh::MeshObject::createCube(1.0F, 1.0F, 1.0F));
+
+    doc->openTransaction("Move point");
+    feature->Mesh.setPointIndices({{7, Base::Vector3f(5.0F, 5.0F, 5.0F)}});
+    doc->commitTransaction();
+    // not recorded as no transaction is open
+    Mesh::MeshObject smaller;
+    smaller.addFacet(MeshCore::MeshGeomFacet(Base::Vector3f(0.0F, 0.0F, 0.0F),
+                                             Base::Vector3f(1.0F, 0.0F, 0.0F),
+                                             Base::Vector3f(0.0F, 1.0F, 0.0F)));
+    feature->Mesh.setValue(smaller);
+
+    EXPECT_NO_THROW(doc->undo());
+    EXPECT_EQ(feature->Mesh.getValue().countFacets(), 1U);
+
+    App::GetApplication().closeDocument(docName.c_str());
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
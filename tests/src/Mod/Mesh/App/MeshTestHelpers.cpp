@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <cmath>
+#include "MeshTestHelpers.h"
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+namespace MeshTestHelpers
+{
+
+void makeTorus(MeshCore::MeshPointArray& points,
+               MeshCore::MeshFacetArray& facets,
+               int rings,
+               int sides)
+{
+    const float radius = 10.0F;
+    const float tube = 3.0F;
+    for (int i = 0; i < rings; i++) {
+        float u = 2.0F * float(M_PI) * float(i) / float(rings);
+        for (int j = 0; j < sides; j++) {
+            float v = 2.0F * float(M_PI) * float(j) / float(sides);
+            float r = radius + tube * std::cos(v);
+            points.push_back(Base::Vector3f(r * std::cos(u), r * std::sin(u), tube * std::sin(v)));
+        }
+    }
+    auto index = [rings, sides](int i, int j) {
+        return MeshCore::PointIndex(((i + rings) % rings) * sides + (j + sides) % sides);
+    };
+    for (int i = 0; i < rings; i++) {
+        for (int j = 0; j < sides; j++) {
+            facets.push_back(
+                MeshCore::MeshFacet(index(i, j), index(i + 1, j), index(i + 1, j + 1)));
+            facets.push_back(
+                MeshCore::MeshFacet(index(i, j), index(i + 1, j + 1), index(i, j + 1)));
+        }
+    }
+}
+
+void makeTorus(MeshCore::MeshKernel& kernel, int rings, int sides)
+{
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    makeTorus(points, facets, rings, sides);
+    kernel.Adopt(points, facets, true);
+}
+
+void makePlane(MeshCore::MeshKernel& kernel, int size)
+{
+    MeshCore::MeshPointArray points;
+    for (int i = 0; i <= size; i++) {
+        for (int j = 0; j <= size; j++) {
+            points.push_back(Base::Vector3f(float(i), float(j), 0.0F));
+        }
+    }
+    MeshCore::MeshFacetArray facets;
+    auto index = [size](int i, int j) {
+        return MeshCore::PointIndex(i * (size + 1) + j);
+    };
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            facets.push_back(
+                MeshCore::MeshFacet(index(i, j), index(i + 1, j), index(i + 1, j + 1)));
+            facets.push_back(
+                MeshCore::MeshFacet(index(i, j), index(i + 1, j + 1), index(i, j + 1)));
+        }
+    }
+    kernel.Adopt(points, facets, true);
+}
+
+void addGrid(std::vector<MeshCore::MeshGeomFacet>& facets,
+             int size,
+             const std::function<Base::Vector3f(int, int)>& point)
+{
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            facets.emplace_back(point(i, j), point(i + 1, j), point(i, j + 1));
+            facets.emplace_back(point(i, j + 1), point(i + 1, j), point(i + 1, j + 1));
+        }
+    }
+}
+
+}  // namespace MeshTestHelpers
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <functional>
+#include <vector>
+#include <Mod/Mesh/App/Core/Elements.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+namespace MeshTestHelpers
+{
+
+/// The points and facets of a closed torus with 2 * rings * sides facets
+void makeTorus(MeshCore::MeshPointArray& points,
+               MeshCore::MeshFacetArray& facets,
+               int rings,
+               int sides);
+
+/// Sets \a kernel to a closed torus with 2 * rings * sides facets
+void makeTorus(MeshCore::MeshKernel& kernel, int rings, int sides);
+
+/// Sets \a kernel to a flat square with a border and 2 * size * size facets
+void makePlane(MeshCore::MeshKernel& kernel, int size);
+
+/** Appends a grid of 2 * size * size facets to \a facets
+ *  \a point returns the position of the grid point (i, j), e.g. with a varying
+ *  height to get a wavy grid.
+ */
+void addGrid(std::vector<MeshCore::MeshGeomFacet>& facets,
+             int size,
+             const std::function<Base::Vector3f(int, int)>& point);
+
+}  // namespace MeshTestHelpers
@@ -1,5 +1,7 @@
 #include "gtest/gtest.h"
 #include <src/App/InitApplication.h>
+#include <App/Application.h>
+#include <App/Document.h>
 #include <Mod/Points/App/PointsFeature.h>
 
 class PointsFeatureTest: public ::testing::Test
@@ -33,4 +35,60 @@ TEST_F(PointsFeatureTest, getComplexElementTypes)
 
     EXPECT_EQ(types.size(), 0);
 }
+
+TEST_F(PointsFeatureTest, selfAssignmentKeepsPoints)
+{
+    std::string docName = App::GetApplication().getUniqueDocumentName("test");
+    App::Document* doc = App::GetApplication().newDocument(docName.c_str(), "testUser");
+    doc->setUndoMode(1);
+    auto feature = doc->addObject<Points::Feature>();
+    Points::PointKernel points;
+    points.push_back(Base::Vector3d(1.0, 2.0, 3.0));
+    points.push_back(Base::Vector3d(4.0, 5.0, 6.0));
+    feature->Points.setValue(points);
+
+    doc->openTransaction("Assign points");
+    feature->Points.setValue(feature->Points.getValue());
+    EXPECT_EQ(feature->Points.getValue().size(), 2);
+    doc->commitTransaction();
+
+    doc->undo();
+    EXPECT_EQ(feature->Points.getValue().size(), 2);
+    doc->redo();
+    EXPECT_EQ(feature->Points.getValue().size(), 2);
+
+    App::GetApplication().closeDocument(docName.c_str());
+}
+
+TEST_F(PointsFeatureTest, replaceKeepsPointsDuringBeforeChange)
+{
+    std::string docName = App::GetApplication().getUniqueDocumentName("test");
+    App::Document* doc = App::GetApplication().newDocument(docName.c_str(), "testUser");
+    doc->setUndoMode(1);
+    auto feature = doc->addObject<Points::Feature>();
+    Points::PointKernel points;
+    points.push_back(Base::Vector3d(1.0, 2.0, 3.0));
+    points.push_back(Base::Vector3d(4.0, 5.0, 6.0));
+    feature->Points.setValue(points);
+    std::vector<std::size_t> seen;
+    auto conn = doc->signalBeforeChangeObject.connect(
+        [&](const App::DocumentObject&, const App::Property& prop) {
+            if (&prop == &feature->Points) {
+                seen.push_back(feature->Points.getValue().size());
+            }
+        });
+
+    doc->openTransaction("Replace points");
+    feature->Points.setValue(Points::PointKernel());
+    doc->commitTransaction();
+    conn.disconnect();
+
+    ASSERT_EQ(seen.size(), 1);
+    EXPECT_EQ(seen[0], 2);
+    EXPECT_EQ(feature->Points.getValue().size(), 0);
+    doc->undo();
+    EXPECT_EQ(feature->Points.getValue().size(), 2);
+
+    App::GetApplication().closeDocument(docName.c_str());
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -3,8 +3,14 @@
 #include <gtest/gtest.h>
 #include "src/App/InitApplication.h"
 
+#include <filesystem>
+#include <fstream>
 #include <memory>
 
+#include <App/Application.h>
+#include <App/Document.h>
+#include <App/ExpressionParser.h>
+#include <App/PropertyStandard.h>
 #include <Mod/Spreadsheet/App/Sheet.h>
 #include <Mod/Spreadsheet/App/PropertySheet.h>
 
@@ -87,3 +93,141 @@ TEST_F(PropertySheetTest, invalidAliases)  // NOLINT
             << "\"" << name << "\" was accepted as an alias name, and should not be";
     }
 }
+
+class PropertySheetDependencyTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+    void SetUp() override
+    {
+        _docName = App::GetApplication().getUniqueDocumentName("test");
+        auto doc = App::GetApplication().newDocument(_docName.c_str(), "testUser");
+        _sheet = freecad_cast<Spreadsheet::Sheet*>(doc->addObject("Spreadsheet::Sheet"));
+    }
+    void TearDown() override
+    {
+        App::GetApplication().closeDocument(_docName.c_str());
+    }
+
+    Spreadsheet::Sheet* sheet()
+    {
+        return _sheet;
+    }
+
+private:
+    std::string _docName;
+    Spreadsheet::Sheet* _sheet {};
+};
+
+TEST_F(PropertySheetDependencyTest, evaluationOrderFollowsDependencies)  // NOLINT
+{
+    // Arrange
+    sheet()->setCell("A1", "1");
+    sheet()->setCell("A2", "=A1 + 1");
+    sheet()->setCell("A3", "=A2 * 2");
+    sheet()->setCell("B1", "=A1 + A3");
+    sheet()->setCell("C1", "=7");
+    std::vector<App::CellAddress> order;
+
+    // Act
+    bool result = sheet()->getCells()->getEvaluationOrder({App::CellAddress("A1")}, order);
+
+    // Assert
+    EXPECT_TRUE(result);
+    EXPECT_EQ(sheet()->getCells()->getDependants(App::CellAddress("A1")),
+              std::set<App::CellAddress>({App::CellAddress("A2"), App::CellAddress("B1")}));
+    EXPECT_EQ(order,
+              std::vector<App::CellAddress>({App::CellAddress("A1"),
+                                             App::CellAddress("A2"),
+                                             App::CellAddress("A3"),
+                                             App::CellAddress("B1")}));
+}
+
+TEST_F(PropertySheetDependencyTest, dependenciesFollowCellChanges)  // NOLINT
+{
+    // Arrange
+    sheet()->setCell("A1", "1");
+    sheet()->setCell("A2", "=A1 + 1");
+    sheet()->setCell("B1", "=A2");
+
+    // Act
+    sheet()->setCell("A2", "5");
+    std::vector<App::CellAddress> order;
+    sheet()->getCells()->getEvaluationOrder({App::CellAddress("A1")}, order);
+
+    // Assert
+    EXPECT_TRUE(sheet()->getCells()->getDependants(App::CellAddress("A1")).empty());
+    EXPECT_EQ(order, std::vector<App::CellAddress>({App::CellAddress("A1")}));
+}
+
+TEST_F(PropertySheetDependencyTest, evaluationOrderDetectsCycles)  // NOLINT
+{
+    // Arrange
+    sheet()->setCell("A1", "=A2 + 1");
+    sheet()->setCell("A2", "=A1 + 1");
+    sheet()->setCell("A3", "=A2");
+    sheet()->setCell("B1", "1");
+    std::vector<App::CellAddress> order;
+
+    // Act & Assert
+    EXPECT_FALSE(sheet()->getCells()->getEvaluationOrder({App::CellAddress("A1")}, order));
+    EXPECT_FALSE(sheet()->getCells()->getEvaluationOrder({App::CellAddress("A3")}, order));
+    EXPECT_TRUE(sheet()->getCells()->getEvaluationOrder({App::CellAddress("B1")}, order));
+}
+
+TEST_F(PropertySheetDependencyTest, importFromFileStoresConstantsDirectly)  // NOLINT
+{
+    // Arrange
+    auto path = std::filesystem::temp_directory_path() / "PropertySheetImport.csv";
+    {
+        std::ofstream csv(path);
+        csv << "1;text;2 mm\n";
+        csv << "2.5;;=A1 + A2\n";
+    }
+
+    // Act
+    bool result = sheet()->importFromFile(path.string(), ';', '"', '\\');
+    std::filesystem::remove(path);
+
+    // Assert
+    ASSERT_TRUE(result);
+    auto expression = [this](const char* address) {
+        auto cell = sheet()->getCell(App::CellAddress(address));
+        return cell ? cell->getExpression() : nullptr;
+    };
+    EXPECT_TRUE(freecad_cast<App::NumberExpression*>(expression("A1")));
+    EXPECT_TRUE(freecad_cast<App::NumberExpression*>(expression("A2")));
+    EXPECT_TRUE(freecad_cast<App::StringExpression*>(expression("B1")));
+    EXPECT_EQ(expression("B2"), nullptr);
+    EXPECT_TRUE(freecad_cast<App::OperatorExpression*>(expression("C1")));
+    EXPECT_TRUE(freecad_cast<App::OperatorExpression*>(expression("C2")));
+    EXPECT_EQ(sheet()->getCells()->getDependants(App::CellAddress("A1")),
+              std::set<App::CellAddress>({App::CellAddress("C2")}));
+}
+
+TEST_F(PropertySheetDependencyTest, recomputeEvaluatesLargeLevels)  // NOLINT
+{
+    // Arrange
+    constexpr int count = 200;
+    sheet()->setCell("A1", "3");
+    for (int row = 0; row < count; ++row) {
+        sheet()->setCell(App::CellAddress(row, 1), ("=A1 * " + std::to_string(row)).c_str());
+        sheet()->setCell(App::CellAddress(row, 2), ("=B" + std::to_string(row + 1) + " + 1").c_str());
+    }
+    sheet()->setCell("D1", "=A1 + 1 mm");
+
+    // Act
+    sheet()->getDocument()->recompute();
+
+    // Assert
+    for (int row = 0; row < count; ++row) {
+        auto prop = freecad_cast<App::PropertyInteger*>(
+            sheet()->getPropertyByName(App::CellAddress(row, 2).toString().c_str()));
+        ASSERT_TRUE(prop);
+        EXPECT_EQ(prop->getValue(), 3 * row + 1);
+    }
+    EXPECT_TRUE(sheet()->getCell(App::CellAddress("D1"))->hasException());
+}